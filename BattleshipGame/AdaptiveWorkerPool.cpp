@@ -0,0 +1,162 @@
+#include "AdaptiveWorkerPool.h"
+#include "Logger.h"
+#include <windows.h>
+#include <thread>
+#include <sstream>
+#include <iomanip>
+
+using std::lock_guard;
+using std::unique_lock;
+using std::stringstream;
+using std::to_string;
+
+namespace battleship
+{
+	AdaptiveWorkerPool::AdaptiveWorkerPool(size_t maxWorkers, size_t initialWorkers, bool isAdaptive) :
+		_maxWorkers(maxWorkers),
+		_activeWorkers(isAdaptive ? initialWorkers : maxWorkers),
+		_isAdaptive(isAdaptive),
+		_isShutdown(false),
+		_direction(-1), // Workers start at the number of logical processors, so first try to use fewer
+		_lastThroughput(-1),
+		_windowStart(std::chrono::steady_clock::now()),
+		_windowStartGames(0),
+		_windowStartCpuSeconds(processCpuSeconds())
+	{
+		if (_activeWorkers > _maxWorkers)
+			_activeWorkers = _maxWorkers;
+
+		if (_activeWorkers < 1)
+			_activeWorkers = 1;
+	}
+
+	size_t AdaptiveWorkerPool::defaultWorkersCount()
+	{
+		unsigned int processors = std::thread::hardware_concurrency();
+		return (processors > 0) ? processors : 1; // hardware_concurrency() may be unknown (0)
+	}
+
+	double AdaptiveWorkerPool::processCpuSeconds()
+	{
+		FILETIME creationTime, exitTime, kernelTime, userTime;
+		if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+			return 0;
+
+		auto toTicks = [](const FILETIME& ft)
+		{
+			return (static_cast<ULONGLONG>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+		};
+
+		// FILETIME counts 100 nanoseconds intervals
+		return static_cast<double>(toTicks(kernelTime) + toTicks(userTime)) / 1e7;
+	}
+
+	void AdaptiveWorkerPool::waitUntilActive(size_t workerIndex)
+	{
+		if (!_isAdaptive)
+			return;
+
+		unique_lock<mutex> lock(_poolLock);
+		_poolCV.wait(lock, [this, workerIndex] { return _isShutdown || (workerIndex < _activeWorkers); });
+	}
+
+	void AdaptiveWorkerPool::resize(size_t activeWorkers)
+	{
+		{
+			lock_guard<mutex> lock(_poolLock);
+			_activeWorkers = activeWorkers;
+		}
+
+		_poolCV.notify_all();
+	}
+
+	void AdaptiveWorkerPool::shutdown()
+	{
+		{
+			lock_guard<mutex> lock(_poolLock);
+			_isShutdown = true;
+		}
+
+		_poolCV.notify_all();
+	}
+
+	size_t AdaptiveWorkerPool::activeWorkers()
+	{
+		lock_guard<mutex> lock(_poolLock);
+		return _activeWorkers;
+	}
+
+	void AdaptiveWorkerPool::sample(size_t completedGames)
+	{
+		if (!_isAdaptive)
+			return;
+
+		auto now = std::chrono::steady_clock::now();
+		double elapsedSeconds = std::chrono::duration<double>(now - _windowStart).count();
+		size_t windowGames = completedGames - _windowStartGames;
+
+		// Too short windows are too noisy to base decisions on
+		if ((elapsedSeconds * 1000 < WINDOW_MILLIS) || (windowGames < MIN_GAMES_PER_WINDOW))
+			return;
+
+		double cpuSeconds = processCpuSeconds();
+		double throughput = windowGames / elapsedSeconds;
+		double cpuUtilization = (cpuSeconds - _windowStartCpuSeconds) /
+								(elapsedSeconds * static_cast<double>(defaultWorkersCount()));
+
+		size_t current = activeWorkers();
+		string decision;
+
+		if (_lastThroughput < 0)
+		{	// First window is the baseline, start exploring
+			decision = "baseline";
+		}
+		else if (throughput > _lastThroughput * (1 + THROUGHPUT_TOLERANCE))
+		{	// Last step helped, keep going the same way (or keep holding the size)
+			decision = "throughput improved";
+		}
+		else if (throughput < _lastThroughput * (1 - THROUGHPUT_TOLERANCE))
+		{	// Last step hurt, go back. If we were holding, the load changed so try fewer workers.
+			_direction = (_direction != 0) ? -_direction : -1;
+			decision = "throughput dropped";
+		}
+		else if (cpuUtilization > CPU_SATURATION)
+		{	// No gain from the extra workers while the CPU is saturated
+			_direction = -1;
+			decision = "CPU saturated";
+		}
+		else
+		{	// Throughput is stable, keep the current size
+			_direction = 0;
+			decision = "throughput stable";
+		}
+
+		// Turn around at the edges of the pool
+		if ((_direction < 0) && (current <= 1))
+			_direction = 1;
+		else if ((_direction > 0) && (current >= _maxWorkers))
+			_direction = -1;
+
+		size_t next = current;
+		if (_direction > 0)
+			next = current + 1;
+		else if ((_direction < 0) && (current > 1))
+			next = current - 1;
+
+		stringstream ss;
+		ss << "Adaptive worker pool: " << std::fixed << std::setprecision(2) << throughput << " games/sec, CPU "
+		   << std::setprecision(0) << (cpuUtilization * 100) << "% with " << current << " workers (" << decision
+		   << ") -> " << ((next > current) ? "growing to " : ((next < current) ? "shrinking to " : "keeping "))
+		   << next << " workers";
+		Logger::getInstance().log(Severity::INFO_LEVEL, ss.str());
+
+		if (next != current)
+			resize(next);
+
+		// Start next window
+		_lastThroughput = throughput;
+		_windowStart = now;
+		_windowStartGames = completedGames;
+		_windowStartCpuSeconds = cpuSeconds;
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+using std::mutex;
+using std::condition_variable;
+
+namespace battleship
+{
+	/** Controls how many of the competition's worker threads are allowed to run games at a time.
+	 *  All worker threads are created up-front, and workers outside the active set are parked until needed.
+	 *  In adaptive mode the active set is resized by hill climbing on the measured throughput (games per second),
+	 *  which finds the sweet spot for player dlls that spawn threads of their own.
+	 *  Workers always pull tasks from the same ordered queue, so the round ordering of the Scoreboard is kept.
+	 */
+	class AdaptiveWorkerPool
+	{
+	public:
+		/** Creates a pool of maxWorkers workers, of which initialWorkers are active at first.
+		 *  If isAdaptive is false all maxWorkers workers stay active for the whole competition.
+		 */
+		AdaptiveWorkerPool(size_t maxWorkers, size_t initialWorkers, bool isAdaptive);
+		virtual ~AdaptiveWorkerPool() = default;
+
+		/** Called by a worker thread (workerIndex starts from 0) before it fetches its next task.
+		 *  Blocks while the worker is outside the active set, and returns once it may run games again.
+		 *  This method is thread safe.
+		 */
+		void waitUntilActive(size_t workerIndex);
+
+		/** Called periodically by the main thread with the number of games completed so far.
+		 *  Once a measurement window is over, the throughput and CPU utilization of the window are
+		 *  measured and the active set is resized accordingly. Each decision is logged.
+		 */
+		void sample(size_t completedGames);
+
+		/** Releases all parked workers, called when there are no more games to hand out */
+		void shutdown();
+
+		/** Returns the number of workers currently allowed to run games */
+		size_t activeWorkers();
+
+		/** Returns the default number of workers for adaptive mode (the number of logical processors) */
+		static size_t defaultWorkersCount();
+
+	private:
+		/** Minimal duration of a measurement window */
+		static constexpr int WINDOW_MILLIS = 2000;
+
+		/** Minimal number of games in a measurement window, shorter windows are extended */
+		static constexpr size_t MIN_GAMES_PER_WINDOW = 4;
+
+		/** Relative change of throughput between windows that is considered noise */
+		static constexpr double THROUGHPUT_TOLERANCE = 0.05;
+
+		/** CPU utilization above which extra workers are considered as oversubscription */
+		static constexpr double CPU_SATURATION = 0.95;
+
+		size_t _maxWorkers;
+		size_t _activeWorkers;
+		bool _isAdaptive;
+		bool _isShutdown;
+
+		// Protects the active set, parked workers wait on the condition variable
+		mutex _poolLock;
+		condition_variable _poolCV;
+
+		// Hill climbing state: current direction (+1 grow, -1 shrink) and last window's throughput
+		int _direction;
+		double _lastThroughput;
+
+		// Measurements at the start of the current window
+		std::chrono::steady_clock::time_point _windowStart;
+		size_t _windowStartGames;
+		double _windowStartCpuSeconds;
+
+		/** Changes the number of active workers and wakes up workers that became active */
+		void resize(size_t activeWorkers);
+
+		/** Returns the total CPU time (user + kernel) consumed by this process so far, in seconds */
+		static double processCpuSeconds();
+	};
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <utility>
 #include <string>
 #include "IBattleshipGameAlgo.h"
@@ -59,7 +60,14 @@ inline string to_string(Coordinate c) {
 
 struct CoordinateHash {
 	std::size_t operator()(const Coordinate& c) const {
-		return c.row * 7 + c.col * 5 + c.depth * 11;
+		// Packs the coordinate to 21 bits per axis and mixes it (splitmix64 finalizer), so the squares of large
+		// boards spread evenly over the buckets rather than colliding on a few thousand sums
+		uint64_t key = ((static_cast<uint64_t>(c.row) & 0x1FFFFF) << 42) |
+					   ((static_cast<uint64_t>(c.col) & 0x1FFFFF) << 21) |
+					   (static_cast<uint64_t>(c.depth) & 0x1FFFFF);
+		key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+		return static_cast<std::size_t>(key ^ (key >> 31));
 	}
 };
 
@@ -4,6 +4,7 @@
 #include "IBattleshipGameAlgo.h"
 #include "IOUtil.h"
 #include "Logger.h"
+#include "ResourceManifest.h"
 
 using std::function;
 
@@ -11,14 +12,17 @@ namespace battleship
 {
 	void AlgoLoader::fetchDLLs(const string& path)
 	{
-		Logger::getInstance().log(Severity::DEBUG_LEVEL, "AlgoLoader Fetching list of available DLLs..");
+		LOG_DEBUG("AlgoLoader Fetching list of available DLLs..");
 
-		_availableGameAlgos = IOUtil::listFilesInPath(path, "dll");
+		// The path is only enumerated if it has no up to date manifest
+		ResourceManifest manifest(path);
+		if (!manifest.listFiles("dll", _availableGameAlgos))
+			_availableGameAlgos = IOUtil::listFilesInPath(path, "dll");
 
 		// Scan for dlls in the path
 		for (auto& nextDllFilename : _availableGameAlgos)
 		{
-			Logger::getInstance().log(Severity::DEBUG_LEVEL, nextDllFilename + " found");
+			LOG_DEBUG(nextDllFilename + " found");
 		}
 	}
 
@@ -43,7 +47,7 @@ namespace battleship
 		HINSTANCE hDll = LoadLibraryA(algoFullpath.c_str());
 		if (!hDll)
 		{
-			Logger::getInstance().log(Severity::WARNING_LEVEL, "Cannot load dll: " + algoFullpath);
+			LOG_LIMITED(Severity::WARNING_LEVEL, "Cannot load dll: " + algoFullpath);
 			return;
 		}
 
@@ -52,18 +56,24 @@ namespace battleship
 			reinterpret_cast<GetAlgorithmFuncType>(GetProcAddress(hDll, "GetAlgorithm"));
 		if (!getAlgorithmFunc)
 		{
-			Logger::getInstance().log(Severity::WARNING_LEVEL, "Cannot load dll: " + algoFullpath);
+			LOG_LIMITED(Severity::WARNING_LEVEL, "Cannot load dll: " + algoFullpath);
 			FreeLibrary(hDll); // Make sure to release loaded library, as AlgoLoader doesn't manage it yet
 			return;
 		}
 
+		// Optional export, algorithms that don't declare it are not symmetry invariant
+		IsSymmetryInvariantFuncType isSymmetryInvariantFunc =
+			reinterpret_cast<IsSymmetryInvariantFuncType>(GetProcAddress(hDll, "IsSymmetryInvariant"));
+		bool isSymmetryInvariant = (isSymmetryInvariantFunc != nullptr) && isSymmetryInvariantFunc();
+
 		// Keep algorithm in list of loaded algos
 		string algoFormattedName = algoName;
 		stripNameSuffix(algoFormattedName);
-		_loadedGameAlgos.emplace_back(algoFormattedName, hDll, getAlgorithmFunc); // Build algoDescriptor
+		_loadedGameAlgos.emplace_back(algoFormattedName, hDll, getAlgorithmFunc, isSymmetryInvariant); // Build algoDescriptor
 		_loadedGameAlgoNames.push_back(algoFormattedName);
 
-		Logger::getInstance().log(Severity::INFO_LEVEL, algoName + " loaded successfully");
+		Logger::getInstance().log(Severity::INFO_LEVEL, algoName + " loaded successfully" +
+								  (isSymmetryInvariant ? " (symmetry invariant)" : ""));
 	}
 
 	AlgoLoader::AlgoLoader(const string& path): _algosPath(path)
@@ -81,7 +91,7 @@ namespace battleship
 		{
 			// Free HINSTANCE loaded, which resides in the 2nd cell of the algo tuple
 			auto descriptor = *(algIter);
-			Logger::getInstance().log(Severity::DEBUG_LEVEL, "Freeing algorithm: " + descriptor.path);
+			LOG_DEBUG("Freeing algorithm: " + descriptor.path);
 			FreeLibrary(descriptor.dll);
 		}
 	}
@@ -106,9 +116,9 @@ namespace battleship
 		if (it == _loadedGameAlgos.end())
 		{
 			// Not loaded before, meaning a wrong algoPath given
-			Logger::getInstance().log(Severity::ERROR_LEVEL,
-									  "Error: Trying to load algorithm from " + algoName +
-									  " but this DLL isn't managed by the AlgoLoader");
+			LOG_LIMITED(Severity::ERROR_LEVEL,
+						"Error: Trying to load algorithm from " + algoName +
+						" but this DLL isn't managed by the AlgoLoader");
 			return nullptr;
 		}
 		
@@ -123,17 +133,25 @@ namespace battleship
 		IBattleshipGameAlgo* algo = getAlgorithmFunc();
 		if (nullptr == algo)
 		{
-			Logger::getInstance().log(Severity::ERROR_LEVEL,
-									  "Error: Cannot create instance out of dll of player: " + algoDescriptor.path);
+			LOG_LIMITED(Severity::ERROR_LEVEL,
+						"Error: Cannot create instance out of dll of player: " + algoDescriptor.path);
 			return nullptr;
 		}
 
-		Logger::getInstance().log(Severity::DEBUG_LEVEL, algoName + " new instance created");
+		LOG_DEBUG(algoName + " new instance created");
 
 		// Wrap in a smart pointer, so consumers don't have to deal with memory deallocation manually
 		return unique_ptr<IBattleshipGameAlgo>(algo);
 	}
 
+	bool AlgoLoader::isSymmetryInvariant(const string& algoName) const
+	{
+		auto it = std::find_if(_loadedGameAlgos.begin(), _loadedGameAlgos.end(),
+			[&algoName](AlgoDescriptor const& ad) { return ad.path == algoName; });
+
+		return (it != _loadedGameAlgos.end()) && it->isSymmetryInvariant;
+	}
+
 	const vector<string>& AlgoLoader::availableGameAlgos() const
 	{
 		return _availableGameAlgos;
@@ -143,4 +161,9 @@ namespace battleship
 	{
 		return _loadedGameAlgoNames;
 	}
+
+	const string& AlgoLoader::algosPath() const
+	{
+		return _algosPath;
+	}
 }
\ No newline at end of file
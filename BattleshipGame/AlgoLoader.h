@@ -38,6 +38,9 @@ namespace battleship
 		/** Get list of algorithm whose dll was successfully loaded */
 		const vector<string>& loadedGameAlgos() const;
 
+		/** Get the path algorithms are loaded from */
+		const string& algosPath() const;
+
 		/** Creates a new instance of the algorithm in the given path.
 		 *  This method assumes algoPath was loaded successfully by this object.
 		 *  (algoPath should appear in "loadedAlgos()")
@@ -45,6 +48,11 @@ namespace battleship
 		 */
 		unique_ptr<IBattleshipGameAlgo> requestAlgo(const string& algoName) const;
 
+		/** Returns true if the algorithm's dll declares it's symmetry invariant (exports IsSymmetryInvariant,
+		 *  which returns true). Returns false for algorithms that weren't loaded.
+		 */
+		bool isSymmetryInvariant(const string& algoName) const;
+
 		/** Loads & validates all available game algorithms. 
 		 *	Returns a list of available algorithm names.
 		 */
@@ -58,6 +66,9 @@ namespace battleship
 		/** Typedef for object creating new IBattleshipGameAlgo objects from Dlls */
 		using GetAlgorithmFuncType = IBattleshipGameAlgo *(*)();
 
+		/** Typedef for the optional export declaring whether the algorithm is symmetry invariant */
+		using IsSymmetryInvariantFuncType = bool(*)();
+
 		/** Descriptor for IBattleshipGameAlgo available for loading.
 		 *	This is essentially all the information available on an algorithm we can load.
 		 */
@@ -66,12 +77,15 @@ namespace battleship
 			string path;
 			HINSTANCE dll;
 			GetAlgorithmFuncType algoFunc;
+			bool isSymmetryInvariant;
 
-			AlgoDescriptor(const string& aPath, HINSTANCE aDll, GetAlgorithmFuncType aAlgoFunc)
+			AlgoDescriptor(const string& aPath, HINSTANCE aDll, GetAlgorithmFuncType aAlgoFunc,
+						   bool aIsSymmetryInvariant)
 			{
 				path = aPath;
 				dll = aDll;
 				algoFunc = aAlgoFunc;
+				isSymmetryInvariant = aIsSymmetryInvariant;
 			}
 		};
 
@@ -2,6 +2,7 @@
 #include "BattleBoard.h"
 
 using std::map;
+using std::unordered_map;
 
 namespace battleship
 {
@@ -84,14 +85,7 @@ namespace battleship
 	{
 		// Perform deep copy for game pieces as they contain data that may change along the game and shouldn't
 		// be shared among common boards
-		map<Coordinate, shared_ptr<GamePiece>> copiedGamePieces;	// We should copy only once for each ship
-		for (auto it = other._gamePieces.begin(); it != other._gamePieces.end(); ++it)
-		{
-			if (copiedGamePieces.find(it->second->_firstPos) == copiedGamePieces.end())
-				copiedGamePieces.emplace(it->second->_firstPos, std::make_shared<GamePiece>(*it->second));
-
-			_gamePieces.emplace(it->first, copiedGamePieces[it->second->_firstPos]);
-		}
+		copyGamePieces(other._gamePieces);
 	}
 	
 	// Copy asignment operator
@@ -106,19 +100,31 @@ namespace battleship
 			_boardHeight = other._boardHeight;
 			_boardDepth = other._boardDepth;
 
-			_gamePieces.clear(); 
-
 			// Perform deep copy for game pieces as they contain data that may change along the game and shouldn't
 			// be shared among common boards
-			for (auto it = other._gamePieces.begin(); it != other._gamePieces.end(); ++it)
-			{
-				_gamePieces.emplace(it->first, std::make_shared<GamePiece>(*it->second));
-			}
+			copyGamePieces(other._gamePieces);
 		}
 
 		return *this;
 	}
 
+	void BattleBoard::copyGamePieces(const GamePiecesDict& otherGamePieces)
+	{
+		_gamePieces.clear();
+		_gamePieces.reserve(otherGamePieces.size());
+
+		// Every square of a piece refers to the same piece, so each piece is copied once (linear in the squares)
+		unordered_map<const GamePiece*, shared_ptr<GamePiece>> copiedGamePieces;
+		for (const auto& square : otherGamePieces)
+		{
+			auto& copiedPiece = copiedGamePieces[square.second.get()];
+			if (copiedPiece == nullptr)
+				copiedPiece = std::make_shared<GamePiece>(*square.second);
+
+			_gamePieces.emplace(square.first, copiedPiece);
+		}
+	}
+
 	// Logic methods
 
 	void BattleBoard::addGamePiece(Coordinate firstPos, const ShipType& shipType,
@@ -156,6 +162,21 @@ namespace battleship
 		}
 	}
 
+	vector<shared_ptr<const GamePiece>> BattleBoard::gamePiecesList() const
+	{
+		// Every square of a piece refers to the same game piece, keep it once
+		map<Coordinate, shared_ptr<const GamePiece>> pieces;
+		for (const auto& square : _gamePieces)
+			pieces.emplace(square.second->_firstPos, square.second);
+
+		vector<shared_ptr<const GamePiece>> piecesList;
+		piecesList.reserve(pieces.size());
+		for (const auto& piece : pieces)
+			piecesList.push_back(piece.second);
+
+		return piecesList;
+	}
+
 	void BattleBoard::sinkShip(const GamePiece* pieceToRemove)
 	{
 		int deltaCol = (pieceToRemove->_orient == Orientation::X_AXIS) ? 1 : 0;
@@ -237,8 +258,7 @@ namespace battleship
 		}
 		else
 		{
-			shared_ptr<GamePiece> gamePiece = dictIter->second;
-			return gamePiece->_player;
+			return dictIter->second->_player;
 		}
 	}
 
@@ -257,6 +277,12 @@ namespace battleship
 		}
 	}
 
+	const GamePiece* BattleBoard::findPiece(const Coordinate& c) const
+	{
+		auto gamePieceIt = _gamePieces.find(c);
+		return (gamePieceIt == _gamePieces.end()) ? nullptr : gamePieceIt->second.get();
+	}
+
 	/** Returns the board width */
 	int BattleBoard::width() const
 	{
@@ -275,5 +301,17 @@ namespace battleship
 		return _boardDepth;
 	}
 
+	const ShipType* BattleBoard::shipTypeOf(BoardSquare representation)
+	{
+		switch (representation)
+		{
+		case BoardSquare::RubberBoat: { return &RUBBER_BOAT; }
+		case BoardSquare::RocketShip: { return &ROCKET_SHIP; }
+		case BoardSquare::Submarine: { return &SUBMARINE; }
+		case BoardSquare::Battleship: { return &BATTLESHIP; }
+		default: { return nullptr; }
+		}
+	}
+
 	#pragma endregion
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <set>
+#include <vector>
 #include <unordered_map>
 #include <utility>
 #include <functional>
@@ -13,6 +14,7 @@ using std::unique_ptr;
 using std::string;
 using std::pair;
 using std::set;
+using std::vector;
 using std::unordered_map;
 using std::function;
 
@@ -117,6 +119,16 @@ namespace battleship
 		 */
 		shared_ptr<const GamePiece> pieceAt(const Coordinate& c) const;
 
+		/** Same as pieceAt, without taking a reference to the piece. For lookups of many squares (e.g. a player's
+		 *  view of the board), the piece is valid only until the board changes.
+		 */
+		const GamePiece* findPiece(const Coordinate& c) const;
+
+		/** Returns each game piece on the board once, ordered by first position.
+		 *  Sunk pieces are no longer on the board, so this lists all pieces only before the game starts.
+		 */
+		vector<shared_ptr<const GamePiece>> gamePiecesList() const;
+
 		/** Returns the board width */
 		int width() const;
 
@@ -126,6 +138,9 @@ namespace battleship
 		/** Returns the board depth */
 		int depth() const;
 
+		/** Returns the ship type represented by the given (upper case) square, or NULL if it isn't a ship */
+		static const ShipType* shipTypeOf(BoardSquare representation);
+
 		/** Allows BoardBuilder access to the private constructor, so BoardBuilder is able to produce new
 		 *  BattleBoard instances (according to Builder pattern).
 		 */
@@ -167,6 +182,11 @@ namespace battleship
 		void addGamePiece(Coordinate firstPos, const ShipType& shipType,
 						  PlayerEnum player, Orientation orientation);
 
+		/* Replaces the game pieces with deep copies of the other board's pieces, each piece copied once
+		 * and shared by all of its squares (as in the other board).
+		 */
+		void copyGamePieces(const GamePiecesDict& otherGamePieces);
+
 		/** Applies a move of "sinking" a game-piece, assuming it has been hit enough times.
 		 *  The game piece will be removed from the board altogether, and the players ship count will be updated
 		 *  accordingly.
@@ -1,181 +1,251 @@
 #include <iostream>
-#include <algorithm>
+#include <thread>
+#include <atomic>
 #include "BattleshipGameBoardFactory.h"
 #include "IOUtil.h"
 #include "Logger.h"
 #include "BoardBuilder.h"
+#include "BoardFileParser.h"
+#include "BoardArchive.h"
+#include "BoardValidationCache.h"
+#include "BoardSymmetry.h"
+#include "ResourceManifest.h"
 
 using std::cout;
 using std::endl;
-using std::transform;
+using std::thread;
+using std::atomic;
+using std::to_string;
 
 namespace battleship
 {
 	const string BattleshipGameBoardFactory::BOARD_SUFFIX = "sboard";
 
-	BattleshipGameBoardFactory::BattleshipGameBoardFactory(const string& path): _path(path)
+	BattleshipGameBoardFactory::BattleshipGameBoardFactory(const string& path): _path(path), _isSymmetryGrouped(false)
 	{
-		Logger::getInstance().log(Severity::DEBUG_LEVEL, "BattleshipGameBoardFactory started..");
-		_availableBoards = IOUtil::listFilesInPath(path, BOARD_SUFFIX);
+		LOG_DEBUG("BattleshipGameBoardFactory started..");
+
+		// The path is only enumerated if it has no up to date manifest
+		_manifest = std::make_unique<ResourceManifest>(path);
+		if (!_manifest->listFiles(BOARD_SUFFIX, _availableBoards) ||
+			!_manifest->listFiles(BoardArchive::ARCHIVE_SUFFIX, _availableArchives))
+		{
+			_manifest = nullptr;
+			_availableBoards = IOUtil::listFilesInPath(path, BOARD_SUFFIX);
+			_availableArchives = IOUtil::listFilesInPath(path, BoardArchive::ARCHIVE_SUFFIX);
+		}
+		else
+		{
+			LOG_DEBUG("Battle boards listed from the resource manifest of " + path);
+		}
 	}
 
-	bool BattleshipGameBoardFactory::parseHeader(string& nextLine, int& rows, int& cols, int& depth) const
+	// Out of line, so ResourceManifest can be an incomplete type in the header
+	BattleshipGameBoardFactory::~BattleshipGameBoardFactory() = default;
+
+	bool BattleshipGameBoardFactory::restoreCachedBoard(uint64_t contentHash, const BoardValidationCache& cache,
+														BoardLoadResult& result)
 	{
-		bool isValidFile = true;
+		// The board file was loaded before with the same content, so it's valid (or invalid) as it was then
+		const CachedValidation* cached = cache.find(contentHash);
+		if (nullptr == cached)
+			return false;
 
-		transform(nextLine.begin(), nextLine.end(), nextLine.begin(), ::tolower);
-		string delimiter = "x"; // Separates dimensions
+		result.contentHash = contentHash;
+		result.isHashed = true;
+		result.isCached = true;
+		result.board = cached->isValid ? BoardArchive::toBoard(cached->board) : nullptr;
+		result.warnings = cached->isValid ? cached->board.warnings : cached->errors;
+		return true;
+	}
 
-		int dimensionIndex = 0;
-		size_t pos;
-		while ((pos = nextLine.find(delimiter)) != std::string::npos)
+	void BattleshipGameBoardFactory::loadBoardFile(const string& boardFilename, const BoardValidationCache& cache,
+												   BoardLoadResult& result) const
+	{
+		// The manifest was verified against the file's size and write time when the boards were listed
+		const ManifestEntry* listedBoard = (_manifest != nullptr) ? _manifest->find(boardFilename) : nullptr;
+		if ((nullptr != listedBoard) && restoreCachedBoard(listedBoard->contentHash, cache, result))
+			return;
+
+		string boardFile = _path + "\\" + boardFilename;
+		BoardFileParser parser(boardFile);
+		if (!parser.isOpen())
 		{
-			string token = nextLine.substr(0, pos);
-			nextLine.erase(0, pos + delimiter.length());
+			LOG_LIMITED(Severity::ERROR_LEVEL, "Failed to open file " + boardFile);
+			return;
+		}
 
-			// Parse each dimension
-			if (IOUtil::isInteger(token))
-			{
-				int dimensionVal = stoi(token);
+		result.contentHash = parser.contentHash();
+		result.isHashed = true;
 
-				switch (dimensionIndex)
-				{
-				case (0) : { cols = dimensionVal; break; }
-				case (1) : { rows = dimensionVal; break; }
-				case (2) : { depth = dimensionVal; break; }
-				default: { break; }
-				}
+		if (restoreCachedBoard(result.contentHash, cache, result))
+			return;
 
-				dimensionIndex++;
-			}
-			else
-			{
-				isValidFile = false;
-				break;
-			}
+		auto builder = parser.parse();
+		if (builder == nullptr)
+			return;
+
+		// Finalize the board, perform validation here
+		result.board = builder->build(result.warnings);
+	}
+
+	void BattleshipGameBoardFactory::hashBoardFile(const string& boardFilename, BoardLoadResult& result) const
+	{
+		const ManifestEntry* listedBoard = (_manifest != nullptr) ? _manifest->find(boardFilename) : nullptr;
+		if (nullptr != listedBoard)
+		{
+			result.contentHash = listedBoard->contentHash;
+			result.isHashed = true;
+			return;
+		}
+
+		BoardFileParser parser(_path + "\\" + boardFilename);
+		if (parser.isOpen())
+		{
+			result.contentHash = parser.contentHash();
+			result.isHashed = true;
 		}
-		
-		// Parse the rest of the line (last dimension)
-		if (IOUtil::isInteger(nextLine))
+	}
+
+	void BattleshipGameBoardFactory::cacheBoardFile(const string& boardFilename, const BoardLoadResult& result,
+													BoardValidationCache& cache)
+	{
+		CachedValidation validation;
+		validation.isValid = (nullptr != result.board);
+
+		if (validation.isValid)
 		{
-			depth = stoi(nextLine);
-			dimensionIndex++;
+			string error;
+			if (!BoardArchive::fromBoard(boardFilename, *result.board, result.warnings, result.contentHash,
+										 validation.board, error))
+			{
+				LOG_DEBUG("Battle board " + boardFilename + " can't be cached: " + error);
+				return;
+			}
 		}
 		else
 		{
-			isValidFile = false;
+			validation.errors = result.warnings;
 		}
 
-		isValidFile = isValidFile && (dimensionIndex == 3);
-
-		return isValidFile;
+		cache.store(result.contentHash, std::move(validation));
 	}
 
-	void BattleshipGameBoardFactory::parseBoardRow(BoardBuilder& builder, string& nextLine,
-												   int depthIndex, int rowIndex, int cols)
+	void BattleshipGameBoardFactory::loadBoardArchive(const string& archiveFilename)
 	{
-		int colCounter = 0;
-
-		auto legalChars =
-		{
-			static_cast<char>(toupper(static_cast<char>(BoardSquare::Empty))),
-			static_cast<char>(toupper(static_cast<char>(BoardSquare::RubberBoat))),
-			static_cast<char>(toupper(static_cast<char>(BoardSquare::RocketShip))),
-			static_cast<char>(toupper(static_cast<char>(BoardSquare::Submarine))),
-			static_cast<char>(toupper(static_cast<char>(BoardSquare::Battleship))),
-			static_cast<char>(tolower(static_cast<char>(BoardSquare::RubberBoat))),
-			static_cast<char>(tolower(static_cast<char>(BoardSquare::RocketShip))),
-			static_cast<char>(tolower(static_cast<char>(BoardSquare::Submarine))),
-			static_cast<char>(tolower(static_cast<char>(BoardSquare::Battleship)))
-		};
-		IOUtil::replaceIllegalCharacters(nextLine, static_cast<char>(BoardSquare::Empty), legalChars);
+		Logger::getInstance().log(Severity::INFO_LEVEL, "Loading board archive: " + archiveFilename + "..");
 
-		// Traverse each character in the row and put into the board
-		for (char& nextChar : nextLine)
+		vector<ArchivedBoard> archivedBoards;
+		if (!BoardArchive::read(_path + "\\" + archiveFilename, archivedBoards))
 		{
-			// Add to board only squares with real game pieces
-			if (!(nextChar == static_cast<char>(BoardSquare::Empty)))
-				builder.addPiece(Coordinate(rowIndex, colCounter, depthIndex), nextChar);
+			LOG_LIMITED(Severity::WARNING_LEVEL, "Board archive " + archiveFilename + " is invalid or corrupt");
+			return;
+		}
 
-			colCounter++;
+		for (const auto& archivedBoard : archivedBoards)
+		{
+			if (_loadedBoards.find(archivedBoard.name) != _loadedBoards.end())
+			{
+				LOG_LIMITED(Severity::WARNING_LEVEL, "Battle board " + archivedBoard.name + " of " + archiveFilename +
+							" was already loaded, skipping it");
+				continue;
+			}
+
+			// The warnings were found when the board was validated, before it was archived
+			for (const auto& warning : archivedBoard.warnings)
+				LOG_LIMITED(Severity::WARNING_LEVEL, warning);
 
-			// Read at most "width" amount of cols characters from each line, skip the rest
-			if (colCounter >= cols)
-				break;
+			auto board = BoardArchive::toBoard(archivedBoard);
+			if (nullptr == board)
+			{
+				LOG_LIMITED(Severity::WARNING_LEVEL, "Battle board " + archivedBoard.name + " is invalid");
+				continue;
+			}
+
+			_loadedBoards.emplace(make_pair(archivedBoard.name, std::move(board)));
+			_loadedBoardNames.push_back(archivedBoard.name);
+			_archivedSourceHashes[archivedBoard.name] = archivedBoard.sourceHash;
+			LOG_DEBUG("Battle board " + archivedBoard.name + " loaded successfully from " + archiveFilename);
 		}
 	}
 
-	unique_ptr<BattleBoard> BattleshipGameBoardFactory::buildBoardFromFile(const string& boardFile)
+	const vector<string>& BattleshipGameBoardFactory::loadAllBattleBoards()
 	{
-		unique_ptr<BoardBuilder> builder;
+		for (const auto& archiveFilename : _availableArchives)
+			loadBoardArchive(archiveFilename);
 
-		//Board dimensions
-		int cols = 0;
-		int rows = 0;
-		int depth = 0;
+		// Each board is parsed and validated independently, so the loader threads share nothing but the index
+		// of the next board to load. Every thread writes only the results of the boards it took.
+		vector<BoardLoadResult> results(_availableBoards.size());
+		atomic<size_t> nextBoardIndex(0);
 
-		// Current position on board file
-		int rowCounter = 0;
-		int depthCounter = 0;
+		// The cache is only read by the loader threads, and updated once they're done
+		BoardValidationCache cache(_path);
 
-		auto headerParser = [this, &builder, &rows, &cols, &depth](string& nextLine, int lineNum,
-																   bool& isHeader, bool& isValidFile)
+		auto loadBoards = [this, &results, &nextBoardIndex, &cache]()
 		{
-			if (lineNum == 1)
-			{
-				// Parse [cols]x[rows]x[depth] header
-				isValidFile = parseHeader(nextLine, rows, cols, depth);
-				builder = std::make_unique<BoardBuilder>(cols, rows, depth);
-			}
-			else if (lineNum == 2)
+			size_t boardIndex;
+			while ((boardIndex = nextBoardIndex++) < _availableBoards.size())
 			{
-				// Parse empty line - end of header
-				isValidFile = nextLine.empty();
-				isHeader = false; // End of header (2 lines only)
+				// Archived boards are already loaded (the index isn't modified until the threads are done),
+				// their text files are only hashed to tell if they changed since they were archived
+				if (_loadedBoards.find(_availableBoards[boardIndex]) != _loadedBoards.end())
+				{
+					hashBoardFile(_availableBoards[boardIndex], results[boardIndex]);
+					continue;
+				}
+
+				loadBoardFile(_availableBoards[boardIndex], cache, results[boardIndex]);
 			}
 		};
 
-		auto lineParser = [this, &builder, &cols, &rows, &depth,
-						   &rowCounter, &depthCounter](string& nextLine)
+		size_t threadsCount = thread::hardware_concurrency();
+		threadsCount = (threadsCount < _availableBoards.size()) ? threadsCount : _availableBoards.size();
+
+		// The main thread loads boards as well
+		vector<thread> loaderThreads;
+		for (size_t i = 1; i < threadsCount; ++i)
+			loaderThreads.emplace_back(loadBoards);
+
+		loadBoards();
+
+		for (auto& loader : loaderThreads)
+			loader.join();
+
+		// Report and accumulate the boards in filename order, with the warnings of each board kept together
+		for (size_t boardIndex = 0; boardIndex < _availableBoards.size(); ++boardIndex)
 		{
-			if (depthCounter >= depth)
+			const string& boardFilename = _availableBoards[boardIndex];
+			unique_ptr<BattleBoard>& nextBoard = results[boardIndex].board;
+
+			if (_loadedBoards.find(boardFilename) != _loadedBoards.end())
 			{
-				return; // Read the first "depth" amount of levels, ignore the rest
+				if (results[boardIndex].isHashed && (results[boardIndex].contentHash != _archivedSourceHashes[boardFilename]))
+				{
+					LOG_LIMITED(Severity::WARNING_LEVEL, "Battle board " + boardFilename + " was loaded from an archive, " +
+								"but its text file differs from the archived board and is ignored");
+				}
+				else
+				{
+					LOG_DEBUG("Battle board " + boardFilename + " was loaded from an archive, skipping the text file");
+				}
+
+				continue;
 			}
-			else if (nextLine.empty())
+
+			Logger::getInstance().log(Severity::INFO_LEVEL, "Loading battle board: " + boardFilename + "..");
+			for (const auto& warning : results[boardIndex].warnings)
+				LOG_LIMITED(Severity::WARNING_LEVEL, warning);
+
+			if (results[boardIndex].isCached)
 			{
-				rowCounter = 0; // Empty line - end of level data
-				depthCounter++;
+				LOG_DEBUG("Battle board " + boardFilename + " is unchanged, restored it from the validation cache");
+				cache.keep(results[boardIndex].contentHash);
 			}
-			else if (rowCounter > rows)
+			else if (results[boardIndex].isHashed)
 			{
-				return; // Read the first "height" amount of rows in each level, ignore the rest
-			}
-			else
-			{	// Line with game pieces data - parse it
-				parseBoardRow(*builder, nextLine, depthCounter, rowCounter, cols);
-				rowCounter++;
+				cacheBoardFile(boardFilename, results[boardIndex], cache);
 			}
-		};
-
-		bool isValidFile = IOUtil::parseFile(boardFile, lineParser, headerParser);
-
-		if (!isValidFile)
-			return nullptr;
-
-		// Finalize the board, perform validation here
-		auto board = builder->build();
-		return board;
-	}
-
-	const vector<string>& BattleshipGameBoardFactory::loadAllBattleBoards()
-	{
-		// Load each of the battle boards
-		for (const auto& boardFilename : _availableBoards)
-		{
-			Logger::getInstance().log(Severity::INFO_LEVEL, "Loading battle board: " + boardFilename + "..");
-			string boardFile = _path + "\\" + boardFilename;
-			unique_ptr<BattleBoard> nextBoard = buildBoardFromFile(boardFile);
 
 			// Accumulate only valid boards
 			if (nullptr != nextBoard)
@@ -187,11 +257,49 @@ namespace battleship
 			}
 			else
 			{
-				Logger::getInstance().log(Severity::WARNING_LEVEL,
-										  "Battle board " + boardFilename + " is invalid");
+				LOG_LIMITED(Severity::WARNING_LEVEL,
+							"Battle board " + boardFilename + " is invalid");
 			}
 		}
 
+		if (!cache.save())
+			LOG_LIMITED(Severity::WARNING_LEVEL, "Failed to save the board validation cache to " + _path);
+
+		return _loadedBoardNames;
+	}
+
+	const vector<string>& BattleshipGameBoardFactory::generateBattleBoards(const GeneratorSettings& settings)
+	{
+		Logger::getInstance().log(Severity::INFO_LEVEL, "Generating " + to_string(settings.boardsCount) +
+								  " battle boards of " + to_string(settings.width) + "x" + to_string(settings.height) +
+								  "x" + to_string(settings.depth) + "..");
+
+		// Boards go straight from the generator threads to their slots, and are indexed in generation order
+		BoardGenerator generator(settings);
+		vector<unique_ptr<BattleBoard>> boards(settings.boardsCount);
+		auto onBoard = [&boards](size_t position, ArchivedBoard& board)
+		{
+			boards[position] = BoardArchive::toBoard(board);
+		};
+
+		size_t generatedCount = generator.generateAll(0, boards.size(), onBoard);
+
+		for (size_t boardIndex = 0; boardIndex < boards.size(); ++boardIndex)
+		{
+			string boardName = generator.boardName(boardIndex);
+			if ((nullptr == boards[boardIndex]) || (_loadedBoards.find(boardName) != _loadedBoards.end()))
+				continue;
+
+			_loadedBoards.emplace(make_pair(boardName, std::move(boards[boardIndex])));
+			_loadedBoardNames.push_back(boardName);
+		}
+
+		if (generatedCount < boards.size())
+		{
+			LOG_LIMITED(Severity::WARNING_LEVEL, "Generated only " + to_string(generatedCount) + " of " +
+						to_string(boards.size()) + " battle boards, the fleet doesn't fit the board's dimensions");
+		}
+
 		return _loadedBoardNames;
 	}
 
@@ -205,7 +313,7 @@ namespace battleship
 		}
 		else
 		{
-			Logger::getInstance().log(Severity::DEBUG_LEVEL, path + " BattleBoard new instance created..");
+			LOG_DEBUG(path + " BattleBoard new instance created..");
 			return BoardBuilder::clone(*boardIt->second); // Prototype pattern
 		}
 	}
@@ -215,8 +323,70 @@ namespace battleship
 		return _availableBoards;
 	}
 
+	const vector<string>& BattleshipGameBoardFactory::availableArchivesList() const
+	{
+		return _availableArchives;
+	}
+
 	const vector<string>& BattleshipGameBoardFactory::loadedBoardsList() const
 	{
 		return _loadedBoardNames;
 	}
-}
\ No newline at end of file
+
+	bool BattleshipGameBoardFactory::boardDimensions(const string& path, int& width, int& height, int& depth) const
+	{
+		auto boardIt = _loadedBoards.find(path);
+		if (boardIt == _loadedBoards.end())
+			return false;
+
+		width = boardIt->second->width();
+		height = boardIt->second->height();
+		depth = boardIt->second->depth();
+		return true;
+	}
+
+	const unordered_map<string, string>& BattleshipGameBoardFactory::groupSymmetricBoards()
+	{
+		if (_isSymmetryGrouped)
+			return _symmetryRepresentatives;
+
+		// First loaded board of each canonical form
+		unordered_map<string, string> representatives;
+		vector<pair<string, string>> groupForms;	// Canonical form of each group, then of its players swapped
+		size_t symmetricCount = 0;
+
+		for (const auto& boardName : _loadedBoardNames)
+		{
+			const BattleBoard& board = *_loadedBoards.at(boardName);
+			string canonical = BoardSymmetry::canonicalForm(board, false);
+
+			auto representative = representatives.emplace(canonical, boardName).first;
+			if (representative->second == boardName)
+			{
+				groupForms.emplace_back(std::move(canonical), BoardSymmetry::canonicalForm(board, true));
+				continue;
+			}
+
+			_symmetryRepresentatives[representative->second] = representative->second;
+			_symmetryRepresentatives[boardName] = representative->second;
+			symmetricCount++;
+
+			LOG_DEBUG("Battle board " + boardName + " is a mirror or rotation of " + representative->second);
+		}
+
+		// Groups whose players swapped form is another group, each pair is found from both of its groups
+		size_t playersSwappedCount = 0;
+		for (const auto& forms : groupForms)
+		{
+			if ((forms.second != forms.first) && (representatives.find(forms.second) != representatives.end()))
+				playersSwappedCount++;
+		}
+
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  to_string(symmetricCount) + " battle boards are mirrors or rotations of other boards, " +
+								  to_string(playersSwappedCount / 2) + " pairs of boards are the same board with the players swapped");
+
+		_isSymmetryGrouped = true;
+		return _symmetryRepresentatives;
+	}
+}
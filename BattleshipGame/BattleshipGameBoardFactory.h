@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 #include "BattleBoard.h"
+#include "BoardGenerator.h"
 
 using std::shared_ptr;
 using std::unordered_map;
@@ -12,22 +14,38 @@ using std::vector;
 
 namespace battleship
 {
+	class BoardValidationCache;
+	class ResourceManifest;
+
 	/** 
 	 * A factory class for instantiating BattleBoard classes using various methods
-	 * (currently load from file, possibly in the future "set manually" or "random").
+	 * (load from file, or random boards of the BoardGenerator).
 	 */
 	class BattleshipGameBoardFactory
 	{
 	public:
-		/** Creates a factory that initializes itself with a list of boards from the given path. 
+		/** Creates a factory that initializes itself with a list of boards from the given path
+		 *  (from the path's resource manifest, if it's up to date).
 		 *  Boards will be created and validated immediately when the factory is created.
 		 */
 		BattleshipGameBoardFactory(const string& path);
-		~BattleshipGameBoardFactory() = default;
-
-		/** Loads and validates all available battleboard files */
+		~BattleshipGameBoardFactory();
+
+		/** Loads and validates all available battleboard files.
+		 *  Board archives (.sboardb) are loaded first, their boards are already validated. Text boards (.sboard)
+		 *  of the same name as an archived board are skipped (with a warning if the text board changed since
+		 *  it was archived), the rest are parsed and validated in parallel,
+		 *  then reported and indexed in filename order.
+		 *  Text boards whose content didn't change since they were last loaded are restored from the validation
+		 *  cache in the boards path, without parsing and validating them again.
+		 */
 		const vector<string>& loadAllBattleBoards();
 
+		/** Generates random valid boards as the settings specify (in parallel), and adds them to the loaded boards
+		 *  without any text round trip or validation. Returns the list of all loaded boards.
+		 */
+		const vector<string>& generateBattleBoards(const GeneratorSettings& settings);
+
 		/** Creates a BattleBoard instance using prototype pattern.
 		 *  This method assumes "path" refers a valid battleboard that was loaded before,
 		 *	as this function simply returns a new instance clone out of the template object.
@@ -38,13 +56,39 @@ namespace battleship
 		/** Returns list of boards available for loading (not necessarily valid) */
 		const vector<string>& availableBoardsList() const;
 
+		/** Returns list of board archives available for loading (not necessarily valid) */
+		const vector<string>& availableArchivesList() const;
+
 		/** Returns list of boards available for creation */
 		const vector<string>& loadedBoardsList() const;
 
+		/** Fills width, height and depth with the dimensions of a loaded board.
+		 *  Returns false if path doesn't refer a loaded board.
+		 */
+		bool boardDimensions(const string& path, int& width, int& height, int& depth) const;
+
+		/** Groups the loaded boards that are mirrors or rotations of each other (identical copies included),
+		 *  once all boards are loaded. Returns the representative of each board of a group of 2 boards or more,
+		 *  by board name: the first loaded board of the group (which is its own representative).
+		 *  Boards that are another board with the players swapped are reported, but not grouped with it,
+		 *  since swapping the players also swaps the player who attacks first.
+		 */
+		const unordered_map<string, string>& groupSymmetricBoards();
+
 	private:
 		/** Suffix for game board files **/
 		static const string BOARD_SUFFIX;
 
+		/** Outcome of loading a single board file on a loader thread, reported later by the main thread */
+		struct BoardLoadResult
+		{
+			unique_ptr<BattleBoard> board;	// NULL if the board is invalid
+			vector<string> warnings;		// Validation errors of the board, in descending priority order
+			uint64_t contentHash = 0;		// Hash of the board file's content
+			bool isHashed = false;			// False if the board file couldn't be opened
+			bool isCached = false;			// True if the outcome was restored from the validation cache
+		};
+
 		using LoadedBoardsIndex = unordered_map<string, unique_ptr<BattleBoard>>;
 
 		/** Index of loaded board templates, for creating additional instances from prototypes */
@@ -53,30 +97,51 @@ namespace battleship
 		/** List of available board files for loading (not necessarily valid) */
 		vector<string> _availableBoards;
 
+		/** List of available board archive files for loading (not necessarily valid) */
+		vector<string> _availableArchives;
+
 		/** Lists of boards available for creation */
 		vector<string> _loadedBoardNames;
 
 		/** Path to load board files from */
 		string _path;
 
-		/** Parse header of battleboard file.
-		 *  nextLine contains the header line, rows, cols, depth will contain the resulting dimensions parsed.
+		/** Hash of the text board file each archived board was converted from, by board name */
+		unordered_map<string, uint64_t> _archivedSourceHashes;
+
+		/** Resource manifest of the path, NULL unless the boards were listed from it */
+		unique_ptr<ResourceManifest> _manifest;
+
+		/** Representative of each board that is grouped with symmetric boards, see groupSymmetricBoards */
+		unordered_map<string, string> _symmetryRepresentatives;
+
+		/** True once the loaded boards were grouped */
+		bool _isSymmetryGrouped;
+
+		/** Builds a BattleBoard by parsing the input board file path using a BoardBuilder helper object,
+		 *  or restores it from the cache if the file's content is cached. A board file listed in the manifest
+		 *  is looked up in the cache by its listed content hash, so a cached board file isn't even opened.
+		 *	If the file can't be opened or the board is invalid, the result's board is NULL.
+		 *  Validation errors are added to the result's warnings rather than printed.
+		 *  Safe to call from multiple threads.
 		 */
-		bool parseHeader(string& nextLine, int& rows, int& cols, int& depth) const;
+		void loadBoardFile(const string& boardFilename, const BoardValidationCache& cache, BoardLoadResult& result) const;
 
-		/** Parses a line of data from the board file.
-		 *	The line is expected to contain actual data with game pieces.
-		 *  builder is the BoardBuilder used to convert the board file to a real board object,
-		 *  nextLine contains the line string, depthIndex and rowIndex are the current indices of row and depth
-		 *  within the board and "cols" is the total width of the board as parsed from the header.
+		/** Hashes the content of a board file without loading it (by its listed content hash if it's listed in the
+		 *  manifest). Safe to call from multiple threads.
 		 */
-		static void parseBoardRow(BoardBuilder& builder, string& nextLine,
-						   int depthIndex, int rowIndex, int cols);
+		void hashBoardFile(const string& boardFilename, BoardLoadResult& result) const;
 
-		/** Builds a BattleBoard by parsing the input board file path using a BoardBuilder helper object.
-		 *  path is an argument that specifies where board files are expected to exist on the disk.
-		 *	If the path is invalid or no board files are found, errors are printed and NULL is returned.
+		/** Restores the outcome of loading a board file of the given content hash from the cache.
+		 *  Returns false if it isn't cached.
 		 */
-		unique_ptr<BattleBoard> buildBoardFromFile(const string& path);
+		static bool restoreCachedBoard(uint64_t contentHash, const BoardValidationCache& cache, BoardLoadResult& result);
+
+		/** Adds the outcome of loading a board file which wasn't cached to the cache */
+		static void cacheBoardFile(const string& boardFilename, const BoardLoadResult& result,
+								   BoardValidationCache& cache);
+
+		/** Loads the boards of a board archive without validating them again */
+		void loadBoardArchive(const string& archiveFilename);
 	};
 }
\ No newline at end of file
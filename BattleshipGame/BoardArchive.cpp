@@ -0,0 +1,324 @@
+#include "BoardArchive.h"
+#include "IOUtil.h"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using std::ifstream;
+using std::ofstream;
+using std::stringstream;
+
+namespace battleship
+{
+	const string BoardArchive::ARCHIVE_SUFFIX = "sboardb";
+
+	static constexpr char HEADER_MAGIC[4] = { 'S', 'B', 'B', '1' };
+
+	/** Returns the number of squares of the board, or 0 if it's too large to archive */
+	static size_t squaresCount(int width, int height, int depth)
+	{
+		if ((width <= 0) || (height <= 0) || (depth <= 0))
+			return 0;
+
+		uint64_t count = static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * static_cast<uint64_t>(depth);
+		return (count <= BoardArchive::MAX_SQUARES) ? static_cast<size_t>(count) : 0;
+	}
+
+	static bool isShip(char ship)
+	{
+		return (ship == static_cast<char>(BoardSquare::RubberBoat)) ||
+			   (ship == static_cast<char>(BoardSquare::RocketShip)) ||
+			   (ship == static_cast<char>(BoardSquare::Submarine)) ||
+			   (ship == static_cast<char>(BoardSquare::Battleship));
+	}
+
+	/** Appends a piece as it's stored in a board record (PIECE_SIZE bytes) */
+	static void appendPiece(vector<char>& buffer, const BoardPiece& piece)
+	{
+		IOUtil::putValue(buffer, static_cast<int32_t>(piece.firstPos.row));
+		IOUtil::putValue(buffer, static_cast<int32_t>(piece.firstPos.col));
+		IOUtil::putValue(buffer, static_cast<int32_t>(piece.firstPos.depth));
+		IOUtil::putValue(buffer, static_cast<char>(piece.ship));
+		IOUtil::putValue(buffer, static_cast<uint8_t>(piece.player));
+		IOUtil::putValue(buffer, static_cast<uint8_t>(piece.orientation));
+		IOUtil::putValue(buffer, static_cast<uint8_t>(0));
+	}
+
+	/** Parses the fields of a single board record between cursor and end */
+	static bool parseBoardFields(const char* cursor, const char* end, ArchivedBoard& board)
+	{
+		uint32_t piecesCount = 0;
+		uint32_t warningsCount = 0;
+		int32_t dimensions[3];
+
+		if (!IOUtil::getString(cursor, end, board.name) ||
+			!IOUtil::getValue(cursor, end, dimensions[0]) || !IOUtil::getValue(cursor, end, dimensions[1]) ||
+			!IOUtil::getValue(cursor, end, dimensions[2]) || !IOUtil::getValue(cursor, end, board.contentHash) ||
+			!IOUtil::getValue(cursor, end, board.sourceHash) || !IOUtil::getValue(cursor, end, piecesCount) || !IOUtil::getValue(cursor, end, warningsCount))
+		{
+			return false;
+		}
+
+		board.width = dimensions[0];
+		board.height = dimensions[1];
+		board.depth = dimensions[2];
+
+		size_t squares = squaresCount(board.width, board.height, board.depth);
+		if ((squares == 0) || (static_cast<size_t>(end - cursor) < squares))
+			return false;
+
+		board.squares.assign(cursor, cursor + squares);
+		cursor += squares;
+
+		if (static_cast<size_t>(end - cursor) / BoardArchive::PIECE_SIZE < piecesCount)
+			return false;
+
+		board.pieces.clear();
+		board.pieces.reserve(piecesCount);
+		for (uint32_t pieceIndex = 0; pieceIndex < piecesCount; ++pieceIndex)
+		{
+			int32_t row, col, depth;
+			char ship;
+			uint8_t player, orientation, reserved;
+
+			IOUtil::getValue(cursor, end, row);
+			IOUtil::getValue(cursor, end, col);
+			IOUtil::getValue(cursor, end, depth);
+			IOUtil::getValue(cursor, end, ship);
+			IOUtil::getValue(cursor, end, player);
+			IOUtil::getValue(cursor, end, orientation);
+			IOUtil::getValue(cursor, end, reserved);
+
+			bool isInBoard = (row >= 0) && (row < board.height) && (col >= 0) && (col < board.width) &&
+							 (depth >= 0) && (depth < board.depth);
+			if (!isInBoard || !isShip(ship) || (player > static_cast<uint8_t>(PlayerEnum::B)) ||
+				(orientation > static_cast<uint8_t>(Orientation::Z_AXIS)))
+			{
+				return false;
+			}
+
+			board.pieces.push_back(BoardPiece{ Coordinate(row, col, depth), static_cast<BoardSquare>(ship),
+											   static_cast<PlayerEnum>(player), static_cast<Orientation>(orientation) });
+		}
+
+		// The hash covers the pieces as well, so a board whose pieces were altered is rejected too
+		if (BoardArchive::contentHash(board) != board.contentHash)
+			return false;
+
+		// Every warning takes at least its length field
+		if (static_cast<size_t>(end - cursor) / sizeof(uint32_t) < warningsCount)
+			return false;
+
+		board.warnings.assign(warningsCount, string());
+		for (auto& warning : board.warnings)
+		{
+			if (!IOUtil::getString(cursor, end, warning))
+				return false;
+		}
+
+		return cursor == end;
+	}
+
+	bool BoardArchive::fromBoard(const string& name, const BattleBoard& board, const vector<string>& warnings,
+								 uint64_t sourceHash, ArchivedBoard& archived, string& error)
+	{
+		archived.name = name;
+		archived.sourceHash = sourceHash;
+		archived.width = board.width();
+		archived.height = board.height();
+		archived.depth = board.depth();
+		archived.warnings = warnings;
+		archived.pieces.clear();
+
+		size_t squares = squaresCount(archived.width, archived.height, archived.depth);
+		if (squares == 0)
+		{
+			error = "Board dimensions are too large to archive";
+			return false;
+		}
+
+		// Draw the squares out of the validated pieces
+		archived.squares.assign(squares, static_cast<char>(BoardSquare::Empty));
+		for (const auto& piece : board.gamePiecesList())
+		{
+			char ship = static_cast<char>(piece->_shipType->_representation);
+			char square = (piece->_player == PlayerEnum::A) ? ship : static_cast<char>(tolower(ship));
+
+			Coordinate position = piece->_firstPos;
+			for (int index = 0; index < piece->_shipType->_size; ++index)
+			{
+				bool isInBoard = (position.row >= 0) && (position.row < archived.height) &&
+								 (position.col >= 0) && (position.col < archived.width) &&
+								 (position.depth >= 0) && (position.depth < archived.depth);
+				if (!isInBoard)
+				{
+					error = "Ship at " + to_string(position) + " is out of the board's dimensions";
+					return false;
+				}
+
+				size_t squareIndex = (static_cast<size_t>(position.depth) * archived.height + position.row) *
+									 archived.width + position.col;
+				archived.squares[squareIndex] = square;
+
+				position.col += (piece->_orient == Orientation::X_AXIS) ? 1 : 0;
+				position.row += (piece->_orient == Orientation::Y_AXIS) ? 1 : 0;
+				position.depth += (piece->_orient == Orientation::Z_AXIS) ? 1 : 0;
+			}
+
+			archived.pieces.push_back(BoardPiece{ piece->_firstPos, piece->_shipType->_representation,
+												  piece->_player, piece->_orient });
+		}
+
+		archived.contentHash = contentHash(archived);
+		return true;
+	}
+
+	unique_ptr<BattleBoard> BoardArchive::toBoard(const ArchivedBoard& archived)
+	{
+		return BoardBuilder::buildValidated(archived.width, archived.height, archived.depth, archived.pieces,
+											archived.squares);
+	}
+
+	string BoardArchive::toText(const ArchivedBoard& archived)
+	{
+		stringstream text;
+		text << archived.width << "x" << archived.height << "x" << archived.depth << "\n\n";
+
+		// Each layer is its rows followed by an empty line
+		const char* row = archived.squares.data();
+		for (int depth = 0; depth < archived.depth; ++depth)
+		{
+			for (int rowIndex = 0; rowIndex < archived.height; ++rowIndex, row += archived.width)
+			{
+				text.write(row, archived.width);
+				text << "\n";
+			}
+
+			text << "\n";
+		}
+
+		return text.str();
+	}
+
+	void BoardArchive::appendRecord(vector<char>& buffer, const ArchivedBoard& board)
+	{
+		// The record size is patched once the record is written
+		size_t recordStart = buffer.size();
+		IOUtil::putValue(buffer, static_cast<uint32_t>(0));
+
+		IOUtil::putString(buffer, board.name);
+		IOUtil::putValue(buffer, static_cast<int32_t>(board.width));
+		IOUtil::putValue(buffer, static_cast<int32_t>(board.height));
+		IOUtil::putValue(buffer, static_cast<int32_t>(board.depth));
+		IOUtil::putValue(buffer, board.contentHash);
+		IOUtil::putValue(buffer, board.sourceHash);
+		IOUtil::putValue(buffer, static_cast<uint32_t>(board.pieces.size()));
+		IOUtil::putValue(buffer, static_cast<uint32_t>(board.warnings.size()));
+		buffer.insert(buffer.end(), board.squares.begin(), board.squares.end());
+
+		for (const auto& piece : board.pieces)
+			appendPiece(buffer, piece);
+
+		for (const auto& warning : board.warnings)
+			IOUtil::putString(buffer, warning);
+
+		uint32_t recordSize = static_cast<uint32_t>(buffer.size() - recordStart - sizeof(uint32_t));
+		std::memcpy(buffer.data() + recordStart, &recordSize, sizeof(uint32_t));
+	}
+
+	bool BoardArchive::parseRecord(const char*& cursor, const char* end, ArchivedBoard& board)
+	{
+		uint32_t recordSize = 0;
+		if (!IOUtil::getValue(cursor, end, recordSize) || (static_cast<size_t>(end - cursor) < recordSize) ||
+			!parseBoardFields(cursor, cursor + recordSize, board))
+		{
+			return false;
+		}
+
+		cursor += recordSize;
+		return true;
+	}
+
+	bool BoardArchive::read(const string& path, vector<ArchivedBoard>& boards)
+	{
+		ifstream fs(path, ifstream::binary | ifstream::ate);
+		if (!fs.is_open())
+			return false;
+
+		// The whole archive is read at once and parsed in memory
+		std::streamoff fileSize = fs.tellg();
+		if (fileSize < static_cast<std::streamoff>(HEADER_SIZE))
+			return false;
+
+		vector<char> buffer(static_cast<size_t>(fileSize));
+		fs.seekg(0);
+		if (!fs.read(buffer.data(), fileSize))
+			return false;
+
+		const char* cursor = buffer.data();
+		const char* end = buffer.data() + buffer.size();
+
+		char magic[4];
+		uint32_t version = 0;
+		uint32_t boardsCount = 0;
+		uint32_t reserved = 0;
+		IOUtil::getValue(cursor, end, magic);
+		IOUtil::getValue(cursor, end, version);
+		IOUtil::getValue(cursor, end, boardsCount);
+		IOUtil::getValue(cursor, end, reserved);
+
+		// Every board record takes at least its size field
+		if ((std::memcmp(magic, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0) || (version != VERSION) ||
+			(boardsCount > static_cast<size_t>(end - cursor) / sizeof(uint32_t)))
+		{
+			return false;
+		}
+
+		boards.clear();
+		boards.resize(boardsCount);
+		for (auto& board : boards)
+		{
+			if (!parseRecord(cursor, end, board))
+			{
+				boards.clear();
+				return false;
+			}
+		}
+
+		return cursor == end;
+	}
+
+	bool BoardArchive::write(const string& path, const vector<ArchivedBoard>& boards)
+	{
+		vector<char> buffer;
+		buffer.insert(buffer.end(), HEADER_MAGIC, HEADER_MAGIC + sizeof(HEADER_MAGIC));
+		IOUtil::putValue(buffer, VERSION);
+		IOUtil::putValue(buffer, static_cast<uint32_t>(boards.size()));
+		IOUtil::putValue(buffer, static_cast<uint32_t>(0));
+
+		for (const auto& board : boards)
+			appendRecord(buffer, board);
+
+		ofstream fs(path, ofstream::binary | ofstream::trunc);
+		if (!fs.is_open())
+			return false;
+
+		fs.write(buffer.data(), buffer.size());
+		return fs.good();
+	}
+
+	uint64_t BoardArchive::contentHash(const ArchivedBoard& board)
+	{
+		int32_t dimensions[3] = { board.width, board.height, board.depth };
+		uint64_t hash = IOUtil::hashBytes(reinterpret_cast<const char*>(dimensions), sizeof(dimensions));
+		hash = IOUtil::hashBytes(board.squares.data(), board.squares.size(), hash);
+
+		// Pieces are hashed as they're stored
+		vector<char> pieces;
+		pieces.reserve(board.pieces.size() * PIECE_SIZE);
+		for (const auto& piece : board.pieces)
+			appendPiece(pieces, piece);
+
+		return IOUtil::hashBytes(pieces.data(), pieces.size(), hash);
+	}
+}
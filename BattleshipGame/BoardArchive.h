@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "BoardBuilder.h"
+
+using std::string;
+using std::vector;
+using std::unique_ptr;
+
+namespace battleship
+{
+	/** A validated board as stored in a board archive */
+	struct ArchivedBoard
+	{
+		string name;				// Name of the board file it was converted from (e.g. "board1.sboard")
+		int width;
+		int height;
+		int depth;
+		vector<char> squares;		// Dense grid of all squares (layer by layer, row by row), ' ' for empty squares
+		vector<BoardPiece> pieces;	// Validated ships, ordered by first position
+		vector<string> warnings;	// Validation errors the board was loaded with (it's valid despite them)
+		uint64_t contentHash;		// Hash of the dimensions, the squares and the pieces
+		uint64_t sourceHash;		// Hash of the text board file's content it was converted from, 0 if generated
+	};
+
+	/** Binary board files (.sboardb) hold boards that were already parsed and validated, so they are loaded
+	 *  with a single read and no validation. A file holds any number of boards, so a whole corpus of boards
+	 *  can be packed into one archive.
+	 *
+	 *  Layout (little endian):
+	 *  Header   - "SBB1", version, boards count, reserved (16 bytes)
+	 *  Boards   - record size (4 bytes, excluding itself), then:
+	 *             name length (4 bytes) and characters, width, height, depth (4 bytes each), content hash,
+	 *             source hash (8 bytes each), pieces count, warnings count (4 bytes each), the squares (1 byte each),
+	 *             the pieces (row, col, depth - 4 bytes each, ship, player, orientation, reserved - 1 byte each)
+	 *             and the warnings (length (4 bytes) and characters each)
+	 */
+	class BoardArchive
+	{
+	public:
+		virtual ~BoardArchive() = delete; // Static functions only
+
+		static constexpr uint32_t VERSION = 2;
+		static constexpr size_t HEADER_SIZE = 16;
+		static constexpr size_t PIECE_SIZE = 16;
+
+		// Boards with more squares than this can't be archived
+		static constexpr size_t MAX_SQUARES = 1 << 24;
+
+		/** Suffix for board archive files */
+		static const string ARCHIVE_SUFFIX;
+
+		/** Converts a validated board, returns false (with the reason in error) if it can't be archived.
+		 *  sourceHash is the hash of the text board file's content the board was built from.
+		 */
+		static bool fromBoard(const string& name, const BattleBoard& board, const vector<string>& warnings,
+							  uint64_t sourceHash, ArchivedBoard& archived, string& error);
+
+		/** Creates the BattleBoard of an archived board, without validating it again.
+		 *  Returns NULL if its pieces don't match its squares.
+		 */
+		static unique_ptr<BattleBoard> toBoard(const ArchivedBoard& archived);
+
+		/** Returns the board in the text (.sboard) format */
+		static string toText(const ArchivedBoard& archived);
+
+		/** Reads all boards of an archive, returns false if the file is missing, corrupt or of another version */
+		static bool read(const string& path, vector<ArchivedBoard>& boards);
+
+		/** Writes the boards to an archive (replacing the file), returns false if it couldn't be written */
+		static bool write(const string& path, const vector<ArchivedBoard>& boards);
+
+		/** Appends the board's record (with its size) to the buffer */
+		static void appendRecord(vector<char>& buffer, const ArchivedBoard& board);
+
+		/** Parses a board record (with its size) at the cursor and advances it past the record.
+		 *  Returns false if the record exceeds the end or is corrupt.
+		 */
+		static bool parseRecord(const char*& cursor, const char* end, ArchivedBoard& board);
+
+		/** FNV-1a hash of a board's dimensions, squares and pieces */
+		static uint64_t contentHash(const ArchivedBoard& board);
+	};
+}
@@ -0,0 +1,232 @@
+#include "Tests.h"
+#include "BattleBoard.h"
+#include "BoardArchive.h"
+#include "BoardFileParser.h"
+#include "BoardGenerator.h"
+#include <algorithm>
+#include <random>
+#include <tuple>
+
+using std::tuple;
+
+namespace battleship
+{
+	namespace
+	{
+		using PieceTuple = tuple<Coordinate, char, int, int>; // First position, ship, player, orientation
+
+		vector<PieceTuple> archivedPieces(const vector<BoardPiece>& pieces)
+		{
+			vector<PieceTuple> tuples;
+			for (const auto& piece : pieces)
+			{
+				tuples.emplace_back(piece.firstPos, static_cast<char>(piece.ship), static_cast<int>(piece.player),
+									static_cast<int>(piece.orientation));
+			}
+
+			std::sort(tuples.begin(), tuples.end());
+			return tuples;
+		}
+
+		vector<PieceTuple> boardPieces(const BattleBoard& board)
+		{
+			vector<PieceTuple> tuples;
+			for (const auto& piece : board.gamePiecesList())
+			{
+				tuples.emplace_back(piece->_firstPos, static_cast<char>(piece->_shipType->_representation),
+									static_cast<int>(piece->_player), static_cast<int>(piece->_orient));
+			}
+
+			std::sort(tuples.begin(), tuples.end());
+			return tuples;
+		}
+
+		/** Returns true if the squares and the pieces (all the content hash covers) are equal */
+		bool isSameContent(const ArchivedBoard& first, const ArchivedBoard& second)
+		{
+			return (first.width == second.width) && (first.height == second.height) && (first.depth == second.depth) &&
+				   (first.squares == second.squares) && (archivedPieces(first.pieces) == archivedPieces(second.pieces));
+		}
+
+		bool isSameBoard(const ArchivedBoard& first, const ArchivedBoard& second)
+		{
+			return isSameContent(first, second) && (first.name == second.name) && (first.warnings == second.warnings) &&
+				   (first.contentHash == second.contentHash) && (first.sourceHash == second.sourceHash);
+		}
+
+		/** Returns random boards generated on random dimensions and fleets, with random warnings and source hashes */
+		vector<ArchivedBoard> randomBoards(std::mt19937& random, size_t boardsCount)
+		{
+			auto uniform = [&random](int min, int max) { return std::uniform_int_distribution<int>(min, max)(random); };
+
+			vector<ArchivedBoard> boards;
+			while (boards.size() < boardsCount)
+			{
+				GeneratorSettings settings{ 1, uniform(1, 8), uniform(1, 8), uniform(1, 8),
+											{ uniform(0, 2), uniform(0, 2), uniform(0, 2), uniform(0, 1) },
+											static_cast<unsigned int>(random()) };
+				if (settings.fleet == array<int, 4>{ 0, 0, 0, 0 })
+					settings.fleet[0] = 1;
+
+				ArchivedBoard board;
+				if (!BoardGenerator(settings).generate(0, board))
+					continue;
+
+				for (int warning = uniform(0, 2); warning > 0; --warning)
+					board.warnings.push_back("Warning " + std::to_string(uniform(0, 1000)));
+				board.sourceHash = (uniform(0, 1) == 0) ? 0 : (static_cast<uint64_t>(random()) << 32) | random();
+				boards.push_back(std::move(board));
+			}
+
+			return boards;
+		}
+
+		/** Returns true if building the board out of the (altered) archived board is rejected */
+		bool isRejected(const ArchivedBoard& board)
+		{
+			return BoardArchive::toBoard(board) == nullptr;
+		}
+	}
+
+	void boardArchiveTests(unsigned int seed)
+	{
+		static constexpr size_t BOARDS_COUNT = 200;
+
+		std::mt19937 random(seed);
+		string path = TestRunner::scratchPath("boards.sboardb");
+		string damagedPath = TestRunner::scratchPath("damaged.sboardb");
+		string textPath = TestRunner::scratchPath("board.sboard");
+
+		// Round trip: the boards read are the boards written, and build the boards they were converted from
+		vector<ArchivedBoard> boards = randomBoards(random, BOARDS_COUNT);
+		TEST_CHECK(BoardArchive::write(path, boards));
+
+		vector<ArchivedBoard> readBoards;
+		if (!TEST_CHECK(BoardArchive::read(path, readBoards) && (readBoards.size() == boards.size())))
+			return;
+
+		for (size_t index = 0; index < boards.size(); ++index)
+		{
+			const ArchivedBoard& board = readBoards[index];
+			TestRunner::check(isSameBoard(board, boards[index]), "Board " + board.name + " differs after a round trip");
+
+			auto battleBoard = BoardArchive::toBoard(board);
+			if (!TestRunner::check(battleBoard != nullptr, "Board " + board.name + " isn't built"))
+				continue;
+
+			TEST_CHECK(boardPieces(*battleBoard) == archivedPieces(board.pieces));
+
+			// Converting the built board back gives the same archived board
+			ArchivedBoard converted;
+			string error;
+			TEST_CHECK(BoardArchive::fromBoard(board.name, *battleBoard, board.warnings, board.sourceHash, converted, error));
+			TEST_CHECK(isSameBoard(converted, board));
+
+			// The text of the board is parsed and validated into the same board
+			string text = BoardArchive::toText(board);
+			TestRunner::writeBytes(textPath, vector<char>(text.begin(), text.end()));
+			auto builder = BoardFileParser(textPath).parse();
+			vector<string> errors;
+			auto parsedBoard = (builder != nullptr) ? builder->build(errors) : nullptr;
+			TestRunner::check((parsedBoard != nullptr) && (boardPieces(*parsedBoard) == archivedPieces(board.pieces)),
+							  "Text of board " + board.name + " isn't parsed into the same board:\n" + text);
+		}
+
+		vector<char> bytes = TestRunner::readBytes(path);
+
+		// A truncated archive is rejected as a whole
+		for (size_t size = 0; size < bytes.size(); size += 1 + (size * 3) % 509)
+		{
+			TestRunner::writeBytes(damagedPath, vector<char>(bytes.begin(), bytes.begin() + size));
+			TestRunner::check(!BoardArchive::read(damagedPath, readBoards),
+							  "Truncated archive of " + std::to_string(size) + " bytes is read");
+		}
+
+		// Damage is either rejected or limited to what the content hash doesn't cover (names, warnings, source hashes)
+		for (int damage = 0; damage < 1000; ++damage)
+		{
+			vector<char> damaged = bytes;
+			int changesCount = std::uniform_int_distribution<int>(1, 3)(random);
+			for (int change = 0; change < changesCount; ++change)
+			{
+				size_t offset = std::uniform_int_distribution<size_t>(0, damaged.size() - 1)(random);
+				damaged[offset] = static_cast<char>(std::uniform_int_distribution<int>(0, 255)(random));
+			}
+
+			TestRunner::writeBytes(damagedPath, damaged);
+			if (!BoardArchive::read(damagedPath, readBoards))
+				continue;
+
+			bool isSame = (readBoards.size() == boards.size());
+			for (size_t index = 0; isSame && (index < boards.size()); ++index)
+				isSame = isSameContent(readBoards[index], boards[index]) && (BoardArchive::toBoard(readBoards[index]) != nullptr);
+
+			TEST_CHECK(isSame);
+		}
+
+		// Counts and sizes past the end of the file are rejected before anything is allocated for them
+		{
+			vector<char> damaged = bytes;
+			std::fill(damaged.begin() + 8, damaged.begin() + 12, static_cast<char>(0xFF)); // Boards count
+			TestRunner::writeBytes(damagedPath, damaged);
+			TEST_CHECK(!BoardArchive::read(damagedPath, readBoards));
+
+			damaged = bytes;
+			std::fill(damaged.begin() + BoardArchive::HEADER_SIZE, damaged.begin() + BoardArchive::HEADER_SIZE + 4,
+					  static_cast<char>(0xFF)); // First record's size
+			TestRunner::writeBytes(damagedPath, damaged);
+			TEST_CHECK(!BoardArchive::read(damagedPath, readBoards));
+		}
+
+		// An archive of another version is rejected
+		{
+			vector<char> damaged = bytes;
+			damaged[4]++;
+			TestRunner::writeBytes(damagedPath, damaged);
+			TEST_CHECK(!BoardArchive::read(damagedPath, readBoards));
+		}
+
+		// Pieces that don't match the squares are rejected even if the archive is consistent (its hash was updated)
+		for (const auto& original : boards)
+		{
+			if (original.pieces.empty())
+				continue;
+
+			{	// A ship square no piece covers
+				ArchivedBoard board = original;
+				board.pieces.erase(board.pieces.begin());
+				TEST_CHECK(isRejected(board));
+			}
+
+			{	// Two pieces on the same squares
+				ArchivedBoard board = original;
+				board.pieces.push_back(board.pieces[0]);
+				TEST_CHECK(isRejected(board));
+			}
+
+			{	// A piece of the other player
+				ArchivedBoard board = original;
+				board.pieces[0].player = (board.pieces[0].player == PlayerEnum::A) ? PlayerEnum::B : PlayerEnum::A;
+				TEST_CHECK(isRejected(board));
+			}
+
+			{	// A piece moved off its squares, possibly out of the board
+				ArchivedBoard board = original;
+				board.pieces[0].firstPos.col += std::uniform_int_distribution<int>(1, board.width)(random);
+				TEST_CHECK(isRejected(board));
+			}
+
+			{	// A piece of an unknown ship type
+				ArchivedBoard board = original;
+				board.pieces[0].ship = static_cast<BoardSquare>('X');
+				TEST_CHECK(isRejected(board));
+			}
+
+			{	// Squares that don't fill the board's dimensions
+				ArchivedBoard board = original;
+				board.squares.pop_back();
+				TEST_CHECK(isRejected(board));
+			}
+		}
+	}
+}
@@ -0,0 +1,172 @@
+#include "BattleBoard.h"
+#include "BoardArchive.h"
+#include "BoardBuilder.h"
+#include "BoardDataImpl.h"
+#include "BoardGenerator.h"
+#include "GameManager.h"
+#include "HuntTargetAlgo.h"
+#include "IOUtil.h"
+#include <windows.h>
+#include <psapi.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using battleship::ArchivedBoard;
+using battleship::BattleBoard;
+using battleship::BoardArchive;
+using battleship::BoardBuilder;
+using battleship::BoardDataImpl;
+using battleship::BoardGenerator;
+using battleship::GameManager;
+using battleship::GeneratorSettings;
+using battleship::IOUtil;
+
+/** Measures the engine on large boards: generates a cubic board of each edge, with a fleet that grows with the
+ *  board's volume, and plays games of two HuntTargetAlgo players on it.
+ *  Usage: BoardBenchmark [games] [seed] [edge]...
+ *  games - Games played on each board (default 1)
+ *  seed  - Seed of the generated boards (default 0)
+ *  edge  - Edges of the boards (default 10 50 100)
+ *  For each board prints the time to set up the board, to copy it for a game, to let a player scan its view,
+ *  the time per move and the memory taken by the board, its copy and the players.
+ */
+
+static constexpr int SUCCESS_CODE = 0;
+static constexpr int ERROR_CODE = -1;
+
+static constexpr int DEFAULT_EDGES[] = { 10, 50, 100 };
+
+// Squares per ship of each type of a player, so the density of the ships is the same on all boards
+static constexpr size_t SQUARES_PER_SHIP = 1000;
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsedMillis(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static size_t processPrivateBytes()
+{
+	PROCESS_MEMORY_COUNTERS_EX counters = {};
+	counters.cb = sizeof(counters);
+
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters),
+							  sizeof(counters)))
+		return 0;
+
+	return counters.PrivateUsage;
+}
+
+/** Runs the benchmark on a single board edge, returns false if the board couldn't be generated */
+static bool benchmarkBoard(int edge, int gamesCount, unsigned int seed)
+{
+	size_t volume = static_cast<size_t>(edge) * edge * edge;
+	int shipsPerType = static_cast<int>(volume / SQUARES_PER_SHIP);
+	shipsPerType = (shipsPerType > 1) ? shipsPerType : 1;
+
+	GeneratorSettings settings{ 1, edge, edge, edge, { shipsPerType, shipsPerType, shipsPerType, shipsPerType }, seed };
+	BoardGenerator generator(settings);
+	size_t baselineBytes = processPrivateBytes();
+
+	// Setup: generating the board and creating the engine's board, as the game does for archived boards
+	auto setupStart = Clock::now();
+	ArchivedBoard archived;
+	if (!generator.generate(0, archived))
+	{
+		cerr << "Error: Failed to generate a " << edge << "x" << edge << "x" << edge << " board" << endl;
+		return false;
+	}
+
+	shared_ptr<BattleBoard> board = BoardArchive::toBoard(archived);
+	double setupMillis = elapsedMillis(setupStart);
+
+	double cloneMillis = 0;
+	double scanMillis = 0;
+	double gameMillis = 0;
+	long long movesCount = 0;
+	size_t peakBytes = 0;
+
+	for (int game = 0; game < gamesCount; ++game)
+	{
+		// Every game is played on its own copy of the board
+		auto cloneStart = Clock::now();
+		auto gameBoard = BoardBuilder::clone(*board);
+		cloneMillis += elapsedMillis(cloneStart);
+
+		BoardDataImpl playerAView(PlayerEnum::A, gameBoard);
+		BoardDataImpl playerBView(PlayerEnum::B, gameBoard);
+		HuntTargetAlgo playerA;
+		HuntTargetAlgo playerB;
+
+		// The game sets the boards again, this scan is measured on its own
+		auto scanStart = Clock::now();
+		playerA.setBoard(playerAView);
+		scanMillis += elapsedMillis(scanStart);
+
+		auto gameStart = Clock::now();
+		auto results = GameManager::runGame(gameBoard, &playerA, &playerB, playerAView, playerBView);
+		gameMillis += elapsedMillis(gameStart);
+		movesCount += (results != nullptr) ? results->movesCount : 0;
+
+		size_t gameBytes = processPrivateBytes();
+		peakBytes = (gameBytes > peakBytes) ? gameBytes : peakBytes;
+	}
+
+	size_t memoryBytes = (peakBytes > baselineBytes) ? (peakBytes - baselineBytes) : 0;
+	double movesPerGame = static_cast<double>(movesCount) / gamesCount;
+
+	cout << std::fixed << std::setprecision(2)
+		 << edge << "x" << edge << "x" << edge << " (" << board->getPlayerAShipCount() + board->getPlayerBShipCount()
+		 << " ships): setup " << setupMillis << "ms, copy " << cloneMillis / gamesCount
+		 << "ms, player scan " << scanMillis / gamesCount << "ms, "
+		 << movesPerGame << " moves per game, " << ((movesCount > 0) ? gameMillis * 1000 / movesCount : 0)
+		 << "us per move, memory " << memoryBytes / 1024 << "KB" << endl;
+
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	int gamesCount = 1;
+	unsigned int seed = 0;
+
+	if ((argc > 1) && (!IOUtil::isInteger(argv[1]) || (std::stoi(argv[1]) <= 0)))
+	{
+		cerr << "Usage: BoardBenchmark [games] [seed] [edge]..." << endl;
+		return ERROR_CODE;
+	}
+
+	if (argc > 1)
+		gamesCount = std::stoi(argv[1]);
+
+	if ((argc > 2) && IOUtil::isInteger(argv[2]))
+		seed = static_cast<unsigned int>(std::stoul(argv[2]));
+
+	vector<int> edges;
+	for (int argIndex = 3; argIndex < argc; ++argIndex)
+	{
+		if (!IOUtil::isInteger(argv[argIndex]) || (std::stoi(argv[argIndex]) <= 0))
+		{
+			cerr << "Error: Invalid board edge " << argv[argIndex] << endl;
+			return ERROR_CODE;
+		}
+
+		edges.push_back(std::stoi(argv[argIndex]));
+	}
+
+	if (edges.empty())
+		edges.assign(std::begin(DEFAULT_EDGES), std::end(DEFAULT_EDGES));
+
+	bool isSuccessful = true;
+	for (int edge : edges)
+		isSuccessful = benchmarkBoard(edge, gamesCount, seed) && isSuccessful;
+
+	return isSuccessful ? SUCCESS_CODE : ERROR_CODE;
+}
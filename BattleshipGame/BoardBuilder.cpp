@@ -1,4 +1,5 @@
 #include <iostream>
+#include <algorithm>
 #include "BoardBuilder.h"
 #include "Logger.h"
 
@@ -79,207 +80,92 @@ namespace battleship
 		}
 	}
 
-	BoardBuilder::ShipMask::ShipMask(BoardSquare ship) : maskType(ship)
+	BoardBuilder::ValidationGrid::ValidationGrid(const map<Coordinate, char>& boardMap, int width, int height, int depth) :
+		_isDense(false), _origin(0, 0, 0), _rows(0), _cols(0), _depth(0)
 	{
-		switch (ship)
+		// Squares past the board's dimensions (e.g. an extra row in the board file) aren't part of the board
+		auto isInBoard = [width, height, depth](const Coordinate& coord)
 		{
-			case BoardSquare::RubberBoat:
-			{
-				mask = {
-					{Coordinate(1, 0, 0), BoardSquare::Empty}, {Coordinate(-1, 0, 0), BoardSquare::Empty},
-					{Coordinate(0, 1, 0), BoardSquare::Empty}, {Coordinate(0, -1, 0), BoardSquare::Empty},
-					{Coordinate(0, 0, 1), BoardSquare::Empty}, {Coordinate(0, 0, -1), BoardSquare::Empty}
-				};
-				break;
-			}
-			case BoardSquare::RocketShip:
-			{
-				mask = {
-					{Coordinate(0, 1, 0), BoardSquare::RocketShip},
-					{Coordinate(1, 0, 0), BoardSquare::Empty}, {Coordinate(-1, 0, 0), BoardSquare::Empty},
-					{Coordinate(1, 1, 0), BoardSquare::Empty}, {Coordinate(-1, 1, 0), BoardSquare::Empty},
-					{Coordinate(0, 2, 0), BoardSquare::Empty}, {Coordinate(0, -1, 0), BoardSquare::Empty},
-					{Coordinate(0, 0, 1), BoardSquare::Empty}, {Coordinate(0, 0, -1), BoardSquare::Empty},
-					{Coordinate(0, 1, 1), BoardSquare::Empty}, {Coordinate(0, 1, -1), BoardSquare::Empty}
-				};
-				break;
-			}
-			case BoardSquare::Submarine:
-			{
-				mask = {
-					{Coordinate(0, 1, 0), BoardSquare::Submarine}, {Coordinate(0, 2, 0), BoardSquare::Submarine},
-					{Coordinate(1, 0, 0), BoardSquare::Empty}, {Coordinate(-1, 0, 0), BoardSquare::Empty},
-					{Coordinate(1, 1, 0), BoardSquare::Empty}, {Coordinate(-1, 1, 0), BoardSquare::Empty},
-					{Coordinate(1, 2, 0), BoardSquare::Empty}, {Coordinate(-1, 2, 0), BoardSquare::Empty},
-					{Coordinate(0, 3, 0), BoardSquare::Empty}, {Coordinate(0, -1, 0), BoardSquare::Empty},
-					{Coordinate(0, 0, 1), BoardSquare::Empty}, {Coordinate(0, 0, -1), BoardSquare::Empty},
-					{Coordinate(0, 1, 1), BoardSquare::Empty}, {Coordinate(0, 1, -1), BoardSquare::Empty},
-					{Coordinate(0, 2, 1), BoardSquare::Empty}, {Coordinate(0, 2, -1), BoardSquare::Empty}
-				};
-				break;
-			}
-			case BoardSquare::Battleship:
-			{
-				mask = {
-					{Coordinate(0, 1, 0), BoardSquare::Battleship}, {Coordinate(0, 2, 0), BoardSquare::Battleship},
-					{Coordinate(0, 3, 0), BoardSquare::Battleship},
-					{Coordinate(1, 0, 0), BoardSquare::Empty}, {Coordinate(-1, 0, 0), BoardSquare::Empty},
-					{Coordinate(1, 1, 0), BoardSquare::Empty}, {Coordinate(-1, 1, 0), BoardSquare::Empty},
-					{Coordinate(1, 2, 0), BoardSquare::Empty}, {Coordinate(-1, 2, 0), BoardSquare::Empty},
-					{Coordinate(1, 3, 0), BoardSquare::Empty}, {Coordinate(-1, 3, 0), BoardSquare::Empty},
-					{Coordinate(0, 4, 0), BoardSquare::Empty}, {Coordinate(0, -1, 0), BoardSquare::Empty},
-					{Coordinate(0, 0, 1), BoardSquare::Empty}, {Coordinate(0, 0, -1), BoardSquare::Empty},
-					{Coordinate(0, 1, 1), BoardSquare::Empty}, {Coordinate(0, 1, -1), BoardSquare::Empty},
-					{Coordinate(0, 2, 1), BoardSquare::Empty}, {Coordinate(0, 2, -1), BoardSquare::Empty},
-					{Coordinate(0, 3, 1), BoardSquare::Empty}, {Coordinate(0, 3, -1), BoardSquare::Empty}
-				};
-				break;
-			}
-			default:
-			{
-				mask = {};
-				break;
-			}
+			return (coord.row >= 0) && (coord.row < height) && (coord.col >= 0) && (coord.col < width) &&
+				   (coord.depth >= 0) && (coord.depth < depth);
+		};
+
+		// Bounding box of the ships
+		Coordinate lowest(height, width, depth);
+		Coordinate highest(-1, -1, -1);
+		for (const auto& square : boardMap)
+		{
+			if (!isInBoard(square.first))
+				continue;
+
+			lowest = Coordinate((square.first.row < lowest.row) ? square.first.row : lowest.row,
+								(square.first.col < lowest.col) ? square.first.col : lowest.col,
+								(square.first.depth < lowest.depth) ? square.first.depth : lowest.depth);
+			highest = Coordinate((square.first.row > highest.row) ? square.first.row : highest.row,
+								 (square.first.col > highest.col) ? square.first.col : highest.col,
+								 (square.first.depth > highest.depth) ? square.first.depth : highest.depth);
 		}
 
-		orient = Orientation::X_AXIS;
-		wrongSize = false;
-		adjacentShips = false;
-	}
+		if (highest.row < 0)
+			return; // No ships at all
 
-	BoardBuilder::ShipMask::~ShipMask()
-	{
-	}
+		_origin = lowest;
+		_rows = highest.row - lowest.row + 1;
+		_cols = highest.col - lowest.col + 1;
+		_depth = highest.depth - lowest.depth + 1;
+		_isDense = (static_cast<uint64_t>(_rows) * _cols * _depth <= MAX_DENSE_SQUARES);
 
-	void BoardBuilder::ShipMask::applyMaskEntry(char boardSquare, char shipChar, const MaskEntry& maskEntry, bool axisException,
-												int& matchSizeAxis, bool& wrongSizeAxis, bool& adjacentShipsAxis)
-	{
-		char maskChar = static_cast<char>(maskEntry.second);
-		if (islower(shipChar))
-			maskChar = tolower(maskChar);
+		if (_isDense)
+			_squares.assign(static_cast<size_t>(_rows) * _cols * _depth, static_cast<char>(BoardSquare::Empty));
 
-		if (!axisException)
+		for (const auto& square : boardMap)
 		{
-			if (boardSquare == maskChar)
-			{
-				if (maskChar != static_cast<char>(BoardSquare::Empty))
-					matchSizeAxis++;
-			}
+			if (!isInBoard(square.first))
+				continue;
+
+			if (_isDense)
+				*find(square.first) = square.second;
 			else
-			{
-				if ((boardSquare != static_cast<char>(BoardSquare::Empty)) &&	(boardSquare != shipChar))
-				{
-					if (matchSizeAxis >= (maskEntry.first.col + 1))
-						adjacentShipsAxis = true;
-				}
-				else
-				{
-					wrongSizeAxis = true;
-				}
-			}
-		}
-		else
-		{
-			if (maskChar != static_cast<char>(BoardSquare::Empty))
-				wrongSizeAxis = true;
+				_sparseSquares.emplace(square.first, square.second);
 		}
 	}
 
-	bool BoardBuilder::ShipMask::applyMask(const map<Coordinate, char>& boardMap, tuple<int, int, int> boardSize, Coordinate coord,
-										   PlayerEnum player)
+	char* BoardBuilder::ValidationGrid::find(const Coordinate& coord)
+	{
+		return const_cast<char*>(static_cast<const ValidationGrid*>(this)->find(coord));
+	}
+
+	const char* BoardBuilder::ValidationGrid::find(const Coordinate& coord) const
 	{
-		char shipChar = (player == PlayerEnum::A) ? static_cast<char>(maskType) : tolower(static_cast<char>(maskType));
-		int boardWidth = std::get<0>(boardSize);
-		int boardHeight = std::get<1>(boardSize);
-		int boardDepths = std::get<2>(boardSize);
-
-		int matchSizeXAxis = 1;
-		int matchSizeYAxis = 1;
-		int matchSizeZAxis = 1;
-		bool wrongSizeXAxis = false;
-		bool wrongSizeYAxis = false;
-		bool wrongSizeZAxis = false;
-		bool adjacentShipsXAxis = false;
-		bool adjacentShipsYAxis = false;
-		bool adjacentShipsZAxis = false;
-
-		for (const auto& maskEntry : mask)
+		if (!_isDense)
 		{
-			int i = maskEntry.first.row;
-			int j = maskEntry.first.col;
-			int k = maskEntry.first.depth;
-			bool XAxisException = ((coord.row + i < 0) || (coord.row + i >= boardHeight) || (coord.col + j < 0) ||
-								   (coord.col + j >= boardWidth) || (coord.depth + k < 0) || (coord.depth + k >= boardDepths));
-			bool YAxisException = ((coord.row + j < 0) || (coord.row + j >= boardHeight) || (coord.col + i < 0) ||
-								   (coord.col + i >= boardWidth) || (coord.depth + k < 0) || (coord.depth + k >= boardDepths));
-			bool ZAxisException = ((coord.row + i < 0) || (coord.row + i >= boardHeight) || (coord.col + k < 0) ||
-								   (coord.col + k >= boardWidth) || (coord.depth + j < 0) || (coord.depth + j >= boardDepths));
-			
-			// Check for X_AXIS orientation
-			Coordinate XOrientCoord(coord.row + i, coord.col + j, coord.depth + k);
-			char currBoardSquare = (boardMap.find(XOrientCoord) != boardMap.end()) ?
-									boardMap.at(XOrientCoord) : static_cast<char>(BoardSquare::Empty);
-			applyMaskEntry(currBoardSquare, shipChar, maskEntry, XAxisException, matchSizeXAxis, wrongSizeXAxis, adjacentShipsXAxis);
-
-			// Check for Y_AXIS orientation
-			Coordinate YOrientCoord(coord.row + j, coord.col + i, coord.depth + k);
-			currBoardSquare = (boardMap.find(YOrientCoord) != boardMap.end()) ?
-							   boardMap.at(YOrientCoord) : static_cast<char>(BoardSquare::Empty);
-			applyMaskEntry(currBoardSquare, shipChar, maskEntry, YAxisException, matchSizeYAxis, wrongSizeYAxis, adjacentShipsYAxis);
-
-			// Check for Z_AXIS orientation
-			Coordinate ZOrientCoord(coord.row + i, coord.col + k, coord.depth + j);
-			currBoardSquare = (boardMap.find(ZOrientCoord) != boardMap.end()) ?
-							   boardMap.at(ZOrientCoord) : static_cast<char>(BoardSquare::Empty);
-			applyMaskEntry(currBoardSquare, shipChar, maskEntry, ZAxisException, matchSizeZAxis, wrongSizeZAxis, adjacentShipsZAxis);
+			auto squareIt = _sparseSquares.find(coord);
+			return (squareIt != _sparseSquares.end()) ? &squareIt->second : nullptr;
 		}
 
-		bool isXAxisMask = ((!wrongSizeXAxis) && (!adjacentShipsXAxis));
-		bool isYAxisMask = ((!wrongSizeYAxis) && (!adjacentShipsYAxis));
-		bool isZAxisMask = ((!wrongSizeZAxis) && (!adjacentShipsZAxis));
+		int row = coord.row - _origin.row;
+		int col = coord.col - _origin.col;
+		int depth = coord.depth - _origin.depth;
+		if ((row < 0) || (row >= _rows) || (col < 0) || (col >= _cols) || (depth < 0) || (depth >= _depth))
+			return nullptr;
 
-		int maxMatchSize;
-		if (matchSizeXAxis < matchSizeYAxis)
-		{
-			maxMatchSize = matchSizeYAxis;
-			orient = Orientation::Y_AXIS;
-		}
-		else
-		{
-			maxMatchSize = matchSizeXAxis;
-			orient = Orientation::X_AXIS;
-		}
-		if (maxMatchSize < matchSizeZAxis)
-		{
-			orient = Orientation::Z_AXIS;
-		}
-		
-		wrongSize = (wrongSizeXAxis && wrongSizeYAxis && wrongSizeZAxis);
-		
-		if ((!wrongSizeXAxis) && wrongSizeYAxis && wrongSizeZAxis)
-		{
-			adjacentShips = adjacentShipsXAxis;
-		}
-		else if ((!wrongSizeYAxis) && wrongSizeXAxis && wrongSizeZAxis)
-		{
-			adjacentShips = adjacentShipsYAxis;
-		}
-		else if ((!wrongSizeZAxis) && wrongSizeXAxis && wrongSizeYAxis)
-		{
-			adjacentShips = adjacentShipsZAxis;
-		}
-		else
-		{
-			adjacentShips = (adjacentShipsXAxis || adjacentShipsYAxis || adjacentShipsZAxis);
-		}
+		return _squares.data() + (static_cast<size_t>(depth) * _rows + row) * _cols + col;
+	}
 
-		return (isXAxisMask || isYAxisMask || isZAxisMask);
+	char BoardBuilder::ValidationGrid::at(const Coordinate& coord) const
+	{
+		const char* square = find(coord);
+		return (square != nullptr) ? static_cast<char>(*square & ~VISITED_FLAG) : static_cast<char>(BoardSquare::Empty);
 	}
 
-	void BoardBuilder::ShipMask::resetMaskFlags()
+	bool BoardBuilder::ValidationGrid::visit(const Coordinate& coord)
 	{
-		wrongSize = false;
-		adjacentShips = false;
+		char* square = find(coord);
+		if ((square == nullptr) || (*square == static_cast<char>(BoardSquare::Empty)) || (*square & VISITED_FLAG))
+			return false;
+
+		*square |= VISITED_FLAG;
+		return true;
 	}
 
 	BoardBuilder* BoardBuilder::addPiece(Coordinate coord, char type)
@@ -288,185 +174,186 @@ namespace battleship
 		return this;
 	}
 
-	void BoardBuilder::markVisitedCoords(unordered_set<Coordinate, CoordinateHash>& coordSet, Coordinate coord)
+	BoardBuilder* BoardBuilder::addPieces(const BoardGrid& grid)
 	{
-		char ship = boardMap[coord];	// This coordinate has came from the boardMap, so it indeed exists
-		int j = coord.col;
-		bool sameCharInRow = true;
+		const char* square = grid.squares.data();
 
-		while ((j < boardWidth) && sameCharInRow)
+		// The grid is in the map's order (depth, row, col), so every square is inserted at the end
+		for (int depth = 0; depth < grid.depth; ++depth)
 		{
-			int i = coord.row;
-			bool sameCharInCol = true;
-			while ((i < boardHeight) && sameCharInCol)
+			for (int row = 0; row < grid.rows; ++row)
 			{
-				int k = coord.depth;
-				bool sameCharInDepth = true;
-				while ((k < boardDepth) && sameCharInDepth)
+				for (int col = 0; col < grid.cols; ++col, ++square)
 				{
-					Coordinate currCoord(i, j, k);
-					if ((boardMap.find(currCoord) != boardMap.end()) && (boardMap[currCoord] == ship))
-					{
-						coordSet.insert(currCoord);
-					}
-					else
-					{
-						sameCharInDepth = false;
-						if (k == coord.depth)
-						{
-							sameCharInCol = false;
-							if (i == coord.row)
-								sameCharInRow = false;
-						}
-					}
-					k++;
+					if (*square != static_cast<char>(BoardSquare::Empty))
+						boardMap.emplace_hint(boardMap.end(), Coordinate(row, col, depth), *square);
 				}
-				i++;
 			}
-			j++;
 		}
+
+		return this;
 	}
 
-	bool BoardBuilder::isBalancedBoard(vector<BoardSquare>& playerAShips, vector<BoardSquare>& playerBShips)
+	BoardBuilder::ShipComponent BoardBuilder::findShip(ValidationGrid& grid, const Coordinate& firstPos, char square)
 	{
-		if (playerAShips.empty() || playerBShips.empty())
-			return false;
+		static const Coordinate NEIGHBORS[] = {
+			Coordinate(1, 0, 0), Coordinate(-1, 0, 0), Coordinate(0, 1, 0),
+			Coordinate(0, -1, 0), Coordinate(0, 0, 1), Coordinate(0, 0, -1)
+		};
 
-		bool balancedBoard = true;
-		for (const auto& AShip : playerAShips)
+		ShipComponent ship = { 0, true, Orientation::X_AXIS, false };
+		Coordinate lowest = firstPos;
+		Coordinate highest = firstPos;
+
+		// Flood fill over squares of the same character, anything else that isn't empty is another ship
+		vector<Coordinate> pending = { firstPos };
+		while (!pending.empty())
 		{
-			bool foundMatch = false;
-			for (vector<BoardSquare>::iterator BShipIt = playerBShips.begin(); BShipIt != playerBShips.end(); ++BShipIt)
+			Coordinate coord = pending.back();
+			pending.pop_back();
+			ship.size++;
+
+			lowest = Coordinate((coord.row < lowest.row) ? coord.row : lowest.row,
+								(coord.col < lowest.col) ? coord.col : lowest.col,
+								(coord.depth < lowest.depth) ? coord.depth : lowest.depth);
+			highest = Coordinate((coord.row > highest.row) ? coord.row : highest.row,
+								 (coord.col > highest.col) ? coord.col : highest.col,
+								 (coord.depth > highest.depth) ? coord.depth : highest.depth);
+
+			for (const auto& offset : NEIGHBORS)
 			{
-				if (*BShipIt == AShip)
+				Coordinate neighbor(coord.row + offset.row, coord.col + offset.col, coord.depth + offset.depth);
+				char neighborSquare = grid.at(neighbor);
+
+				if (neighborSquare == square)
 				{
-					foundMatch = true;
-					playerBShips.erase(BShipIt);
-					break;
+					if (grid.visit(neighbor))
+						pending.push_back(neighbor);
+				}
+				else if (neighborSquare != static_cast<char>(BoardSquare::Empty))
+				{
+					ship.isAdjacent = true;
 				}
 			}
+		}
 
-			if (!foundMatch)
-			{
-				balancedBoard = false;
-				break;
-			}
+		// Connected squares spanning a single axis are a straight line without gaps
+		bool spansRows = (highest.row > lowest.row);
+		bool spansCols = (highest.col > lowest.col);
+		bool spansDepth = (highest.depth > lowest.depth);
+		ship.isStraight = ((spansRows ? 1 : 0) + (spansCols ? 1 : 0) + (spansDepth ? 1 : 0) <= 1);
+
+		if (spansRows)
+			ship.orient = Orientation::Y_AXIS;
+		else if (spansDepth)
+			ship.orient = Orientation::Z_AXIS;
+
+		return ship;
+	}
+
+	bool BoardBuilder::isBalancedBoard(const ShipsCount& playerAShips, const ShipsCount& playerBShips)
+	{
+		bool hasAShips = false;
+		bool hasBShips = false;
+		for (size_t shipIndex = 0; shipIndex < SHIP_TYPES_COUNT; ++shipIndex)
+		{
+			hasAShips = hasAShips || (playerAShips[shipIndex] > 0);
+			hasBShips = hasBShips || (playerBShips[shipIndex] > 0);
 		}
-		
-		return (balancedBoard && playerBShips.empty());
+
+		return hasAShips && hasBShips && (playerAShips == playerBShips);
 	}
 
 	// This function assumes that the board contains only ship characters or space, and not any other character
 	bool BoardBuilder::isValidBoard(BattleBoard* board, set<BoardInitializeError, ErrorPriorityFunction>& errorQueue)
 	{
-		tuple<int, int, int> boardSize = std::make_tuple(boardWidth, boardHeight, boardDepth);
-		ShipMask rubberMask(BoardSquare::RubberBoat);
-		ShipMask rocketMask(BoardSquare::RocketShip);
-		ShipMask submarineMask(BoardSquare::Submarine);
-		ShipMask battleshipMask(BoardSquare::Battleship);
-		ShipMask* currMask;
+		ValidationGrid grid(boardMap, boardWidth, boardHeight, boardDepth);
 
 		bool validBoard = true;
-		bool isMatch;
-		unordered_set<Coordinate, CoordinateHash> visitedCoords;
-		vector<BoardSquare> playerAShips;
-		vector<BoardSquare> playerBShips;
+		ShipsCount playerAShips = {};
+		ShipsCount playerBShips = {};
+
+		// The map is ordered by depth, row and col, so the first square reached of each ship is its first position
 		for (const auto& square : boardMap)
 		{
-			if (visitedCoords.find(square.first) != visitedCoords.end())
-				continue;
+			if (!grid.visit(square.first))
+				continue; // Part of a ship that was already validated, or out of the board
 
 			PlayerEnum player = (isupper(square.second)) ? PlayerEnum::A : PlayerEnum::B;
 			const ShipType* shipType;
+			size_t shipIndex;
+			ErrorPriorityEnum wrongSizeError;
 
 			switch (toupper(square.second))
 			{
 			case static_cast<char>(BoardSquare::RubberBoat) :
 			{
 				shipType = &BattleBoard::RUBBER_BOAT;
-				isMatch = rubberMask.applyMask(boardMap, boardSize, square.first, player);
-				if (rubberMask.wrongSize)
-				{
-					if (player == PlayerEnum::A)
-						errorQueue.insert(BoardInitializeError(ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_B_PLAYER_A));
-					else
-						errorQueue.insert(BoardInitializeError(ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_B_PLAYER_B));
-				}
-				currMask = &rubberMask;
+				shipIndex = 0;
+				wrongSizeError = (player == PlayerEnum::A) ? ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_B_PLAYER_A :
+															 ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_B_PLAYER_B;
 				break;
 			}
 			case static_cast<char>(BoardSquare::RocketShip) :
 			{
 				shipType = &BattleBoard::ROCKET_SHIP;
-				isMatch = rocketMask.applyMask(boardMap, boardSize, square.first, player);
-				if (rocketMask.wrongSize)
-				{
-					if (player == PlayerEnum::A)
-						errorQueue.insert(BoardInitializeError(ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_P_PLAYER_A));
-					else
-						errorQueue.insert(BoardInitializeError(ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_P_PLAYER_B));
-				}
-				currMask = &rocketMask;
+				shipIndex = 1;
+				wrongSizeError = (player == PlayerEnum::A) ? ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_P_PLAYER_A :
+															 ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_P_PLAYER_B;
 				break;
 			}
 			case static_cast<char>(BoardSquare::Submarine) :
 			{
 				shipType = &BattleBoard::SUBMARINE;
-				isMatch = submarineMask.applyMask(boardMap, boardSize, square.first, player);
-				if (submarineMask.wrongSize)
-				{
-					if (player == PlayerEnum::A)
-						errorQueue.insert(BoardInitializeError(ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_M_PLAYER_A));
-					else
-						errorQueue.insert(BoardInitializeError(ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_M_PLAYER_B));
-				}
-				currMask = &submarineMask;
+				shipIndex = 2;
+				wrongSizeError = (player == PlayerEnum::A) ? ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_M_PLAYER_A :
+															 ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_M_PLAYER_B;
 				break;
 			}
 			case static_cast<char>(BoardSquare::Battleship) :
 			{
 				shipType = &BattleBoard::BATTLESHIP;
-				isMatch = battleshipMask.applyMask(boardMap, boardSize, square.first, player);
-				if (battleshipMask.wrongSize)
-				{
-					if (player == PlayerEnum::A)
-						errorQueue.insert(BoardInitializeError(ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_D_PLAYER_A));
-					else
-						errorQueue.insert(BoardInitializeError(ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_D_PLAYER_B));
-				}
-				currMask = &battleshipMask;
+				shipIndex = 3;
+				wrongSizeError = (player == PlayerEnum::A) ? ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_D_PLAYER_A :
+															 ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_D_PLAYER_B;
 				break;
 			}
 			default:
 				return false;	// Should not reach this line
 			}
 
-			markVisitedCoords(visitedCoords, square.first);
+			ShipComponent ship = findShip(grid, square.first, square.second);
+			bool wrongSize = !ship.isStraight || (ship.size != shipType->_size);
 
-			string logMsg = "Ship type " + string(1, static_cast<char>(shipType->_representation)) + " of player " +
-							to_string(static_cast<int>(player));
+			auto logMsg = [&shipType, player]()
+			{
+				return "Ship type " + string(1, static_cast<char>(shipType->_representation)) + " of player " +
+					   to_string(static_cast<int>(player));
+			};
 
-			if (!currMask->wrongSize)
+			if (!wrongSize)
 			{
-				Logger::getInstance().log(Severity::DEBUG_LEVEL, logMsg + " is valid.");
-				board->addGamePiece(square.first, *shipType, player, currMask->orient);
+				LOG_DEBUG(logMsg() + " is valid.");
+				board->addGamePiece(square.first, *shipType, player, ship.orient);
 				if (player == PlayerEnum::A)
-					playerAShips.push_back(shipType->_representation);
+					playerAShips[shipIndex]++;
 				else
-					playerBShips.push_back(shipType->_representation);
+					playerBShips[shipIndex]++;
+			}
+			else
+			{
+				errorQueue.insert(BoardInitializeError(wrongSizeError));
 			}
-			
-			if (!isMatch)
+
+			if (wrongSize || ship.isAdjacent)
 			{
-				Logger::getInstance().log(Severity::DEBUG_LEVEL, logMsg + " is invalid.");
+				LOG_DEBUG(logMsg() + " is invalid.");
 				validBoard = false;
-				if (currMask->adjacentShips)
+				if (ship.isAdjacent)
 					errorQueue.insert(BoardInitializeError(ErrorPriorityEnum::ADJACENT_SHIPS_ON_BOARD));
 			}
-
-			currMask->resetMaskFlags();
 		}
-		
+
 		if ((board->getPlayerAShipCount() == 0) && (board->getPlayerBShipCount() == 0))
 		{
 			validBoard = false;
@@ -480,15 +367,25 @@ namespace battleship
 		return validBoard;
 	}
 
-	void BoardBuilder::printErrors(const set<BoardInitializeError, ErrorPriorityFunction>& errorQueue)
+	void BoardBuilder::printErrors(const vector<string>& validationErrors)
 	{
-		for (const auto& err : errorQueue)
+		for (const auto& err : validationErrors)
 		{
-			Logger::getInstance().log(Severity::WARNING_LEVEL, err.getMsg());
+			LOG_LIMITED(Severity::WARNING_LEVEL, err);
 		}
 	}
 
 	unique_ptr<BattleBoard> BoardBuilder::build()
+	{
+		vector<string> validationErrors;
+		auto board = build(validationErrors);
+
+		printErrors(validationErrors);
+
+		return board;
+	}
+
+	unique_ptr<BattleBoard> BoardBuilder::build(vector<string>& validationErrors)
 	{
 		// Only BoardBuilder can instantiate this class - so we must create without make_shared macro
 		unique_ptr<BattleBoard> board(new BattleBoard(boardWidth, boardHeight, boardDepth));
@@ -505,11 +402,74 @@ namespace battleship
 		// Call validation process here, add errors to errorQueue
 		bool validBoard = isValidBoard(board.get(), errorQueue);
 
-		printErrors(errorQueue);
+		for (const auto& err : errorQueue)
+			validationErrors.push_back(err.getMsg());
 
 		return validBoard ? std::move(board) : NULL;
 	}
 
+	unique_ptr<BattleBoard> BoardBuilder::buildValidated(int width, int height, int depth,
+														const vector<BoardPiece>& pieces, const vector<char>& squares)
+	{
+		if ((width <= 0) || (height <= 0) || (depth <= 0) ||
+			(squares.size() != static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(depth)))
+		{
+			return nullptr;
+		}
+
+		// Only BoardBuilder can instantiate this class - so we must create without make_shared macro
+		unique_ptr<BattleBoard> board(new BattleBoard(width, height, depth));
+
+		// Each piece must lie on squares of its own ship, and together the pieces must cover all ship squares
+		vector<bool> isCovered(squares.size(), false);
+		size_t coveredCount = 0;
+
+		for (const auto& piece : pieces)
+		{
+			const ShipType* shipType;
+			switch (piece.ship)
+			{
+			case BoardSquare::RubberBoat: { shipType = &BattleBoard::RUBBER_BOAT; break; }
+			case BoardSquare::RocketShip: { shipType = &BattleBoard::ROCKET_SHIP; break; }
+			case BoardSquare::Submarine: { shipType = &BattleBoard::SUBMARINE; break; }
+			case BoardSquare::Battleship: { shipType = &BattleBoard::BATTLESHIP; break; }
+			default: { return nullptr; }
+			}
+
+			char ship = static_cast<char>(shipType->_representation);
+			char square = (piece.player == PlayerEnum::A) ? ship : static_cast<char>(tolower(ship));
+
+			Coordinate position = piece.firstPos;
+			for (int index = 0; index < shipType->_size; ++index)
+			{
+				bool isInBoard = (position.row >= 0) && (position.row < height) && (position.col >= 0) &&
+								 (position.col < width) && (position.depth >= 0) && (position.depth < depth);
+				if (!isInBoard)
+					return nullptr;
+
+				size_t squareIndex = (static_cast<size_t>(position.depth) * height + position.row) * width + position.col;
+				if (isCovered[squareIndex] || (squares[squareIndex] != square))
+					return nullptr;
+
+				isCovered[squareIndex] = true;
+				coveredCount++;
+
+				position.col += (piece.orientation == Orientation::X_AXIS) ? 1 : 0;
+				position.row += (piece.orientation == Orientation::Y_AXIS) ? 1 : 0;
+				position.depth += (piece.orientation == Orientation::Z_AXIS) ? 1 : 0;
+			}
+
+			board->addGamePiece(piece.firstPos, *shipType, piece.player, piece.orientation);
+		}
+
+		size_t shipSquaresCount = squares.size() - std::count(squares.begin(), squares.end(),
+															  static_cast<char>(BoardSquare::Empty));
+		if (shipSquaresCount != coveredCount)
+			return nullptr;
+
+		return board;
+	}
+
 	shared_ptr<BattleBoard> BoardBuilder::clone(const BattleBoard& prototype)
 	{
 		// Only BoardBuilder can instantiate this class - so we must create without make_shared macro
@@ -1,11 +1,12 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
-#include <tuple>
 #include <vector>
 #include <set>
 #include <map>
-#include <unordered_set>
+#include <unordered_map>
 #include <functional>
 #include "IBattleshipGameAlgo.h"
 #include "BattleBoard.h"
@@ -14,11 +15,11 @@
 using std::shared_ptr;
 using std::string;
 using std::pair;
-using std::tuple;
 using std::vector;
 using std::set;
 using std::map;
-using std::unordered_set;
+using std::unordered_map;
+using std::array;
 using std::function;
 
 namespace battleship
@@ -41,6 +42,34 @@ namespace battleship
 		NO_SHIPS_AT_ALL
 	};
 
+	/** Squares of a whole board laid out densely (layer by layer, row by row), ' ' for empty squares */
+	struct BoardGrid
+	{
+		BoardGrid(int rows, int cols, int depth) :
+			rows(rows), cols(cols), depth(depth),
+			squares(static_cast<size_t>(rows) * cols * depth, static_cast<char>(BoardSquare::Empty)) {}
+
+		int rows;
+		int cols;
+		int depth;
+		vector<char> squares;
+
+		/** Returns the first square of a row (0 based indices) */
+		char* row(int rowIndex, int depthIndex)
+		{
+			return squares.data() + (static_cast<size_t>(depthIndex) * rows + rowIndex) * cols;
+		}
+	};
+
+	/** A ship of a board that was already validated, as kept by precompiled (binary) boards */
+	struct BoardPiece
+	{
+		Coordinate firstPos;	// Lowest coordinate of the ship in all dimensions (0 based)
+		BoardSquare ship;
+		PlayerEnum player;
+		Orientation orientation;
+	};
+
 	/** A Builder pattern class, for creating instances of the BattleBoard class.
 	 *  BoardBuilder is the only class expected to create BattleBoards, and is responsible for vailidating
 	 *	the board before the beginning of a game session.
@@ -48,6 +77,12 @@ namespace battleship
 	class BoardBuilder
 	{
 	public:
+		/** Version of the parsing and validation rules. Must be increased whenever they change the outcome of
+		 *  loading a board file, as it invalidates the validation results cached so far (see BoardValidationCache).
+		 *  1 - Ship masks, 2 - Flood fill (compared with the masks by BoardValidatorTests).
+		 */
+		static constexpr uint32_t VALIDATOR_VERSION = 2;
+
 		/** Creates a new BoardBuilder instance */
 		BoardBuilder(int width, int height, int depth);
 		virtual ~BoardBuilder();
@@ -92,6 +127,11 @@ namespace battleship
 		 */
 		BoardBuilder* addPiece(Coordinate coord, char type);
 
+		/** Defines the values of all non empty squares of the grid at once (square (0, 0, 0) of the grid is at
+		 *  Coordinate(0, 0, 0)). Faster than adding the pieces one by one, expected to be called on an empty builder.
+		 */
+		BoardBuilder* addPieces(const BoardGrid& grid);
+
 		/** Finailize the creation of the BattleBoard.
 		 *	Validation occurs here, and logical game pieces data is initialized for the BattleBoard object.
 		 *	In the end the constructed BattleBoard instance is returned, or NULL if errors have occured in the process.
@@ -99,45 +139,71 @@ namespace battleship
 		 */
 		unique_ptr<BattleBoard> build();
 
+		/** Same as build(), but the validation errors are returned in validationErrors (in descending priority order)
+		 *  instead of printed, so a caller building boards on multiple threads can report them together.
+		 */
+		unique_ptr<BattleBoard> build(vector<string>& validationErrors);
+
+		/** Creates a BattleBoard out of pieces that were validated before (e.g. by build() on an earlier run),
+		 *  without validating the board again. The pieces are only checked against the board's squares (layer by
+		 *  layer, row by row): returns NULL if a piece isn't of a known ship type, exceeds the board or doesn't
+		 *  match its squares, or if a ship square isn't covered by any piece.
+		 */
+		static unique_ptr<BattleBoard> buildValidated(int width, int height, int depth, const vector<BoardPiece>& pieces,
+													  const vector<char>& squares);
+
 		/** Creates a new instance of the battle board out of the given prototype.
 		 *  Boards will be identical in data, but will not share the same game pieces.
 		 */
 		static shared_ptr<BattleBoard> clone(const BattleBoard& prototype);
 
 	private:
-		/** A helper class for validating the legal formation of game-pieces on the board. */
-		class ShipMask
-		{
-		public:
-			BoardSquare maskType;
-
-			/** A map of squares that compose the mask. The coordinate is a relative coordinate. */
-			
-			vector<pair<Coordinate, BoardSquare>> mask;
-			using MaskEntry = pair<Coordinate, BoardSquare>;
-			
-			Orientation orient;
-			bool wrongSize;
-			bool adjacentShips;
+		// Number of ship types, and the index of each type in ShipsCount
+		static constexpr size_t SHIP_TYPES_COUNT = 4;
 
-			/** Constructs a new mask according to ship type (which is represented by the BoardSquare in this case) */
-			ShipMask(BoardSquare ship);
+		/** Number of valid ships a player has of each type */
+		using ShipsCount = array<int, SHIP_TYPES_COUNT>;
 
-			virtual ~ShipMask();
+		/** Squares of the board being validated, with a visited mark for each ship square.
+		 *  Squares are kept in a dense grid over the bounding box of the ships, unless the ships are spread
+		 *  over a huge (sparse) board, in which case they are kept in a hash map.
+		 */
+		class ValidationGrid
+		{
+		public:
+			/** Takes the squares of boardMap which are within the board's dimensions */
+			ValidationGrid(const map<Coordinate, char>& boardMap, int width, int height, int depth);
 
-			/** Apply ship mask to the board, and return whether the current formation for the (row, col, depth) square
-			 *	is valid.
-			 */
-			bool applyMask(const map<Coordinate, char>& boardMap, tuple<int, int, int> boardSize, Coordinate coord, PlayerEnum player);
+			/** Returns the square at coord, Empty for squares outside the board */
+			char at(const Coordinate& coord) const;
 
-			static void applyMaskEntry(char boardSquare, char shipChar, const MaskEntry& maskEntry, bool axisException,
-									   int& matchSizeAxis, bool& wrongSizeAxis, bool& adjacentShipsAxis);
+			/** Marks a ship square as visited. Returns false if it was visited before or isn't a ship square. */
+			bool visit(const Coordinate& coord);
 
-			/** Clean state and prepare for next comparison */
-			void resetMaskFlags();
+		private:
+			static constexpr size_t MAX_DENSE_SQUARES = 1 << 24;
+			static constexpr char VISITED_FLAG = static_cast<char>(0x80); // Ship characters are all below 0x80
+
+			bool _isDense;
+			Coordinate _origin;	// Lowest corner of the bounding box
+			int _rows;
+			int _cols;
+			int _depth;
+			vector<char> _squares; // Dense grid (layer by layer, row by row)
+			unordered_map<Coordinate, char, CoordinateHash> _sparseSquares;
+
+			/** Returns the stored square at coord, or NULL if coord isn't a ship square */
+			char* find(const Coordinate& coord);
+			const char* find(const Coordinate& coord) const;
+		};
 
-			/** BoardBuilder is the only class which is allowed to instantiate ShipMasks */
-			friend class BoardBuilder;
+		/** A ship as found on the board: connected squares (sharing a face) of the same character */
+		struct ShipComponent
+		{
+			int size;				// Number of squares
+			bool isStraight;		// All squares are along a single axis
+			Orientation orient;		// The axis the squares are along (X_AXIS for a single square)
+			bool isAdjacent;		// A square touches a square of another ship
 		};
 
 		int boardWidth;
@@ -147,18 +213,18 @@ namespace battleship
 		/** The board itself as a map from Coordinate to char */
 		map<Coordinate, char> boardMap;
 
-		/** Mark given squares as already validated */
-		void markVisitedCoords(unordered_set<Coordinate, CoordinateHash>& coordSet, Coordinate coord);
+		/** Finds the ship that firstPos (which is already visited) is the first square of, visiting all its squares */
+		static ShipComponent findShip(ValidationGrid& grid, const Coordinate& firstPos, char square);
 
 		/** Check that players have the same amount and types of ships */
-		static bool isBalancedBoard(vector<BoardSquare>& playerAShips, vector<BoardSquare>& playerBShips);
+		static bool isBalancedBoard(const ShipsCount& playerAShips, const ShipsCount& playerBShips);
 
 		/** Returns true if the BattleBoard contains a legal formation, false if not.
 		 *  This function is used by BoardBuilder::validate()
 		 */
 		bool isValidBoard(BattleBoard* board, set<BoardInitializeError, ErrorPriorityFunction>& errorQueue);
 
-		/** Prints the validation errors in the queue, in descending priority order */
-		static void printErrors(const set<BoardInitializeError, ErrorPriorityFunction>& errorQueue);
+		/** Prints the validation errors, in the order given */
+		static void printErrors(const vector<string>& validationErrors);
 	};
 }
\ No newline at end of file
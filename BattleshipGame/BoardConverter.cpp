@@ -0,0 +1,260 @@
+#include "BoardArchive.h"
+#include "BoardFileParser.h"
+#include "BoardGenerator.h"
+#include "IOUtil.h"
+#include "ResourceManifest.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::ofstream;
+using battleship::ArchivedBoard;
+using battleship::BoardArchive;
+using battleship::BoardFileParser;
+using battleship::BoardGenerator;
+using battleship::GeneratorSettings;
+using battleship::IOUtil;
+using battleship::ResourceManifest;
+
+/** Converter between text boards (.sboard) and board archives (.sboardb).
+ *  Usage: BoardConverter pack <archive.sboardb> <board.sboard | directory>...
+ *         BoardConverter unpack <archive.sboardb> <directory>
+ *         BoardConverter generate <archive.sboardb | directory> <count> <width>x<height>x<depth> <fleet> [seed]
+ *         BoardConverter manifest <directory>
+ *  pack     - Parses and validates the boards (all .sboard files of a directory) and writes the valid ones
+ *             to a single archive. Place it next to the boards, so the game loads them from the archive.
+ *  unpack   - Writes each board of the archive back to a text board in the directory
+ *  generate - Generates random valid boards (fleet is a ship character per ship of each player, e.g. "BPMD")
+ *             into an archive, or as text boards into the directory
+ *  manifest - Lists the boards, board archives and player dlls of a working directory in its resource manifest,
+ *             so the game doesn't enumerate the directory. Run it again whenever these files are added or removed.
+ */
+
+static constexpr int SUCCESS_CODE = 0;
+static constexpr int ERROR_CODE = -1;
+
+// Number of boards generated at once, so generating a huge number of text boards takes bounded memory
+static constexpr size_t GENERATE_BATCH_SIZE = 4096;
+
+static string fileName(const string& path)
+{
+	size_t separator = path.find_last_of("\\/");
+	return (separator == string::npos) ? path : path.substr(separator + 1);
+}
+
+/** Parses, validates and archives a single text board, returns false if it isn't valid */
+static bool packBoard(const string& boardFile, vector<ArchivedBoard>& archivedBoards)
+{
+	BoardFileParser parser(boardFile);
+	if (!parser.isOpen())
+	{
+		cerr << "Error: Failed to open " << boardFile << endl;
+		return false;
+	}
+
+	auto builder = parser.parse();
+	vector<string> warnings;
+	auto board = (builder != nullptr) ? builder->build(warnings) : nullptr;
+
+	for (const auto& warning : warnings)
+		cerr << boardFile << ": " << warning << endl;
+
+	if (board == nullptr)
+	{
+		cerr << "Error: " << boardFile << " is invalid, skipping it" << endl;
+		return false;
+	}
+
+	ArchivedBoard archived;
+	string error;
+	if (!BoardArchive::fromBoard(fileName(boardFile), *board, warnings, parser.contentHash(), archived, error))
+	{
+		cerr << "Error: " << boardFile << " can't be archived: " << error << endl;
+		return false;
+	}
+
+	archivedBoards.push_back(std::move(archived));
+	return true;
+}
+
+static int pack(const string& archiveFile, const vector<string>& inputs)
+{
+	vector<ArchivedBoard> archivedBoards;
+	size_t skippedCount = 0;
+
+	for (const auto& input : inputs)
+	{
+		if (IOUtil::validatePath(input))
+		{
+			for (const auto& boardFilename : IOUtil::listFilesInPath(input, "sboard"))
+				skippedCount += packBoard(input + "\\" + boardFilename, archivedBoards) ? 0 : 1;
+		}
+		else
+		{
+			skippedCount += packBoard(input, archivedBoards) ? 0 : 1;
+		}
+	}
+
+	if (!BoardArchive::write(archiveFile, archivedBoards))
+	{
+		cerr << "Error: Failed to write " << archiveFile << endl;
+		return ERROR_CODE;
+	}
+
+	cout << "Packed " << archivedBoards.size() << " boards into " << archiveFile
+		 << " (" << skippedCount << " skipped)" << endl;
+	return SUCCESS_CODE;
+}
+
+static bool writeTextBoard(const string& directory, const ArchivedBoard& archived)
+{
+	// Names come from the archive, only the file name part of them is used
+	string boardFile = directory + "\\" + fileName(archived.name);
+	ofstream fs(boardFile);
+	fs << BoardArchive::toText(archived);
+
+	if (!fs.good())
+	{
+		cerr << "Error: Failed to write " << boardFile << endl;
+		return false;
+	}
+
+	return true;
+}
+
+static int unpack(const string& archiveFile, const string& directory)
+{
+	vector<ArchivedBoard> archivedBoards;
+	if (!BoardArchive::read(archiveFile, archivedBoards))
+	{
+		cerr << "Error: " << archiveFile << " is missing or isn't a valid board archive" << endl;
+		return ERROR_CODE;
+	}
+
+	for (const auto& archived : archivedBoards)
+	{
+		if (!writeTextBoard(directory, archived))
+			return ERROR_CODE;
+	}
+
+	cout << "Unpacked " << archivedBoards.size() << " boards into " << directory << endl;
+	return SUCCESS_CODE;
+}
+
+static int generate(const string& target, const vector<string>& args)
+{
+	GeneratorSettings settings;
+	bool isValidCount = IOUtil::isInteger(args[0]) && (args[0].size() <= 9) && (std::stoi(args[0]) > 0);
+	bool isValidSeed = (args.size() < 4) || (IOUtil::isInteger(args[3]) && (args[3].size() <= 9));
+
+	if (!isValidCount || !isValidSeed ||
+		!BoardGenerator::parseDimensions(args[1], settings.width, settings.height, settings.depth) ||
+		!BoardGenerator::parseFleet(args[2], settings.fleet))
+	{
+		cerr << "Error: Invalid generate arguments" << endl;
+		return ERROR_CODE;
+	}
+
+	settings.boardsCount = std::stoi(args[0]);
+	settings.seed = (args.size() < 4) ? 0 : static_cast<unsigned int>(std::stoi(args[3]));
+
+	bool isArchive = IOUtil::endsWith(target, "." + BoardArchive::ARCHIVE_SUFFIX);
+	if (!isArchive && !IOUtil::validatePath(target))
+	{
+		cerr << "Error: " << target << " is neither a board archive nor a directory" << endl;
+		return ERROR_CODE;
+	}
+
+	BoardGenerator generator(settings);
+	vector<ArchivedBoard> archivedBoards;
+	size_t generatedCount = 0;
+
+	for (size_t firstIndex = 0; firstIndex < static_cast<size_t>(settings.boardsCount); firstIndex += GENERATE_BATCH_SIZE)
+	{
+		size_t remaining = settings.boardsCount - firstIndex;
+		vector<ArchivedBoard> batch((remaining < GENERATE_BATCH_SIZE) ? remaining : GENERATE_BATCH_SIZE);
+		vector<char> isGenerated(batch.size(), 0);
+
+		auto onBoard = [&batch, &isGenerated](size_t position, ArchivedBoard& board)
+		{
+			batch[position] = std::move(board);
+			isGenerated[position] = 1;
+		};
+
+		size_t batchCount = generator.generateAll(firstIndex, batch.size(), onBoard);
+		generatedCount += batchCount;
+
+		for (size_t position = 0; position < batch.size(); ++position)
+		{
+			if (!isGenerated[position])
+				continue;
+
+			if (isArchive)
+				archivedBoards.push_back(std::move(batch[position]));
+			else if (!writeTextBoard(target, batch[position]))
+				return ERROR_CODE;
+		}
+
+		if (batchCount < batch.size())
+		{
+			cerr << "Error: The fleet doesn't fit boards of " << args[1] << endl;
+			break;
+		}
+	}
+
+	if (isArchive && !BoardArchive::write(target, archivedBoards))
+	{
+		cerr << "Error: Failed to write " << target << endl;
+		return ERROR_CODE;
+	}
+
+	cout << "Generated " << generatedCount << " boards into " << target << endl;
+	return (generatedCount == static_cast<size_t>(settings.boardsCount)) ? SUCCESS_CODE : ERROR_CODE;
+}
+
+static int manifest(const string& directory)
+{
+	if (!IOUtil::validatePath(directory))
+	{
+		cerr << "Error: " << directory << " is not a directory" << endl;
+		return ERROR_CODE;
+	}
+
+	size_t entriesCount = 0;
+	if (!ResourceManifest::write(directory, entriesCount))
+	{
+		cerr << "Error: Failed to write the resource manifest of " << directory << endl;
+		return ERROR_CODE;
+	}
+
+	cout << "Listed " << entriesCount << " resource files in " << directory << "\\" << ResourceManifest::MANIFEST_FILE
+		 << endl;
+	return SUCCESS_CODE;
+}
+
+int main(int argc, char* argv[])
+{
+	string command = (argc > 1) ? argv[1] : "";
+
+	if ((command == "pack") && (argc >= 4))
+		return pack(argv[2], vector<string>(argv + 3, argv + argc));
+
+	if ((command == "unpack") && (argc == 4))
+		return unpack(argv[2], argv[3]);
+
+	if ((command == "generate") && ((argc == 6) || (argc == 7)))
+		return generate(argv[2], vector<string>(argv + 3, argv + argc));
+
+	if ((command == "manifest") && (argc == 3))
+		return manifest(argv[2]);
+
+	cerr << "Error: Try: BoardConverter pack <archive.sboardb> <board.sboard | directory>..." << endl;
+	cerr << "        or: BoardConverter unpack <archive.sboardb> <directory>" << endl;
+	cerr << "        or: BoardConverter generate <archive.sboardb | directory> <count> <width>x<height>x<depth> "
+		 << "<fleet> [seed]" << endl;
+	cerr << "        or: BoardConverter manifest <directory>" << endl;
+	return ERROR_CODE;
+}
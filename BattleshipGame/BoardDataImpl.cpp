@@ -22,8 +22,9 @@ namespace battleship
 		c.row -= 1;
 		c.col -= 1;
 		c.depth -= 1;
-		auto gamePiece = _board->pieceAt(c);
-		
+		// Algorithms scan the whole board through charAt, so squares are looked up without taking a reference
+		const GamePiece* gamePiece = _board->findPiece(c);
+
 		if (gamePiece == nullptr)
 		{
 			return static_cast<char>(BoardSquare::Empty); // Empty square
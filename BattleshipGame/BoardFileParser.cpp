@@ -0,0 +1,225 @@
+#include "BoardFileParser.h"
+#include "IOUtil.h"
+#include <climits>
+#include <cstring>
+
+namespace battleship
+{
+	/** Maps every character to the square it stands for: ship characters (of both players) to themselves,
+	 *  anything else to an empty square
+	 */
+	struct SquareTable
+	{
+		char squares[256];
+
+		SquareTable()
+		{
+			for (int c = 0; c < 256; ++c)
+				squares[c] = static_cast<char>(BoardSquare::Empty);
+
+			for (auto ship : { BoardSquare::RubberBoat, BoardSquare::RocketShip, BoardSquare::Submarine, BoardSquare::Battleship })
+			{
+				char shipChar = static_cast<char>(ship);
+				squares[static_cast<unsigned char>(toupper(shipChar))] = static_cast<char>(toupper(shipChar));
+				squares[static_cast<unsigned char>(tolower(shipChar))] = static_cast<char>(tolower(shipChar));
+			}
+		}
+	};
+
+	static const SquareTable SQUARE_TABLE;
+
+	static constexpr char END_OF_FILE_CHAR = 0x1A; // Ctrl+Z
+
+	BoardFileParser::BoardFileParser(const string& path) :
+		_fileHandle(INVALID_HANDLE_VALUE),
+		_mappingHandle(nullptr),
+		_data(nullptr),
+		_size(0)
+	{
+		_fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+								  FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (_fileHandle == INVALID_HANDLE_VALUE)
+			return;
+
+		// Empty files can't be mapped, they are parsed as having no lines
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(_fileHandle, &size) || (size.QuadPart == 0))
+			return;
+
+		_mappingHandle = CreateFileMappingA(_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (_mappingHandle == nullptr)
+			return;
+
+		_data = static_cast<const char*>(MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+		if (_data == nullptr)
+			return;
+
+		_size = static_cast<size_t>(size.QuadPart);
+
+		// Text mode reads stop at Ctrl+Z
+		const void* endOfFile = memchr(_data, END_OF_FILE_CHAR, _size);
+		if (endOfFile != nullptr)
+			_size = static_cast<size_t>(static_cast<const char*>(endOfFile) - _data);
+	}
+
+	BoardFileParser::~BoardFileParser()
+	{
+		if (_data != nullptr)
+			UnmapViewOfFile(_data);
+		if (_mappingHandle != nullptr)
+			CloseHandle(_mappingHandle);
+		if (_fileHandle != INVALID_HANDLE_VALUE)
+			CloseHandle(_fileHandle);
+	}
+
+	bool BoardFileParser::isOpen() const
+	{
+		return (_fileHandle != INVALID_HANDLE_VALUE);
+	}
+
+	uint64_t BoardFileParser::contentHash() const
+	{
+		return IOUtil::hashBytes(_data, _size);
+	}
+
+	bool BoardFileParser::nextLine(const char*& position, const char* end, LineSpan& line)
+	{
+		if (position >= end)
+			return false;
+
+		const char* newline = static_cast<const char*>(memchr(position, '\n', static_cast<size_t>(end - position)));
+		const char* lineEnd = (newline != nullptr) ? newline : end;
+
+		line.text = position;
+		line.length = static_cast<size_t>(lineEnd - position);
+
+		// A text mode read turns \r\n into \n, and the line parser drops one more trailing \r
+		if ((newline != nullptr) && (line.length > 0) && (line.text[line.length - 1] == '\r'))
+			line.length--;
+		if ((line.length > 0) && (line.text[line.length - 1] == '\r'))
+			line.length--;
+
+		position = (newline != nullptr) ? (newline + 1) : end;
+		return true;
+	}
+
+	bool BoardFileParser::parseHeader(const LineSpan& line, int& cols, int& rows, int& depth)
+	{
+		int dimensions[3];
+		size_t dimensionsCount = 0;
+		const char* lineEnd = line.text + line.length;
+		const char* token = line.text;
+
+		for (const char* c = line.text; ; ++c)
+		{
+			bool isTokenEnd = (c == lineEnd) || (*c == 'x') || (*c == 'X');
+			if (!isTokenEnd)
+				continue;
+
+			// Each dimension is a non empty, unsigned decimal number
+			if ((dimensionsCount == 3) || (token == c))
+				return false;
+
+			int64_t value = 0;
+			for (const char* digit = token; digit < c; ++digit)
+			{
+				if ((*digit < '0') || (*digit > '9'))
+					return false;
+
+				value = value * 10 + (*digit - '0');
+				if (value > INT_MAX)
+					return false;
+			}
+
+			dimensions[dimensionsCount++] = static_cast<int>(value);
+			if (c == lineEnd)
+				break;
+
+			token = c + 1;
+		}
+
+		if (dimensionsCount != 3)
+			return false;
+
+		cols = dimensions[0];
+		rows = dimensions[1];
+		depth = dimensions[2];
+		return true;
+	}
+
+	unique_ptr<BoardBuilder> BoardFileParser::parse() const
+	{
+		const char* position = _data;
+		const char* end = _data + _size;
+		LineSpan line;
+
+		// Header: [cols]x[rows]x[depth] line, followed by an empty line
+		int cols = 0;
+		int rows = 0;
+		int depth = 0;
+
+		if (!nextLine(position, end, line) || !parseHeader(line, cols, rows, depth))
+			return nullptr;
+
+		if (nextLine(position, end, line) && (line.length > 0))
+			return nullptr;
+
+		auto builder = std::make_unique<BoardBuilder>(cols, rows, depth);
+
+		// Find the rows that are read, and the extent of the grid they fill
+		size_t rowLength = (cols > 0) ? static_cast<size_t>(cols) : 1;
+		vector<RowSpan> rowSpans;
+		int rowCounter = 0;
+		int depthCounter = 0;
+		int gridRows = 0;
+		int gridDepth = 0;
+		size_t gridCols = 0;
+
+		while ((depthCounter < depth) && nextLine(position, end, line))
+		{
+			if (line.length == 0)
+			{
+				rowCounter = 0; // Empty line - end of level data
+				depthCounter++;
+			}
+			else if (rowCounter <= rows)
+			{
+				line.length = (line.length < rowLength) ? line.length : rowLength;
+				rowSpans.push_back(RowSpan{ line, rowCounter, depthCounter });
+
+				gridRows = (rowCounter + 1 > gridRows) ? (rowCounter + 1) : gridRows;
+				gridCols = (line.length > gridCols) ? line.length : gridCols;
+				gridDepth = depthCounter + 1;
+				rowCounter++;
+			}
+		}
+
+		size_t gridSquares = static_cast<size_t>(gridRows) * gridCols * static_cast<size_t>(gridDepth);
+		if (gridSquares > MAX_GRID_SQUARES)
+		{
+			// Declared dimensions of a sparse board are huge, only its pieces are kept
+			for (const auto& rowSpan : rowSpans)
+			{
+				for (size_t col = 0; col < rowSpan.line.length; ++col)
+				{
+					char square = SQUARE_TABLE.squares[static_cast<unsigned char>(rowSpan.line.text[col])];
+					if (square != static_cast<char>(BoardSquare::Empty))
+						builder->addPiece(Coordinate(rowSpan.row, static_cast<int>(col), rowSpan.depth), square);
+				}
+			}
+
+			return builder;
+		}
+
+		BoardGrid grid(gridRows, static_cast<int>(gridCols), gridDepth);
+		for (const auto& rowSpan : rowSpans)
+		{
+			char* squares = grid.row(rowSpan.row, rowSpan.depth);
+			for (size_t col = 0; col < rowSpan.line.length; ++col)
+				squares[col] = SQUARE_TABLE.squares[static_cast<unsigned char>(rowSpan.line.text[col])];
+		}
+
+		builder->addPieces(grid);
+		return builder;
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <windows.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "BoardBuilder.h"
+
+using std::string;
+using std::vector;
+using std::unique_ptr;
+
+namespace battleship
+{
+	/** Parses a board file (.sboard) straight from a read only mapping of the file.
+	 *  Lines are walked in place (no per line strings), squares are sanitized by a lookup table and written
+	 *  into a dense BoardGrid which is handed to a BoardBuilder at once.
+	 *
+	 *  The result is the same as parsing the file line by line as text:
+	 *  - The header is "[cols]x[rows]x[depth]" (case insensitive), followed by an empty line
+	 *  - Each layer is a list of rows followed by an empty line, rows past [rows] + 1 in a layer and layers past
+	 *    [depth] are ignored, characters past [cols] in a row are ignored (the first one is always read)
+	 *  - Characters which aren't ship characters are empty squares
+	 *  - \r\n and \n line endings are accepted, and Ctrl+Z ends the file (as in text mode reads)
+	 */
+	class BoardFileParser
+	{
+	public:
+		/** Maps the file (check isOpen) */
+		explicit BoardFileParser(const string& path);
+		virtual ~BoardFileParser();
+
+		BoardFileParser(BoardFileParser const&) = delete;
+		void operator=(BoardFileParser const&) = delete;
+
+		/** Returns false if the file couldn't be opened */
+		bool isOpen() const;
+
+		/** Parses the file and returns a builder holding all of its pieces, ready to be built.
+		 *  Returns NULL if the file is empty or its header is invalid.
+		 */
+		unique_ptr<BoardBuilder> parse() const;
+
+		/** Returns the hash of the file's content (as parsed, up to a Ctrl+Z) */
+		uint64_t contentHash() const;
+
+	private:
+		// Grids larger than this are never allocated, the pieces of such (sparse) boards are added one by one
+		static constexpr size_t MAX_GRID_SQUARES = 1 << 24;
+
+		/** Characters of a line in the mapped file */
+		struct LineSpan
+		{
+			const char* text;
+			size_t length;
+		};
+
+		/** A row of squares to copy into the grid */
+		struct RowSpan
+		{
+			LineSpan line;	// Already cut to the columns that are read
+			int row;
+			int depth;
+		};
+
+		HANDLE _fileHandle;
+		HANDLE _mappingHandle;
+		const char* _data;
+		size_t _size;
+
+		/** Moves to the next line of [position, end), returns false if there are no more lines */
+		static bool nextLine(const char*& position, const char* end, LineSpan& line);
+
+		/** Parses the [cols]x[rows]x[depth] header, returns false if it's invalid */
+		static bool parseHeader(const LineSpan& line, int& cols, int& rows, int& depth);
+	};
+}
@@ -0,0 +1,373 @@
+#include "Tests.h"
+#include "BattleBoard.h"
+#include "BoardBuilder.h"
+#include "BoardFileParser.h"
+#include "IOUtil.h"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <tuple>
+
+using std::cout;
+using std::endl;
+using std::transform;
+using std::tuple;
+
+namespace battleship
+{
+	namespace
+	{
+		/** The line based parser BattleshipGameBoardFactory used before BoardFileParser, kept as the reference the
+		 *  new parser is compared with. Lines are read as text by IOUtil::parseFile.
+		 */
+		class LineParser
+		{
+		public:
+			/** Returns a builder holding the pieces of the file, or NULL if the file is invalid */
+			static unique_ptr<BoardBuilder> parse(const string& boardFile);
+
+		private:
+			static bool parseHeader(string& nextLine, int& rows, int& cols, int& depth);
+			static void parseBoardRow(BoardBuilder& builder, string& nextLine, int depthIndex, int rowIndex, int cols);
+		};
+
+		bool LineParser::parseHeader(string& nextLine, int& rows, int& cols, int& depth)
+		{
+			bool isValidFile = true;
+
+			transform(nextLine.begin(), nextLine.end(), nextLine.begin(), ::tolower);
+			string delimiter = "x"; // Separates dimensions
+
+			int dimensionIndex = 0;
+			size_t pos;
+			while ((pos = nextLine.find(delimiter)) != std::string::npos)
+			{
+				string token = nextLine.substr(0, pos);
+				nextLine.erase(0, pos + delimiter.length());
+
+				// Parse each dimension
+				if (IOUtil::isInteger(token))
+				{
+					int dimensionVal = stoi(token);
+
+					switch (dimensionIndex)
+					{
+					case (0) : { cols = dimensionVal; break; }
+					case (1) : { rows = dimensionVal; break; }
+					case (2) : { depth = dimensionVal; break; }
+					default: { break; }
+					}
+
+					dimensionIndex++;
+				}
+				else
+				{
+					isValidFile = false;
+					break;
+				}
+			}
+
+			// Parse the rest of the line (last dimension)
+			if (IOUtil::isInteger(nextLine))
+			{
+				depth = stoi(nextLine);
+				dimensionIndex++;
+			}
+			else
+			{
+				isValidFile = false;
+			}
+
+			isValidFile = isValidFile && (dimensionIndex == 3);
+
+			return isValidFile;
+		}
+
+		void LineParser::parseBoardRow(BoardBuilder& builder, string& nextLine, int depthIndex, int rowIndex, int cols)
+		{
+			int colCounter = 0;
+
+			auto legalChars =
+			{
+				static_cast<char>(toupper(static_cast<char>(BoardSquare::Empty))),
+				static_cast<char>(toupper(static_cast<char>(BoardSquare::RubberBoat))),
+				static_cast<char>(toupper(static_cast<char>(BoardSquare::RocketShip))),
+				static_cast<char>(toupper(static_cast<char>(BoardSquare::Submarine))),
+				static_cast<char>(toupper(static_cast<char>(BoardSquare::Battleship))),
+				static_cast<char>(tolower(static_cast<char>(BoardSquare::RubberBoat))),
+				static_cast<char>(tolower(static_cast<char>(BoardSquare::RocketShip))),
+				static_cast<char>(tolower(static_cast<char>(BoardSquare::Submarine))),
+				static_cast<char>(tolower(static_cast<char>(BoardSquare::Battleship)))
+			};
+			IOUtil::replaceIllegalCharacters(nextLine, static_cast<char>(BoardSquare::Empty), legalChars);
+
+			// Traverse each character in the row and put into the board
+			for (char& nextChar : nextLine)
+			{
+				// Add to board only squares with real game pieces
+				if (!(nextChar == static_cast<char>(BoardSquare::Empty)))
+					builder.addPiece(Coordinate(rowIndex, colCounter, depthIndex), nextChar);
+
+				colCounter++;
+
+				// Read at most "width" amount of cols characters from each line, skip the rest
+				if (colCounter >= cols)
+					break;
+			}
+		}
+
+		unique_ptr<BoardBuilder> LineParser::parse(const string& boardFile)
+		{
+			unique_ptr<BoardBuilder> builder;
+
+			//Board dimensions
+			int cols = 0;
+			int rows = 0;
+			int depth = 0;
+
+			// Current position on board file
+			int rowCounter = 0;
+			int depthCounter = 0;
+
+			auto headerParser = [&builder, &rows, &cols, &depth](string& nextLine, int lineNum,
+																 bool& isHeader, bool& isValidFile)
+			{
+				if (lineNum == 1)
+				{
+					// Parse [cols]x[rows]x[depth] header
+					isValidFile = parseHeader(nextLine, rows, cols, depth);
+					builder = std::make_unique<BoardBuilder>(cols, rows, depth);
+				}
+				else if (lineNum == 2)
+				{
+					// Parse empty line - end of header
+					isValidFile = nextLine.empty();
+					isHeader = false; // End of header (2 lines only)
+				}
+			};
+
+			auto lineParser = [&builder, &cols, &rows, &depth, &rowCounter, &depthCounter](string& nextLine)
+			{
+				if (depthCounter >= depth)
+				{
+					return; // Read the first "depth" amount of levels, ignore the rest
+				}
+				else if (nextLine.empty())
+				{
+					rowCounter = 0; // Empty line - end of level data
+					depthCounter++;
+				}
+				else if (rowCounter > rows)
+				{
+					return; // Read the first "height" amount of rows in each level, ignore the rest
+				}
+				else
+				{	// Line with game pieces data - parse it
+					parseBoardRow(*builder, nextLine, depthCounter, rowCounter, cols);
+					rowCounter++;
+				}
+			};
+
+			bool isValidFile = IOUtil::parseFile(boardFile, lineParser, headerParser);
+
+			// The old parser dereferenced the missing builder of an empty file, both parsers now reject it
+			if (!isValidFile || (builder == nullptr))
+				return nullptr;
+
+			return builder;
+		}
+
+		/** Outcome of building the board a parser read */
+		struct ParsedBoard
+		{
+			bool isParsed;
+			bool isValid;
+			vector<string> errors;
+			vector<tuple<Coordinate, char, int, int>> pieces; // First position, ship, player, orientation
+		};
+
+		ParsedBoard buildParsed(unique_ptr<BoardBuilder> builder)
+		{
+			ParsedBoard parsed{ builder != nullptr, false, {}, {} };
+			if (!parsed.isParsed)
+				return parsed;
+
+			auto board = builder->build(parsed.errors);
+			parsed.isValid = (board != nullptr);
+
+			if (parsed.isValid)
+			{
+				for (const auto& piece : board->gamePiecesList())
+				{
+					parsed.pieces.emplace_back(piece->_firstPos, static_cast<char>(piece->_shipType->_representation),
+											   static_cast<int>(piece->_player), static_cast<int>(piece->_orient));
+				}
+			}
+
+			std::sort(parsed.pieces.begin(), parsed.pieces.end());
+			return parsed;
+		}
+
+		/** Returns a random header line, mostly a valid one of small dimensions */
+		string randomHeader(std::mt19937& random, int& cols, int& rows, int& depth)
+		{
+			static const vector<string> INVALID_HEADERS = { "", "3x3", "3x3x3x3", "3xx3", "x3x3", "3x3x", "3 x3x3",
+															" 3x3x3", "3x3x3 ", "-3x3x3", "+3x3x3", "3x3y3", "axbxc",
+															"3*3*3", "3x3x3\t", "03x3x3" };
+			auto uniform = [&random](int min, int max) { return std::uniform_int_distribution<int>(min, max)(random); };
+
+			cols = uniform(0, 6);
+			rows = uniform(0, 6);
+			depth = uniform(0, 6);
+
+			int kind = uniform(0, 19);
+			if (kind == 0)
+				return INVALID_HEADERS[uniform(0, static_cast<int>(INVALID_HEADERS.size()) - 1)];
+
+			// Huge declared dimensions (of a sparse board) are as valid as small ones
+			if (kind == 1)
+				cols = 2147483647;
+
+			return std::to_string(cols) + ((uniform(0, 1) == 0) ? "x" : "X") + std::to_string(rows) +
+				   ((uniform(0, 1) == 0) ? "x" : "X") + std::to_string(depth);
+		}
+
+		/** Returns the text of a random board file. The squares are of straight ships of random types, players and
+		 *  axes (often touching or of the wrong length) and some noise. Rows, layers and characters past the
+		 *  declared dimensions are added at random, as are \r\n line endings and a missing last newline.
+		 *  Lines never end with a lone \r and there's no Ctrl+Z, which only text mode reads on Windows handle.
+		 */
+		string randomBoardFile(std::mt19937& random)
+		{
+			static const char SHIPS[] = { 'B', 'P', 'M', 'D' };
+			static const char NOISE[] = { ' ', 'x', 'X', '0', '1', '.', '\t', '-', 'a', 'z', '#', '\x7F', '\x80', '\xFF' };
+			auto uniform = [&random](int min, int max) { return std::uniform_int_distribution<int>(min, max)(random); };
+
+			int cols, rows, depth;
+			string header = randomHeader(random, cols, rows, depth);
+
+			// Content of up to one more row, column and layer than declared
+			int contentCols = std::min(cols, 6) + uniform(0, 1);
+			int contentRows = rows + uniform(0, 1);
+			int contentDepth = depth + uniform(0, 1);
+			vector<string> grid(static_cast<size_t>(contentRows * contentDepth), string(contentCols, ' '));
+
+			int shipsCount = uniform(0, (contentCols * contentRows * contentDepth) / 5 + 1);
+			for (int ship = 0; ship < shipsCount; ++ship)
+			{
+				int type = uniform(0, 3);
+				char shipChar = (uniform(0, 1) == 0) ? SHIPS[type] : static_cast<char>(tolower(SHIPS[type]));
+				int length = type + 1 + ((uniform(0, 4) == 0) ? uniform(-1, 1) : 0);
+				int axis = uniform(0, 2);
+				int row = uniform(0, std::max(contentRows - 1, 0));
+				int col = uniform(0, std::max(contentCols - 1, 0));
+				int layer = uniform(0, std::max(contentDepth - 1, 0));
+
+				for (int square = 0; square < length; ++square)
+				{
+					int squareRow = row + ((axis == 0) ? square : 0);
+					int squareCol = col + ((axis == 1) ? square : 0);
+					int squareLayer = layer + ((axis == 2) ? square : 0);
+					if ((squareRow < contentRows) && (squareCol < contentCols) && (squareLayer < contentDepth))
+						grid[squareLayer * contentRows + squareRow][squareCol] = shipChar;
+				}
+			}
+
+			for (auto& line : grid)
+			{
+				for (auto& square : line)
+				{
+					if (uniform(0, 29) == 0)
+						square = NOISE[uniform(0, sizeof(NOISE) - 1)];
+				}
+
+				// Trailing spaces are sometimes trimmed, an all empty row is then an empty line (ending its layer)
+				if (uniform(0, 3) == 0)
+					line.erase(line.find_last_not_of(' ') + 1);
+			}
+
+			string newline = (uniform(0, 4) == 0) ? "\r\n" : "\n";
+			string file = header + newline;
+			if (uniform(0, 19) != 0)
+				file += (uniform(0, 19) == 0) ? ("junk" + newline) : newline;
+
+			for (int layer = 0; layer < contentDepth; ++layer)
+			{
+				for (int row = 0; row < contentRows; ++row)
+					file += grid[layer * contentRows + row] + newline;
+
+				file += newline;
+			}
+
+			if ((uniform(0, 4) == 0) && !file.empty())
+				file.erase(file.size() - newline.size());
+
+			return file;
+		}
+
+		/** Writes the file and parses it with both parsers */
+		void parseBoth(const string& path, const string& content, ParsedBoard& byLines, ParsedBoard& byMapping)
+		{
+			TestRunner::writeBytes(path, vector<char>(content.begin(), content.end()));
+			byLines = buildParsed(LineParser::parse(path));
+
+			BoardFileParser parser(path);
+			TEST_CHECK(parser.isOpen());
+			byMapping = buildParsed(parser.parse());
+		}
+	}
+
+	void boardFileParserTests(unsigned int seed)
+	{
+		static constexpr int RANDOM_FILES_COUNT = 20000;
+
+		std::mt19937 random(seed);
+		string path = TestRunner::scratchPath("board.sboard");
+		int validCount = 0;
+
+		for (int fileIndex = 0; fileIndex < RANDOM_FILES_COUNT; ++fileIndex)
+		{
+			string content = randomBoardFile(random);
+			ParsedBoard byLines, byMapping;
+			parseBoth(path, content, byLines, byMapping);
+
+			// Both parsers accept the same files, which build the same boards with the same errors and warnings
+			bool isEqual = (byLines.isParsed == byMapping.isParsed) && (byLines.isValid == byMapping.isValid) &&
+						   (byLines.errors == byMapping.errors) && (byLines.pieces == byMapping.pieces);
+			TestRunner::check(isEqual, "Parsers differ on board file:\n" + content);
+			validCount += byMapping.isValid ? 1 : 0;
+		}
+
+		cout << "parser: " << validCount << " of " << RANDOM_FILES_COUNT << " random board files are valid" << endl;
+
+		// Intended deviation: an empty file used to crash the old parser (its builder was never created)
+		{
+			ParsedBoard byLines, byMapping;
+			parseBoth(path, "", byLines, byMapping);
+			TEST_CHECK(!byMapping.isParsed);
+		}
+
+		// Intended deviation: a dimension past the range of int used to throw out of the old parser, it's rejected
+		{
+			string content = "9999999999x1x1\n\nB\n";
+			TestRunner::writeBytes(path, vector<char>(content.begin(), content.end()));
+			BoardFileParser parser(path);
+			TEST_CHECK(parser.isOpen() && (parser.parse() == nullptr));
+		}
+
+		// A Ctrl+Z ends the file as a text mode read on Windows does (the old parser's reads elsewhere don't stop)
+		{
+			string content = "3x1x1\r\n\r\nB\x1A" "b\r\n\r\n";
+			TestRunner::writeBytes(path, vector<char>(content.begin(), content.end()));
+			ParsedBoard byMapping = buildParsed(BoardFileParser(path).parse());
+
+			string textContent = "3x1x1\n\nB";
+			TestRunner::writeBytes(path, vector<char>(textContent.begin(), textContent.end()));
+			ParsedBoard byLines = buildParsed(LineParser::parse(path));
+
+			TEST_CHECK(byMapping.isParsed && byLines.isParsed);
+			TEST_CHECK((byMapping.isValid == byLines.isValid) && (byMapping.errors == byLines.errors) &&
+					   (byMapping.pieces == byLines.pieces));
+		}
+	}
+}
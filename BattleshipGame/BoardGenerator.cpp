@@ -0,0 +1,242 @@
+#include "BoardGenerator.h"
+#include "IOUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using std::atomic;
+using std::thread;
+
+namespace battleship
+{
+	// Ships in the order of GeneratorSettings::fleet
+	static const BoardSquare FLEET_SHIPS[] = { BoardSquare::RubberBoat, BoardSquare::RocketShip,
+											   BoardSquare::Submarine, BoardSquare::Battleship };
+
+	/** Returns the next number of a splitmix64 sequence. Cheap to seed, so every board gets its own sequence. */
+	static uint64_t nextRandom(uint64_t& state)
+	{
+		uint64_t value = (state += 0x9E3779B97F4A7C15ULL);
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+		return value ^ (value >> 31);
+	}
+
+	BoardGenerator::BoardGenerator(const GeneratorSettings& settings) : _settings(settings)
+	{
+		// Large ships are placed first, while the board is still empty enough to fit them.
+		// Players alternate, so neither player's ships are left with the most crowded board.
+		for (size_t typeIndex = _settings.fleet.size(); typeIndex-- > 0;)
+		{
+			for (int shipIndex = 0; shipIndex < _settings.fleet[typeIndex]; ++shipIndex)
+			{
+				BoardSquare ship = FLEET_SHIPS[typeIndex];
+				_ships.push_back(BoardPiece{ Coordinate(0, 0, 0), ship, PlayerEnum::A, Orientation::X_AXIS });
+				_ships.push_back(BoardPiece{ Coordinate(0, 0, 0), ship, PlayerEnum::B, Orientation::X_AXIS });
+			}
+		}
+	}
+
+	bool BoardGenerator::placeShips(uint64_t& randomState, ArchivedBoard& board) const
+	{
+		const int width = board.width;
+		const int height = board.height;
+		const int depth = board.depth;
+		const size_t layerSize = static_cast<size_t>(width) * height;
+
+		for (const auto& ship : _ships)
+		{
+			const int size = BattleBoard::shipTypeOf(ship.ship)->_size;
+			const char square = (ship.player == PlayerEnum::A) ? static_cast<char>(ship.ship) :
+																 static_cast<char>(tolower(static_cast<char>(ship.ship)));
+			bool isPlaced = false;
+
+			for (int attempt = 0; (attempt < PLACEMENT_ATTEMPTS) && !isPlaced; ++attempt)
+			{
+				Orientation orient = (size == 1) ? Orientation::X_AXIS :
+												   static_cast<Orientation>(nextRandom(randomState) % 3);
+				int deltaCol = (orient == Orientation::X_AXIS) ? 1 : 0;
+				int deltaRow = (orient == Orientation::Y_AXIS) ? 1 : 0;
+				int deltaDepth = (orient == Orientation::Z_AXIS) ? 1 : 0;
+
+				// Number of first positions along each axis that fit the whole ship
+				int colsRange = width - (size - 1) * deltaCol;
+				int rowsRange = height - (size - 1) * deltaRow;
+				int depthRange = depth - (size - 1) * deltaDepth;
+				if ((colsRange <= 0) || (rowsRange <= 0) || (depthRange <= 0))
+					continue;
+
+				Coordinate firstPos(static_cast<int>(nextRandom(randomState) % rowsRange),
+									static_cast<int>(nextRandom(randomState) % colsRange),
+									static_cast<int>(nextRandom(randomState) % depthRange));
+
+				size_t firstIndex = firstPos.depth * layerSize + static_cast<size_t>(firstPos.row) * width + firstPos.col;
+				size_t stride = deltaCol + deltaRow * static_cast<size_t>(width) + deltaDepth * layerSize;
+
+				bool isFree = true;
+				for (int index = 0; (index < size) && isFree; ++index)
+					isFree = (board.squares[firstIndex + index * stride] == static_cast<char>(BoardSquare::Empty));
+
+				if (!isFree)
+					continue;
+
+				// Block the empty squares around the ship, so no other ship is placed next to it
+				for (int index = 0; index < size; ++index)
+				{
+					int row = firstPos.row + index * deltaRow;
+					int col = firstPos.col + index * deltaCol;
+					int layer = firstPos.depth + index * deltaDepth;
+					size_t squareIndex = firstIndex + index * stride;
+					board.squares[squareIndex] = square;
+
+					const pair<bool, size_t> neighbours[] = {
+						{ col > 0, squareIndex - 1 }, { col < width - 1, squareIndex + 1 },
+						{ row > 0, squareIndex - width }, { row < height - 1, squareIndex + width },
+						{ layer > 0, squareIndex - layerSize }, { layer < depth - 1, squareIndex + layerSize } };
+
+					for (const auto& neighbour : neighbours)
+					{
+						if (neighbour.first && (board.squares[neighbour.second] == static_cast<char>(BoardSquare::Empty)))
+							board.squares[neighbour.second] = BLOCKED_SQUARE;
+					}
+				}
+
+				board.pieces.push_back(BoardPiece{ firstPos, ship.ship, ship.player, orient });
+				isPlaced = true;
+			}
+
+			if (!isPlaced)
+				return false;
+		}
+
+		return true;
+	}
+
+	bool BoardGenerator::generate(uint64_t boardIndex, ArchivedBoard& board) const
+	{
+		uint64_t squaresCount = static_cast<uint64_t>(_settings.width) * _settings.height * _settings.depth;
+		if ((_settings.width <= 0) || (_settings.height <= 0) || (_settings.depth <= 0) ||
+			(squaresCount > BoardArchive::MAX_SQUARES) || _ships.empty())
+		{
+			return false;
+		}
+
+		board.name = boardName(boardIndex);
+		board.width = _settings.width;
+		board.height = _settings.height;
+		board.depth = _settings.depth;
+		board.warnings.clear();
+
+		// Each board draws from its own sequence, seeded by the generator's seed and the board's index
+		uint64_t seedState = (static_cast<uint64_t>(_settings.seed) << 32) ^ boardIndex;
+		uint64_t randomState = nextRandom(seedState);
+
+		for (int attempt = 0; attempt < BOARD_ATTEMPTS; ++attempt)
+		{
+			board.squares.assign(static_cast<size_t>(squaresCount), static_cast<char>(BoardSquare::Empty));
+			board.pieces.clear();
+
+			if (placeShips(randomState, board))
+			{
+				std::replace(board.squares.begin(), board.squares.end(), BLOCKED_SQUARE,
+							 static_cast<char>(BoardSquare::Empty));
+
+				// Same order as the pieces of validated boards
+				std::sort(board.pieces.begin(), board.pieces.end(),
+						  [](const BoardPiece& first, const BoardPiece& second) { return first.firstPos < second.firstPos; });
+
+				board.contentHash = BoardArchive::contentHash(board);
+				board.sourceHash = 0;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	size_t BoardGenerator::generateAll(uint64_t firstIndex, size_t count,
+									   const function<void(size_t position, ArchivedBoard& board)>& onBoard) const
+	{
+		atomic<size_t> nextPosition(0);
+		atomic<size_t> generatedCount(0);
+		atomic<size_t> failedCount(0);
+
+		auto generateBoards = [this, firstIndex, count, &onBoard, &nextPosition, &generatedCount, &failedCount]()
+		{
+			ArchivedBoard board; // Buffers are reused between the boards of a thread
+			size_t position;
+			while (((position = nextPosition++) < count) && (failedCount < FAILURES_LIMIT))
+			{
+				if (generate(firstIndex + position, board))
+				{
+					onBoard(position, board);
+					generatedCount++;
+				}
+				else
+				{
+					failedCount++;
+				}
+			}
+		};
+
+		size_t threadsCount = thread::hardware_concurrency();
+		threadsCount = (threadsCount < count) ? threadsCount : count;
+
+		// The calling thread generates boards as well
+		vector<thread> generatorThreads;
+		for (size_t i = 1; i < threadsCount; ++i)
+			generatorThreads.emplace_back(generateBoards);
+
+		generateBoards();
+
+		for (auto& generator : generatorThreads)
+			generator.join();
+
+		return generatedCount;
+	}
+
+	string BoardGenerator::boardName(uint64_t boardIndex) const
+	{
+		return BOARD_NAME_PREFIX + std::to_string(_settings.seed) + "_" + std::to_string(boardIndex) + ".sboard";
+	}
+
+	bool BoardGenerator::parseDimensions(const string& value, int& width, int& height, int& depth)
+	{
+		int* dimensions[] = { &width, &height, &depth };
+		size_t start = 0;
+
+		for (size_t dimension = 0; dimension < 3; ++dimension)
+		{
+			size_t end = (dimension < 2) ? value.find('x', start) : value.size();
+			if (end == string::npos)
+				return false;
+
+			string field = value.substr(start, end - start);
+			if (!IOUtil::isInteger(field) || (field.size() > 9) || (std::stoi(field) <= 0))
+				return false;
+
+			*dimensions[dimension] = std::stoi(field);
+			start = end + 1;
+		}
+
+		return true;
+	}
+
+	bool BoardGenerator::parseFleet(const string& value, array<int, 4>& fleet)
+	{
+		fleet = {};
+		for (char ship : value)
+		{
+			size_t typeIndex = 0;
+			while ((typeIndex < fleet.size()) && (static_cast<char>(FLEET_SHIPS[typeIndex]) != ship))
+				typeIndex++;
+
+			if (typeIndex == fleet.size())
+				return false;
+
+			fleet[typeIndex]++;
+		}
+
+		return !value.empty();
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "BoardArchive.h"
+
+using std::array;
+using std::function;
+using std::string;
+
+namespace battleship
+{
+	/** Parameters of procedurally generated boards */
+	struct GeneratorSettings
+	{
+		int boardsCount;		// Number of boards to generate, 0 for none
+		int width;
+		int height;
+		int depth;
+		array<int, 4> fleet;	// Number of ships of each player by type: rubber boats, rocket ships, submarines,
+								// battleships
+		unsigned int seed;		// The same seed always generates the same boards
+	};
+
+	/** Generates random legal boards of given dimensions and fleet, directly as validated boards (no text is
+	 *  parsed and nothing is validated again). Both players get the same fleet, so boards are balanced, and no
+	 *  ship touches another ship by a face, as BoardBuilder requires.
+	 *  Board i of a seed depends only on the seed and i, so the same boards are generated on any number of threads.
+	 */
+	class BoardGenerator
+	{
+	public:
+		/** Name prefix of generated boards (followed by the seed and the index of the board) */
+		static constexpr auto BOARD_NAME_PREFIX = "generated_";
+
+		explicit BoardGenerator(const GeneratorSettings& settings);
+		virtual ~BoardGenerator() = default;
+
+		/** Generates board boardIndex into board (reusing its buffers). Returns false if the fleet couldn't be
+		 *  placed on the board, which happens only if it (almost) doesn't fit the board's dimensions.
+		 *  Safe to call from multiple threads.
+		 */
+		bool generate(uint64_t boardIndex, ArchivedBoard& board) const;
+
+		/** Generates boards firstIndex to firstIndex + count - 1 on all cores, and passes each generated board to
+		 *  onBoard on the thread that generated it, with the board's position in the batch (0 to count - 1).
+		 *  The board may be moved out by onBoard. Generation stops early once too many boards failed.
+		 *  Returns the number of boards generated.
+		 */
+		size_t generateAll(uint64_t firstIndex, size_t count,
+						   const function<void(size_t position, ArchivedBoard& board)>& onBoard) const;
+
+		/** Returns the name of board boardIndex (e.g. "generated_7_42.sboard") */
+		string boardName(uint64_t boardIndex) const;
+
+		/** Parses board dimensions in the format of a board file's header (e.g. "10x10x5").
+		 *  Returns false if the dimensions are invalid.
+		 */
+		static bool parseDimensions(const string& value, int& width, int& height, int& depth);
+
+		/** Parses a player's fleet, given as the ship characters of its ships (e.g. "BPPMD").
+		 *  Returns false if the fleet is empty or contains other characters.
+		 */
+		static bool parseFleet(const string& value, array<int, 4>& fleet);
+
+	private:
+		// Attempts to place a single ship before the board is started over, and boards started over before
+		// the board fails
+		static constexpr int PLACEMENT_ATTEMPTS = 256;
+		static constexpr int BOARD_ATTEMPTS = 16;
+
+		// Number of failed boards that stops generateAll
+		static constexpr size_t FAILURES_LIMIT = 64;
+
+		// Marks empty squares next to a placed ship while the board is generated, no ship may be placed on them
+		static constexpr char BLOCKED_SQUARE = '.';
+
+		GeneratorSettings _settings;
+		vector<BoardPiece> _ships;	// Ships of both players, largest first (positions are unset)
+
+		/** Places all ships at random positions on board's squares (which are all empty), adding them to
+		 *  board's pieces. Returns false if a ship couldn't be placed.
+		 */
+		bool placeShips(uint64_t& randomState, ArchivedBoard& board) const;
+	};
+}
@@ -0,0 +1,270 @@
+#include "BoardSamplingFormat.h"
+#include "Logger.h"
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+using std::lock_guard;
+using std::to_string;
+using std::stringstream;
+using std::setw;
+using std::setprecision;
+using std::fixed;
+using std::left;
+using std::endl;
+
+namespace battleship
+{
+	/** Flattens the strata into a single list of boards */
+	static vector<string> allBoards(const vector<vector<string>>& strata)
+	{
+		vector<string> boards;
+		for (const auto& stratum : strata)
+			boards.insert(boards.end(), stratum.begin(), stratum.end());
+
+		return boards;
+	}
+
+	BoardSamplingFormat::BoardSamplingFormat(const vector<string>& players, const vector<vector<string>>& strata,
+											 const PreviewSettings& settings) :
+		TournamentFormat(players, allBoards(strata), 1), // Each wave plays a single board per pairing
+		_strata(strata),
+		_isTimeBudget(settings.timeBudgetSeconds > 0)
+	{
+		for (size_t stratum = 0; stratum < _strata.size(); ++stratum)
+		{
+			for (const auto& board : _strata[stratum])
+				_boardStratum[board] = stratum;
+		}
+
+		for (const auto& player : players)
+			_scores[player].resize(_strata.size());
+
+		// Each board of a pairing's sample is played twice (each player starts once)
+		size_t pairings = (players.size() * (players.size() - 1)) / 2;
+		if (settings.gameBudget > 0)
+			_boardsPerPairing = static_cast<size_t>(settings.gameBudget) / ((pairings > 0) ? (2 * pairings) : 1);
+		else if (_isTimeBudget)
+			_boardsPerPairing = _boards.size(); // Play as many waves as time allows
+		else
+			_boardsPerPairing = _strata.size(); // One board of each dimensions
+
+		if (_boardsPerPairing > _boards.size())
+			_boardsPerPairing = _boards.size();
+		if (_boardsPerPairing < 1)
+			_boardsPerPairing = 1;
+
+		_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(settings.timeBudgetSeconds);
+
+		drawSamples(settings.seed);
+
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Board sampling preview: " + to_string(_boardsPerPairing) + " of " +
+								  to_string(_boards.size()) + " boards (" + to_string(_strata.size()) +
+								  " dimension strata) per pairing, seed " + to_string(settings.seed));
+	}
+
+	vector<size_t> BoardSamplingFormat::allocateSample(size_t count) const
+	{
+		vector<size_t> allocation(_strata.size(), 0);
+		size_t allocated = 0;
+
+		// Every stratum is represented if the sample is large enough
+		if (count >= _strata.size())
+		{
+			for (size_t stratum = 0; stratum < _strata.size(); ++stratum)
+				allocation[stratum] = 1;
+			allocated = _strata.size();
+		}
+
+		// The rest is split in proportion to the strata sizes, leftovers go to the largest remainders
+		size_t capacity = _boards.size() - allocated;
+		size_t extra = count - allocated;
+		vector<double> remainders(_strata.size(), 0);
+		for (size_t stratum = 0; (stratum < _strata.size()) && (capacity > 0); ++stratum)
+		{
+			double quota = static_cast<double>(extra) * (_strata[stratum].size() - allocation[stratum]) / capacity;
+			size_t whole = static_cast<size_t>(quota);
+			allocation[stratum] += whole;
+			allocated += whole;
+			remainders[stratum] = quota - whole;
+		}
+
+		while (allocated < count)
+		{
+			size_t best = _strata.size();
+			for (size_t stratum = 0; stratum < _strata.size(); ++stratum)
+			{
+				bool hasRoom = allocation[stratum] < _strata[stratum].size();
+				if (hasRoom && ((best == _strata.size()) || (remainders[stratum] > remainders[best])))
+					best = stratum;
+			}
+
+			if (best == _strata.size())
+				break; // All boards are sampled
+
+			allocation[best]++;
+			remainders[best] = -1;
+			allocated++;
+		}
+
+		return allocation;
+	}
+
+	void BoardSamplingFormat::drawSamples(unsigned int seed)
+	{
+		// mt19937 output is fully specified by the standard, so the same seed draws the same sample anywhere.
+		// Distributions are implementation defined, so indices are drawn with a plain modulo.
+		std::mt19937 generator(seed);
+		vector<size_t> allocation = allocateSample(_boardsPerPairing);
+
+		for (size_t a = 0; a < _players.size(); ++a)
+		{
+			for (size_t b = a + 1; b < _players.size(); ++b)
+			{
+				// Sample each stratum without replacement (partial Fisher-Yates shuffle)
+				vector<vector<string>> sampledStrata;
+				for (size_t stratum = 0; stratum < _strata.size(); ++stratum)
+				{
+					vector<string> boards(_strata[stratum]);
+					for (size_t i = 0; i < allocation[stratum]; ++i)
+					{
+						size_t pick = i + (generator() % (boards.size() - i));
+						std::swap(boards[i], boards[pick]);
+					}
+
+					boards.resize(allocation[stratum]);
+					sampledStrata.push_back(boards);
+				}
+
+				// Interleave the strata, so any prefix of the sample (cut by the time budget) stays stratified
+				vector<string> sample;
+				for (size_t i = 0; sample.size() < _boardsPerPairing; ++i)
+				{
+					for (const auto& boards : sampledStrata)
+					{
+						if (i < boards.size())
+							sample.push_back(boards[i]);
+					}
+				}
+
+				_pairingSamples.push_back(std::make_pair(Match{ _players[a], _players[b] }, sample));
+			}
+		}
+	}
+
+	size_t BoardSamplingFormat::maxRoundsPerPlayer() const
+	{
+		return _boardsPerPairing * 2 * (_players.size() - 1);
+	}
+
+	bool BoardSamplingFormat::nextStage(const Standings& standings, TournamentStage& stage)
+	{
+		if ((_stagesPlayed >= _boardsPerPairing) || (_players.size() < 2))
+			return false;
+
+		if (_isTimeBudget && (std::chrono::steady_clock::now() >= _deadline))
+		{
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Board sampling preview: time budget is over after " +
+									  to_string(_stagesPlayed) + " waves");
+			return false;
+		}
+
+		// All pairings start with player A first, then with player B
+		for (int startingPlayer = 0; startingPlayer < 2; ++startingPlayer)
+		{
+			for (const auto& pairing : _pairingSamples)
+			{
+				const Match& match = pairing.first;
+				const string& board = pairing.second[_stagesPlayed];
+				const string& first = (startingPlayer == 0) ? match.playerA : match.playerB;
+				const string& second = (startingPlayer == 0) ? match.playerB : match.playerA;
+				stage.games.push_back(std::make_unique<SingleGameTask>(first, second, board));
+			}
+		}
+
+		_stagesPlayed++;
+		return true;
+	}
+
+	void BoardSamplingFormat::recordGame(const SingleGameTask& game, const GameResults& results)
+	{
+		double scoreA = (results.winner == PlayerEnum::A) ? 1 : ((results.winner == PlayerEnum::B) ? 0 : 0.5);
+		size_t stratum = _boardStratum.at(game.boardName());
+
+		lock_guard<mutex> lock(_scoresLock);
+
+		StratumScore& playerA = _scores.at(game.playerAName())[stratum];
+		playerA.score += scoreA;
+		playerA.games++;
+
+		StratumScore& playerB = _scores.at(game.playerBName())[stratum];
+		playerB.score += 1 - scoreA;
+		playerB.games++;
+	}
+
+	string BoardSamplingFormat::summary() const
+	{
+		// Stratified estimate: each stratum's score weighted by the share of its boards among all boards
+		vector<pair<string, pair<double, double>>> estimates; // Player, (estimate, error bar)
+		{
+			lock_guard<mutex> lock(_scoresLock);
+
+			for (const auto& player : _scores)
+			{
+				double weights = 0;
+				for (size_t stratum = 0; stratum < _strata.size(); ++stratum)
+				{
+					if (player.second[stratum].games > 0)
+						weights += static_cast<double>(_strata[stratum].size()) / _boards.size();
+				}
+
+				double estimate = 0;
+				double variance = 0;
+				for (size_t stratum = 0; (stratum < _strata.size()) && (weights > 0); ++stratum)
+				{
+					const StratumScore& score = player.second[stratum];
+					if (score.games == 0)
+						continue;
+
+					double weight = (static_cast<double>(_strata[stratum].size()) / _boards.size()) / weights;
+					double rate = score.score / score.games;
+
+					// Adjusted rate for the variance, so unanimous strata don't claim zero error
+					double adjusted = (score.score + 1) / (score.games + 2);
+					estimate += weight * rate;
+					variance += weight * weight * adjusted * (1 - adjusted) / score.games;
+				}
+
+				estimates.push_back(std::make_pair(player.first,
+												   std::make_pair(100 * estimate, 100 * 1.96 * std::sqrt(variance))));
+			}
+		}
+
+		std::sort(estimates.begin(), estimates.end(), [](const pair<string, pair<double, double>>& a,
+														 const pair<string, pair<double, double>>& b)
+		{
+			return a.second.first > b.second.first;
+		});
+
+		size_t nameWidth = 12;
+		for (const auto& entry : estimates)
+			nameWidth = (entry.first.length() + 2 > nameWidth) ? entry.first.length() + 2 : nameWidth;
+
+		stringstream ss;
+		ss << "Estimated standings (" << _stagesPlayed << "/" << _boards.size()
+		   << " boards per pairing, 95% error bars)" << endl;
+		ss << left << setw(8) << "#" << setw(nameWidth) << "Team Name" << setw(10) << "Score %" << "Error" << endl << endl;
+
+		int place = 1;
+		for (const auto& entry : estimates)
+		{
+			ss << setw(8) << (to_string(place++) + ".") << setw(nameWidth) << entry.first
+			   << fixed << setprecision(2) << setw(10) << entry.second.first << "+/- " << entry.second.second << endl;
+		}
+
+		return ss.str();
+	}
+}
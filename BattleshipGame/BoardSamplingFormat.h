@@ -0,0 +1,75 @@
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <random>
+#include "TournamentFormat.h"
+
+using std::mutex;
+
+namespace battleship
+{
+	/** Parameters of the board sampling (preview) mode, as loaded from the configuration file */
+	struct PreviewSettings
+	{
+		bool isEnabled;			// If true, the preview replaces the configured tournament format
+		unsigned int seed;		// Seed of the board sampling, the same seed always samples the same boards
+		int gameBudget;			// Approximate total number of games, 0 for one board of each dimensions per pairing
+		int timeBudgetSeconds;	// No new wave of games is started after this time, 0 for no time limit
+	};
+
+	/** Quick preview of a round robin: each pairing plays a stratified random sample of the boards instead of
+	 *  all of them. Boards are stratified by their dimensions, and each pairing's sample is allocated between
+	 *  the strata in proportion to their sizes. Games are played in waves - in each wave every pairing plays
+	 *  the next board of its sample (once as player A and once as player B) - so a time budget stops the
+	 *  preview between waves with all players in step.
+	 *  Standings are estimated per stratum and weighted by the strata sizes, with 95% error bars.
+	 */
+	class BoardSamplingFormat : public TournamentFormat
+	{
+	public:
+		/** strata holds the boards grouped by their dimensions */
+		BoardSamplingFormat(const vector<string>& players, const vector<vector<string>>& strata,
+							const PreviewSettings& settings);
+		virtual ~BoardSamplingFormat() = default;
+
+		size_t maxRoundsPerPlayer() const override;
+		bool nextStage(const Standings& standings, TournamentStage& stage) override;
+		void recordGame(const SingleGameTask& game, const GameResults& results) override;
+		string summary() const override;
+
+	private:
+		/** Results of a player on the boards of a single stratum */
+		struct StratumScore
+		{
+			double score = 0; // Wins count as 1, ties as 0.5
+			int games = 0;
+		};
+
+		// Boards grouped by dimensions
+		vector<vector<string>> _strata;
+
+		// Stratum index of each board
+		map<string, size_t> _boardStratum;
+
+		// Sampled boards of each pairing, ordered so the strata are interleaved
+		vector<pair<Match, vector<string>>> _pairingSamples;
+
+		// Number of boards each pairing plays
+		size_t _boardsPerPairing;
+
+		// No wave starts after this time (if there is a time budget)
+		bool _isTimeBudget;
+		std::chrono::steady_clock::time_point _deadline;
+
+		// Results of each player in each stratum, protected by _scoresLock
+		map<string, vector<StratumScore>> _scores;
+		mutable mutex _scoresLock;
+
+		/** Allocates count boards between the strata in proportion to their sizes (largest remainder) */
+		vector<size_t> allocateSample(size_t count) const;
+
+		/** Draws the sample of boards of each pairing */
+		void drawSamples(unsigned int seed);
+	};
+}
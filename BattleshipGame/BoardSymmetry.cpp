@@ -0,0 +1,90 @@
+#include "BoardSymmetry.h"
+#include "IOUtil.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using std::pair;
+using std::vector;
+
+namespace battleship
+{
+	// Orders of the axes: the source axis of each axis of the transformed board (0 - row, 1 - column, 2 - depth)
+	static const int AXES_ORDERS[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+
+	string BoardSymmetry::canonicalForm(const BattleBoard& board, bool isPlayersSwapped)
+	{
+		const int sizes[3] = { board.height(), board.width(), board.depth() };
+
+		// Every square of every ship, with the ship's character as in a board file (player B in lower case)
+		vector<pair<Coordinate, char>> squares;
+		for (const auto& piece : board.gamePiecesList())
+		{
+			bool isPlayerA = ((piece->_player == PlayerEnum::A) != isPlayersSwapped);
+			char representation = static_cast<char>(piece->_shipType->_representation);
+			char square = isPlayerA ? representation : static_cast<char>(tolower(representation));
+
+			int deltaCol = (piece->_orient == Orientation::X_AXIS) ? 1 : 0;
+			int deltaRow = (piece->_orient == Orientation::Y_AXIS) ? 1 : 0;
+			int deltaDepth = (piece->_orient == Orientation::Z_AXIS) ? 1 : 0;
+
+			for (int index = 0; index < piece->_shipType->_size; ++index)
+			{
+				squares.emplace_back(Coordinate(piece->_firstPos.row + index * deltaRow,
+												piece->_firstPos.col + index * deltaCol,
+												piece->_firstPos.depth + index * deltaDepth), square);
+			}
+		}
+
+		vector<char> canonical;
+		vector<pair<uint64_t, char>> transformed(squares.size());
+
+		for (const auto& axesOrder : AXES_ORDERS)
+		{
+			// Axes may only be swapped with axes of the same size, so the dimensions stay the same
+			if ((sizes[axesOrder[0]] != sizes[0]) || (sizes[axesOrder[1]] != sizes[1]))
+				continue;
+
+			for (int mirror = 0; mirror < MIRRORS_COUNT; ++mirror)
+			{
+				for (size_t squareIndex = 0; squareIndex < squares.size(); ++squareIndex)
+				{
+					const Coordinate& source = squares[squareIndex].first;
+					const int position[3] = { source.row, source.col, source.depth };
+
+					uint64_t index = 0;
+					for (int axis = 0; axis < 3; ++axis)
+					{
+						int value = position[axesOrder[axis]];
+						if ((mirror >> axis) & 1)
+							value = sizes[axis] - 1 - value;
+
+						index = index * sizes[axis] + value;
+					}
+
+					transformed[squareIndex] = { index, squares[squareIndex].second };
+				}
+
+				std::sort(transformed.begin(), transformed.end());
+
+				vector<char> encoding;
+				encoding.reserve(transformed.size() * (sizeof(uint64_t) + 1) + 3 * sizeof(int32_t));
+				for (int size : sizes)
+					IOUtil::putValue(encoding, static_cast<int32_t>(size));
+
+				for (const auto& square : transformed)
+				{
+					IOUtil::putValue(encoding, square.first);
+					encoding.push_back(square.second);
+				}
+
+				if (canonical.empty() || (encoding < canonical))
+					canonical = std::move(encoding);
+			}
+		}
+
+		return string(canonical.begin(), canonical.end());
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include "BattleBoard.h"
+
+using std::string;
+
+namespace battleship
+{
+	/** Canonical forms of boards under the board's symmetries: the mirrors of each axis, and the rotations that
+	 *  swap axes of the same size (a 10x10x5 board can be turned around its depth axis, a cube around any axis).
+	 *  Two boards of the same canonical form are the same board seen from another side, so a player that
+	 *  doesn't depend on the board's orientation plays them the same.
+	 */
+	class BoardSymmetry
+	{
+	public:
+		virtual ~BoardSymmetry() = delete; // Static functions only
+
+		/** Returns the canonical form of the board: the smallest encoding of its squares over all of the board's
+		 *  symmetries. If isPlayersSwapped, the ships of player A are encoded as ships of player B and vice versa,
+		 *  so a board and its players swapped copy share a canonical form only this way.
+		 */
+		static string canonicalForm(const BattleBoard& board, bool isPlayersSwapped);
+
+	private:
+		// Number of the mirrors of a board, each axis is mirrored or not
+		static constexpr int MIRRORS_COUNT = 8;
+	};
+}
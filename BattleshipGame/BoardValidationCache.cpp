@@ -0,0 +1,165 @@
+#include "BoardValidationCache.h"
+#include "IOUtil.h"
+#include <cstring>
+#include <fstream>
+
+using std::ifstream;
+using std::ofstream;
+
+namespace battleship
+{
+	static constexpr char HEADER_MAGIC[4] = { 'S', 'B', 'C', '1' };
+
+	BoardValidationCache::BoardValidationCache(const string& path) :
+		_cachePath(path + "\\" + CACHE_FILE), _isChanged(false)
+	{
+		// An unusable cache is rewritten from scratch on save
+		if (!load())
+		{
+			_entries.clear();
+			_isChanged = true;
+		}
+	}
+
+	const CachedValidation* BoardValidationCache::find(uint64_t contentHash) const
+	{
+		auto entry = _entries.find(contentHash);
+		return (entry != _entries.end()) ? &entry->second : nullptr;
+	}
+
+	void BoardValidationCache::keep(uint64_t contentHash)
+	{
+		_usedHashes.insert(contentHash);
+	}
+
+	void BoardValidationCache::store(uint64_t contentHash, CachedValidation validation)
+	{
+		_entries[contentHash] = std::move(validation);
+		_usedHashes.insert(contentHash);
+		_isChanged = true;
+	}
+
+	bool BoardValidationCache::save()
+	{
+		// Entries of board files that were removed or changed since the last run are dropped
+		_isChanged = _isChanged || (_usedHashes.size() != _entries.size());
+		if (!_isChanged)
+			return true;
+
+		vector<char> buffer;
+		buffer.insert(buffer.end(), HEADER_MAGIC, HEADER_MAGIC + sizeof(HEADER_MAGIC));
+		IOUtil::putValue(buffer, VERSION);
+		IOUtil::putValue(buffer, BoardBuilder::VALIDATOR_VERSION);
+		IOUtil::putValue(buffer, static_cast<uint32_t>(_usedHashes.size()));
+
+		for (auto contentHash : _usedHashes)
+		{
+			const auto& validation = _entries.at(contentHash);
+			IOUtil::putValue(buffer, contentHash);
+			IOUtil::putValue(buffer, static_cast<uint8_t>(validation.isValid ? 1 : 0));
+			IOUtil::putValue(buffer, static_cast<uint8_t>(0));
+			IOUtil::putValue(buffer, static_cast<uint16_t>(0));
+
+			if (validation.isValid)
+			{
+				BoardArchive::appendRecord(buffer, validation.board);
+			}
+			else
+			{
+				IOUtil::putValue(buffer, static_cast<uint32_t>(validation.errors.size()));
+				for (const auto& error : validation.errors)
+					IOUtil::putString(buffer, error);
+			}
+		}
+
+		ofstream fs(_cachePath, ofstream::binary | ofstream::trunc);
+		if (!fs.is_open())
+			return false;
+
+		fs.write(buffer.data(), buffer.size());
+		if (!fs.good())
+			return false;
+
+		_isChanged = false;
+		return true;
+	}
+
+	bool BoardValidationCache::load()
+	{
+		ifstream fs(_cachePath, ifstream::binary | ifstream::ate);
+		if (!fs.is_open())
+			return false;
+
+		// The whole cache is read at once and parsed in memory
+		std::streamoff fileSize = fs.tellg();
+		if (fileSize < static_cast<std::streamoff>(HEADER_SIZE))
+			return false;
+
+		vector<char> buffer(static_cast<size_t>(fileSize));
+		fs.seekg(0);
+		if (!fs.read(buffer.data(), fileSize))
+			return false;
+
+		const char* cursor = buffer.data();
+		const char* end = buffer.data() + buffer.size();
+
+		char magic[4];
+		uint32_t version = 0;
+		uint32_t validatorVersion = 0;
+		uint32_t entriesCount = 0;
+		IOUtil::getValue(cursor, end, magic);
+		IOUtil::getValue(cursor, end, version);
+		IOUtil::getValue(cursor, end, validatorVersion);
+		IOUtil::getValue(cursor, end, entriesCount);
+
+		// Outcomes of another validator version may not hold anymore, so they're all dropped
+		if ((std::memcmp(magic, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0) || (version != VERSION) ||
+			(validatorVersion != BoardBuilder::VALIDATOR_VERSION))
+		{
+			return false;
+		}
+
+		for (uint32_t entryIndex = 0; entryIndex < entriesCount; ++entryIndex)
+		{
+			uint64_t contentHash = 0;
+			uint8_t isValid = 0;
+			uint8_t reserved = 0;
+			uint16_t reservedWord = 0;
+			if (!IOUtil::getValue(cursor, end, contentHash) || !IOUtil::getValue(cursor, end, isValid) ||
+				!IOUtil::getValue(cursor, end, reserved) || !IOUtil::getValue(cursor, end, reservedWord))
+			{
+				return false;
+			}
+
+			CachedValidation validation;
+			validation.isValid = (isValid != 0);
+
+			if (validation.isValid)
+			{
+				if (!BoardArchive::parseRecord(cursor, end, validation.board))
+					return false;
+			}
+			else
+			{
+				// Every error takes at least its length field
+				uint32_t errorsCount = 0;
+				if (!IOUtil::getValue(cursor, end, errorsCount) ||
+					(errorsCount > static_cast<size_t>(end - cursor) / sizeof(uint32_t)))
+				{
+					return false;
+				}
+
+				validation.errors.assign(errorsCount, string());
+				for (auto& error : validation.errors)
+				{
+					if (!IOUtil::getString(cursor, end, error))
+						return false;
+				}
+			}
+
+			_entries[contentHash] = std::move(validation);
+		}
+
+		return cursor == end;
+	}
+}
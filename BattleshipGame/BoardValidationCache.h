@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include "BoardArchive.h"
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::unordered_set;
+
+namespace battleship
+{
+	/** Outcome of loading a board file, as cached */
+	struct CachedValidation
+	{
+		bool isValid;
+		ArchivedBoard board;	// The validated board (with its warnings), if valid
+		vector<string> errors;	// Validation errors, if invalid (none if the file isn't a board file at all)
+	};
+
+	/** Persistent cache of the outcomes of loading board files, kept in the boards path (boards.sbcache).
+	 *  Entries are keyed by the hash of a board file's content, so a board file is parsed and validated again
+	 *  only once its content changes. The whole cache is dropped when the validator version changes.
+	 *
+	 *  Layout (little endian):
+	 *  Header   - "SBC1", cache version, validator version (BoardBuilder::VALIDATOR_VERSION), entries count
+	 *             (16 bytes)
+	 *  Entries  - content hash (8 bytes), valid flag (1 byte, padded to 4 bytes), then the board's record
+	 *             (see BoardArchive) if valid, or the errors count (4 bytes) and errors (length (4 bytes) and
+	 *             characters each) if invalid
+	 */
+	class BoardValidationCache
+	{
+	public:
+		static constexpr uint32_t VERSION = 2;
+		static constexpr size_t HEADER_SIZE = 16;
+
+		/** Loads the cache of the boards in path. A missing, corrupt or outdated cache is loaded empty. */
+		explicit BoardValidationCache(const string& path);
+		virtual ~BoardValidationCache() = default;
+
+		BoardValidationCache(BoardValidationCache const&) = delete;
+		void operator=(BoardValidationCache const&) = delete;
+
+		/** Returns the outcome cached for the content hash, or NULL.
+		 *  Safe to call from multiple threads, as long as no entries are kept or stored meanwhile.
+		 */
+		const CachedValidation* find(uint64_t contentHash) const;
+
+		/** Keeps a cached entry when the cache is saved */
+		void keep(uint64_t contentHash);
+
+		/** Adds the outcome of loading a board file with the given content hash */
+		void store(uint64_t contentHash, CachedValidation validation);
+
+		/** Writes the cache if it changed, with only the entries kept or stored since it was loaded.
+		 *  Returns false if the cache couldn't be written.
+		 */
+		bool save();
+
+	private:
+		static constexpr auto CACHE_FILE = "boards.sbcache"; // Cache file name
+
+		string _cachePath;
+		unordered_map<uint64_t, CachedValidation> _entries;
+		unordered_set<uint64_t> _usedHashes; // Entries kept or stored, the rest are dropped on save
+		bool _isChanged;
+
+		/** Loads the entries of the cache file, returns false if it's missing, corrupt or outdated */
+		bool load();
+	};
+}
@@ -0,0 +1,187 @@
+#include "Tests.h"
+#include "BoardGenerator.h"
+#include "BoardValidationCache.h"
+#include <cstdio>
+#include <random>
+
+namespace battleship
+{
+	namespace
+	{
+		constexpr auto CACHE_DIRECTORY = ".";
+		constexpr auto CACHE_PATH = ".\\boards.sbcache"; // As the cache joins its directory and file name
+
+		/** Returns random outcomes: valid generated boards (with warnings) and invalid ones (with errors, or none
+		 *  for files that aren't board files at all)
+		 */
+		unordered_map<uint64_t, CachedValidation> randomValidations(std::mt19937& random, size_t count)
+		{
+			auto uniform = [&random](int min, int max) { return std::uniform_int_distribution<int>(min, max)(random); };
+
+			unordered_map<uint64_t, CachedValidation> validations;
+			while (validations.size() < count)
+			{
+				uint64_t contentHash = (static_cast<uint64_t>(random()) << 32) | random();
+				CachedValidation validation{ uniform(0, 1) == 0, ArchivedBoard(), {} };
+
+				if (validation.isValid)
+				{
+					GeneratorSettings settings{ 1, uniform(1, 6), uniform(1, 6), uniform(1, 6),
+												{ 1, uniform(0, 1), uniform(0, 1), 0 }, static_cast<unsigned int>(random()) };
+					if (!BoardGenerator(settings).generate(0, validation.board))
+						continue;
+
+					for (int warning = uniform(0, 1); warning > 0; --warning)
+						validation.board.warnings.push_back("Warning " + std::to_string(uniform(0, 1000)));
+				}
+				else
+				{
+					for (int error = uniform(0, 3); error > 0; --error)
+						validation.errors.push_back("Error " + std::to_string(uniform(0, 1000)));
+				}
+
+				validations[contentHash] = std::move(validation);
+			}
+
+			return validations;
+		}
+
+		/** Returns true if the cached outcome is the stored one. Only the content of boards (which their hash
+		 *  covers) is compared unless isExact is set.
+		 */
+		bool isSameValidation(const CachedValidation& cached, const CachedValidation& stored, bool isExact)
+		{
+			if (cached.isValid != stored.isValid)
+				return false;
+
+			if (!cached.isValid)
+				return !isExact || (cached.errors == stored.errors);
+
+			const ArchivedBoard& first = cached.board;
+			const ArchivedBoard& second = stored.board;
+			bool isSameContent = (first.width == second.width) && (first.height == second.height) &&
+								 (first.depth == second.depth) && (first.squares == second.squares) &&
+								 (first.pieces.size() == second.pieces.size()) && (first.contentHash == second.contentHash);
+
+			return isSameContent && (!isExact || ((first.name == second.name) && (first.warnings == second.warnings) &&
+												  (first.sourceHash == second.sourceHash)));
+		}
+
+		/** Returns the number of outcomes the cache holds, checking each one is the stored one */
+		size_t countCached(const BoardValidationCache& cache, const unordered_map<uint64_t, CachedValidation>& stored,
+						   bool isExact)
+		{
+			size_t cachedCount = 0;
+			bool isSame = true;
+			for (const auto& entry : stored)
+			{
+				const CachedValidation* cached = cache.find(entry.first);
+				if (cached != nullptr)
+				{
+					isSame = isSame && isSameValidation(*cached, entry.second, isExact);
+					cachedCount++;
+				}
+			}
+
+			TEST_CHECK(isSame);
+			return cachedCount;
+		}
+	}
+
+	void boardValidationCacheTests(unsigned int seed)
+	{
+		static constexpr size_t ENTRIES_COUNT = 300;
+
+		std::mt19937 random(seed);
+		std::remove(CACHE_PATH);
+		unordered_map<uint64_t, CachedValidation> validations = randomValidations(random, ENTRIES_COUNT);
+
+		// A missing cache is empty, and stored outcomes are found by the next run
+		{
+			BoardValidationCache cache(CACHE_DIRECTORY);
+			TEST_CHECK(countCached(cache, validations, true) == 0);
+
+			for (const auto& entry : validations)
+				cache.store(entry.first, entry.second);
+
+			TEST_CHECK(cache.save());
+		}
+
+		vector<char> bytes = TestRunner::readBytes(CACHE_PATH);
+		{
+			BoardValidationCache cache(CACHE_DIRECTORY);
+			TEST_CHECK(countCached(cache, validations, true) == validations.size());
+
+			// A cache that didn't change isn't written again
+			for (const auto& entry : validations)
+				cache.keep(entry.first);
+
+			TestRunner::writeBytes(CACHE_PATH, { 'x' });
+			TEST_CHECK(cache.save());
+			TEST_CHECK(TestRunner::readBytes(CACHE_PATH) == vector<char>{ 'x' });
+		}
+
+		// Outcomes of board files that weren't loaded (removed or changed) are dropped on save
+		{
+			TestRunner::writeBytes(CACHE_PATH, bytes);
+			BoardValidationCache cache(CACHE_DIRECTORY);
+
+			size_t keptCount = 0;
+			for (const auto& entry : validations)
+			{
+				if (keptCount++ % 2 == 0)
+					cache.keep(entry.first);
+			}
+
+			TEST_CHECK(cache.save());
+			TEST_CHECK(countCached(BoardValidationCache(CACHE_DIRECTORY), validations, true) == (validations.size() + 1) / 2);
+		}
+
+		// A truncated cache is dropped as a whole
+		for (size_t size = 0; size < bytes.size(); size += 1 + (size * 3) % 251)
+		{
+			TestRunner::writeBytes(CACHE_PATH, vector<char>(bytes.begin(), bytes.begin() + size));
+			TestRunner::check(countCached(BoardValidationCache(CACHE_DIRECTORY), validations, false) == 0,
+							  "Truncated cache of " + std::to_string(size) + " bytes is loaded");
+		}
+
+		// Damage is either dropped or limited to what isn't covered by a board's hash (a damaged content hash
+		// only makes an entry miss)
+		for (int damage = 0; damage < 500; ++damage)
+		{
+			vector<char> damaged = bytes;
+			size_t offset = std::uniform_int_distribution<size_t>(0, damaged.size() - 1)(random);
+			damaged[offset] = static_cast<char>(std::uniform_int_distribution<int>(0, 255)(random));
+
+			TestRunner::writeBytes(CACHE_PATH, damaged);
+			countCached(BoardValidationCache(CACHE_DIRECTORY), validations, false);
+		}
+
+		// Counts past the end of the file are rejected before anything is allocated for them
+		{
+			vector<char> damaged = bytes;
+			std::fill(damaged.begin() + 12, damaged.begin() + 16, static_cast<char>(0xFF)); // Entries count
+			TestRunner::writeBytes(CACHE_PATH, damaged);
+			TEST_CHECK(countCached(BoardValidationCache(CACHE_DIRECTORY), validations, false) == 0);
+
+			// A single invalid entry with a huge errors count
+			vector<char> entry(BoardValidationCache::HEADER_SIZE + sizeof(uint64_t) + sizeof(uint32_t), 0);
+			std::copy(bytes.begin(), bytes.begin() + 12, entry.begin());
+			entry[12] = 1;
+			entry.insert(entry.end(), 4, static_cast<char>(0xFF));
+			TestRunner::writeBytes(CACHE_PATH, entry);
+			TEST_CHECK(BoardValidationCache(CACHE_DIRECTORY).find(0) == nullptr);
+		}
+
+		// Outcomes of another cache or validator version are dropped
+		for (size_t versionOffset : { 4, 8 })
+		{
+			vector<char> damaged = bytes;
+			damaged[versionOffset]++;
+			TestRunner::writeBytes(CACHE_PATH, damaged);
+			TEST_CHECK(countCached(BoardValidationCache(CACHE_DIRECTORY), validations, false) == 0);
+		}
+
+		std::remove(CACHE_PATH);
+	}
+}
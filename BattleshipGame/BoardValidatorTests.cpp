@@ -0,0 +1,535 @@
+#include "Tests.h"
+#include "BattleBoard.h"
+#include "BoardBuilder.h"
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+using std::cout;
+using std::endl;
+using std::map;
+using std::set;
+using std::tuple;
+using std::unordered_set;
+using std::vector;
+
+namespace battleship
+{
+	namespace
+	{
+		/** The mask validator BoardBuilder used before the flood fill one (VALIDATOR_VERSION 1), kept as the
+		 *  reference the new validator is compared with. Each ship's first square is matched against a mask of the
+		 *  ship's squares and their empty surroundings along each axis.
+		 */
+		class MaskValidator
+		{
+		public:
+			MaskValidator(const map<Coordinate, char>& boardMap, int width, int height, int depth) :
+				boardMap(boardMap), boardWidth(width), boardHeight(height), boardDepth(depth)
+			{
+			}
+
+			/** Returns true if the board is valid, the errors and the pieces found are returned by reference */
+			bool isValidBoard(set<ErrorPriorityEnum>& errors, vector<BoardPiece>& pieces);
+
+		private:
+			class ShipMask
+			{
+			public:
+				using MaskEntry = pair<Coordinate, BoardSquare>;
+
+				BoardSquare maskType;
+				vector<MaskEntry> mask;
+				Orientation orient;
+				bool wrongSize;
+				bool adjacentShips;
+
+				explicit ShipMask(BoardSquare ship);
+
+				bool applyMask(const map<Coordinate, char>& boardMap, tuple<int, int, int> boardSize, Coordinate coord,
+							   PlayerEnum player);
+
+				static void applyMaskEntry(char boardSquare, char shipChar, const MaskEntry& maskEntry, bool axisException,
+										   int& matchSizeAxis, bool& wrongSizeAxis, bool& adjacentShipsAxis);
+			};
+
+			map<Coordinate, char> boardMap;
+			int boardWidth;
+			int boardHeight;
+			int boardDepth;
+
+			void markVisitedCoords(unordered_set<Coordinate, CoordinateHash>& coordSet, Coordinate coord);
+
+			static bool isBalancedBoard(vector<BoardSquare>& playerAShips, vector<BoardSquare>& playerBShips);
+		};
+
+		MaskValidator::ShipMask::ShipMask(BoardSquare ship) :
+			maskType(ship), orient(Orientation::X_AXIS), wrongSize(false), adjacentShips(false)
+		{
+			// Squares of the ship along the col axis, then its empty surroundings
+			int size = BattleBoard::shipTypeOf(ship)->_size;
+			for (int col = 1; col < size; ++col)
+				mask.push_back({ Coordinate(0, col, 0), ship });
+
+			for (int col = 0; col < size; ++col)
+			{
+				mask.push_back({ Coordinate(1, col, 0), BoardSquare::Empty });
+				mask.push_back({ Coordinate(-1, col, 0), BoardSquare::Empty });
+			}
+
+			mask.push_back({ Coordinate(0, size, 0), BoardSquare::Empty });
+			mask.push_back({ Coordinate(0, -1, 0), BoardSquare::Empty });
+
+			for (int col = 0; col < size; ++col)
+			{
+				mask.push_back({ Coordinate(0, col, 1), BoardSquare::Empty });
+				mask.push_back({ Coordinate(0, col, -1), BoardSquare::Empty });
+			}
+		}
+
+		void MaskValidator::ShipMask::applyMaskEntry(char boardSquare, char shipChar, const MaskEntry& maskEntry,
+													 bool axisException, int& matchSizeAxis, bool& wrongSizeAxis,
+													 bool& adjacentShipsAxis)
+		{
+			char maskChar = static_cast<char>(maskEntry.second);
+			if (islower(shipChar))
+				maskChar = static_cast<char>(tolower(maskChar));
+
+			if (!axisException)
+			{
+				if (boardSquare == maskChar)
+				{
+					if (maskChar != static_cast<char>(BoardSquare::Empty))
+						matchSizeAxis++;
+				}
+				else if ((boardSquare != static_cast<char>(BoardSquare::Empty)) && (boardSquare != shipChar))
+				{
+					if (matchSizeAxis >= (maskEntry.first.col + 1))
+						adjacentShipsAxis = true;
+				}
+				else
+				{
+					wrongSizeAxis = true;
+				}
+			}
+			else if (maskChar != static_cast<char>(BoardSquare::Empty))
+			{
+				wrongSizeAxis = true;
+			}
+		}
+
+		bool MaskValidator::ShipMask::applyMask(const map<Coordinate, char>& boardMap, tuple<int, int, int> boardSize,
+												Coordinate coord, PlayerEnum player)
+		{
+			char shipChar = (player == PlayerEnum::A) ? static_cast<char>(maskType) :
+														static_cast<char>(tolower(static_cast<char>(maskType)));
+			int boardWidth = std::get<0>(boardSize);
+			int boardHeight = std::get<1>(boardSize);
+			int boardDepths = std::get<2>(boardSize);
+
+			int matchSizeXAxis = 1, matchSizeYAxis = 1, matchSizeZAxis = 1;
+			bool wrongSizeXAxis = false, wrongSizeYAxis = false, wrongSizeZAxis = false;
+			bool adjacentShipsXAxis = false, adjacentShipsYAxis = false, adjacentShipsZAxis = false;
+
+			auto squareAt = [&boardMap](const Coordinate& squareCoord)
+			{
+				auto square = boardMap.find(squareCoord);
+				return (square != boardMap.end()) ? square->second : static_cast<char>(BoardSquare::Empty);
+			};
+
+			for (const auto& maskEntry : mask)
+			{
+				int i = maskEntry.first.row;
+				int j = maskEntry.first.col;
+				int k = maskEntry.first.depth;
+				bool XAxisException = ((coord.row + i < 0) || (coord.row + i >= boardHeight) || (coord.col + j < 0) ||
+									   (coord.col + j >= boardWidth) || (coord.depth + k < 0) || (coord.depth + k >= boardDepths));
+				bool YAxisException = ((coord.row + j < 0) || (coord.row + j >= boardHeight) || (coord.col + i < 0) ||
+									   (coord.col + i >= boardWidth) || (coord.depth + k < 0) || (coord.depth + k >= boardDepths));
+				bool ZAxisException = ((coord.row + i < 0) || (coord.row + i >= boardHeight) || (coord.col + k < 0) ||
+									   (coord.col + k >= boardWidth) || (coord.depth + j < 0) || (coord.depth + j >= boardDepths));
+
+				applyMaskEntry(squareAt(Coordinate(coord.row + i, coord.col + j, coord.depth + k)), shipChar, maskEntry,
+							   XAxisException, matchSizeXAxis, wrongSizeXAxis, adjacentShipsXAxis);
+				applyMaskEntry(squareAt(Coordinate(coord.row + j, coord.col + i, coord.depth + k)), shipChar, maskEntry,
+							   YAxisException, matchSizeYAxis, wrongSizeYAxis, adjacentShipsYAxis);
+				applyMaskEntry(squareAt(Coordinate(coord.row + i, coord.col + k, coord.depth + j)), shipChar, maskEntry,
+							   ZAxisException, matchSizeZAxis, wrongSizeZAxis, adjacentShipsZAxis);
+			}
+
+			int maxMatchSize;
+			if (matchSizeXAxis < matchSizeYAxis)
+			{
+				maxMatchSize = matchSizeYAxis;
+				orient = Orientation::Y_AXIS;
+			}
+			else
+			{
+				maxMatchSize = matchSizeXAxis;
+				orient = Orientation::X_AXIS;
+			}
+
+			if (maxMatchSize < matchSizeZAxis)
+				orient = Orientation::Z_AXIS;
+
+			wrongSize = (wrongSizeXAxis && wrongSizeYAxis && wrongSizeZAxis);
+
+			if (!wrongSizeXAxis && wrongSizeYAxis && wrongSizeZAxis)
+				adjacentShips = adjacentShipsXAxis;
+			else if (!wrongSizeYAxis && wrongSizeXAxis && wrongSizeZAxis)
+				adjacentShips = adjacentShipsYAxis;
+			else if (!wrongSizeZAxis && wrongSizeXAxis && wrongSizeYAxis)
+				adjacentShips = adjacentShipsZAxis;
+			else
+				adjacentShips = (adjacentShipsXAxis || adjacentShipsYAxis || adjacentShipsZAxis);
+
+			return ((!wrongSizeXAxis && !adjacentShipsXAxis) || (!wrongSizeYAxis && !adjacentShipsYAxis) ||
+					(!wrongSizeZAxis && !adjacentShipsZAxis));
+		}
+
+		void MaskValidator::markVisitedCoords(unordered_set<Coordinate, CoordinateHash>& coordSet, Coordinate coord)
+		{
+			char ship = boardMap[coord];
+			int j = coord.col;
+			bool sameCharInRow = true;
+
+			while ((j < boardWidth) && sameCharInRow)
+			{
+				int i = coord.row;
+				bool sameCharInCol = true;
+				while ((i < boardHeight) && sameCharInCol)
+				{
+					int k = coord.depth;
+					bool sameCharInDepth = true;
+					while ((k < boardDepth) && sameCharInDepth)
+					{
+						Coordinate currCoord(i, j, k);
+						if ((boardMap.find(currCoord) != boardMap.end()) && (boardMap[currCoord] == ship))
+						{
+							coordSet.insert(currCoord);
+						}
+						else
+						{
+							sameCharInDepth = false;
+							if (k == coord.depth)
+							{
+								sameCharInCol = false;
+								if (i == coord.row)
+									sameCharInRow = false;
+							}
+						}
+						k++;
+					}
+					i++;
+				}
+				j++;
+			}
+		}
+
+		bool MaskValidator::isBalancedBoard(vector<BoardSquare>& playerAShips, vector<BoardSquare>& playerBShips)
+		{
+			if (playerAShips.empty() || playerBShips.empty())
+				return false;
+
+			for (const auto& AShip : playerAShips)
+			{
+				auto BShip = std::find(playerBShips.begin(), playerBShips.end(), AShip);
+				if (BShip == playerBShips.end())
+					return false;
+
+				playerBShips.erase(BShip);
+			}
+
+			return playerBShips.empty();
+		}
+
+		bool MaskValidator::isValidBoard(set<ErrorPriorityEnum>& errors, vector<BoardPiece>& pieces)
+		{
+			// Wrong size errors of player A's ships, in the order of the ship types. Player B's follow at +4.
+			static const map<BoardSquare, int> WRONG_SIZE_ERRORS = {
+				{ BoardSquare::RubberBoat, 0 }, { BoardSquare::RocketShip, 1 },
+				{ BoardSquare::Submarine, 2 }, { BoardSquare::Battleship, 3 }
+			};
+
+			tuple<int, int, int> boardSize = std::make_tuple(boardWidth, boardHeight, boardDepth);
+			bool validBoard = true;
+			unordered_set<Coordinate, CoordinateHash> visitedCoords;
+			vector<BoardSquare> playerAShips;
+			vector<BoardSquare> playerBShips;
+
+			for (const auto& square : boardMap)
+			{
+				if (visitedCoords.find(square.first) != visitedCoords.end())
+					continue;
+
+				PlayerEnum player = isupper(square.second) ? PlayerEnum::A : PlayerEnum::B;
+				BoardSquare ship = static_cast<BoardSquare>(toupper(square.second));
+				ShipMask shipMask(ship);
+
+				bool isMatch = shipMask.applyMask(boardMap, boardSize, square.first, player);
+				if (shipMask.wrongSize)
+				{
+					int error = WRONG_SIZE_ERRORS.at(ship) + ((player == PlayerEnum::A) ? 0 : 4);
+					errors.insert(static_cast<ErrorPriorityEnum>(error));
+				}
+
+				markVisitedCoords(visitedCoords, square.first);
+
+				if (!shipMask.wrongSize)
+				{
+					pieces.push_back(BoardPiece{ square.first, ship, player, shipMask.orient });
+					((player == PlayerEnum::A) ? playerAShips : playerBShips).push_back(ship);
+				}
+
+				if (!isMatch)
+				{
+					validBoard = false;
+					if (shipMask.adjacentShips)
+						errors.insert(ErrorPriorityEnum::ADJACENT_SHIPS_ON_BOARD);
+				}
+			}
+
+			if (pieces.empty())
+			{
+				validBoard = false;
+				errors.insert(ErrorPriorityEnum::NO_SHIPS_AT_ALL);
+			}
+			else if (!isBalancedBoard(playerAShips, playerBShips))
+			{	// Board is still valid
+				errors.insert(ErrorPriorityEnum::WRONG_SHIP_TYPES_FOR_BOTH_PLAYERS);
+			}
+
+			return validBoard;
+		}
+
+		/** Outcome of validating a board: whether it's valid, its errors (as messages, in priority order)
+		 *  and its pieces (ordered by first position, only when the board is valid)
+		 */
+		struct Validation
+		{
+			bool isValid;
+			vector<string> errors;
+			vector<tuple<Coordinate, char, int, int>> pieces; // First position, ship, player, orientation
+		};
+
+		Validation validateByMasks(const map<Coordinate, char>& boardMap, int width, int height, int depth)
+		{
+			Validation validation;
+			set<ErrorPriorityEnum> errors;
+			vector<BoardPiece> pieces;
+
+			validation.isValid = MaskValidator(boardMap, width, height, depth).isValidBoard(errors, pieces);
+			for (auto error : errors)
+				validation.errors.push_back(BoardBuilder::BoardInitializeError(error).getMsg());
+
+			if (validation.isValid)
+			{
+				for (const auto& piece : pieces)
+				{
+					validation.pieces.emplace_back(piece.firstPos, static_cast<char>(piece.ship),
+												   static_cast<int>(piece.player), static_cast<int>(piece.orientation));
+				}
+			}
+
+			std::sort(validation.pieces.begin(), validation.pieces.end());
+			return validation;
+		}
+
+		Validation validateByBuilder(const map<Coordinate, char>& boardMap, int width, int height, int depth)
+		{
+			Validation validation;
+			BoardBuilder builder(width, height, depth);
+			for (const auto& square : boardMap)
+				builder.addPiece(square.first, square.second);
+
+			auto board = builder.build(validation.errors);
+			validation.isValid = (board != nullptr);
+
+			if (validation.isValid)
+			{
+				for (const auto& piece : board->gamePiecesList())
+				{
+					validation.pieces.emplace_back(piece->_firstPos, static_cast<char>(piece->_shipType->_representation),
+												   static_cast<int>(piece->_player), static_cast<int>(piece->_orient));
+				}
+			}
+
+			std::sort(validation.pieces.begin(), validation.pieces.end());
+			return validation;
+		}
+
+		/** Returns a random board of up to 6x6x6 squares. Most squares are of straight ships of a random type,
+		 *  player and axis, placed anywhere (so they often touch or overlap), with a length that is sometimes off
+		 *  by one. Some single ship squares are scattered over them.
+		 */
+		map<Coordinate, char> randomBoard(std::mt19937& random, int& width, int& height, int& depth)
+		{
+			static const char SHIPS[] = { 'B', 'P', 'M', 'D' };
+			auto uniform = [&random](int min, int max) { return std::uniform_int_distribution<int>(min, max)(random); };
+
+			width = uniform(1, 6);
+			height = uniform(1, 6);
+			depth = uniform(1, 6);
+
+			map<Coordinate, char> boardMap;
+			int shipsCount = uniform(0, (width * height * depth) / 6 + 2);
+			for (int ship = 0; ship < shipsCount; ++ship)
+			{
+				int type = uniform(0, 3);
+				char square = (uniform(0, 1) == 0) ? SHIPS[type] : static_cast<char>(tolower(SHIPS[type]));
+				int length = type + 1 + ((uniform(0, 9) == 0) ? uniform(-1, 1) : 0);
+				int axis = uniform(0, 2);
+				Coordinate first(uniform(0, height - 1), uniform(0, width - 1), uniform(0, depth - 1));
+
+				for (int offset = 0; offset < length; ++offset)
+				{
+					Coordinate coord(first.row + ((axis == 1) ? offset : 0), first.col + ((axis == 0) ? offset : 0),
+									 first.depth + ((axis == 2) ? offset : 0));
+					if ((coord.row < height) && (coord.col < width) && (coord.depth < depth))
+						boardMap[coord] = square;
+				}
+			}
+
+			int scatteredCount = uniform(0, 2);
+			for (int scattered = 0; scattered < scatteredCount; ++scattered)
+			{
+				char square = SHIPS[uniform(0, 3)];
+				square = (uniform(0, 1) == 0) ? square : static_cast<char>(tolower(square));
+				boardMap[Coordinate(uniform(0, height - 1), uniform(0, width - 1), uniform(0, depth - 1))] = square;
+			}
+
+			return boardMap;
+		}
+
+		bool hasError(const Validation& validation, ErrorPriorityEnum error)
+		{
+			string message = BoardBuilder::BoardInitializeError(error).getMsg();
+			return std::find(validation.errors.begin(), validation.errors.end(), message) != validation.errors.end();
+		}
+
+		/** Returns true if squares of two different ships share a face */
+		bool hasTouchingShips(const map<Coordinate, char>& boardMap)
+		{
+			for (const auto& square : boardMap)
+			{
+				const Coordinate& coord = square.first;
+				for (const Coordinate& neighbour : { Coordinate(coord.row + 1, coord.col, coord.depth),
+													 Coordinate(coord.row, coord.col + 1, coord.depth),
+													 Coordinate(coord.row, coord.col, coord.depth + 1) })
+				{
+					auto neighbourSquare = boardMap.find(neighbour);
+					if ((neighbourSquare != boardMap.end()) && (neighbourSquare->second != square.second))
+						return true;
+				}
+			}
+
+			return false;
+		}
+
+		string boardText(const map<Coordinate, char>& boardMap, int width, int height, int depth)
+		{
+			string text = std::to_string(width) + "x" + std::to_string(height) + "x" + std::to_string(depth) + ":";
+			for (const auto& square : boardMap)
+				text += " " + string(1, square.second) + to_string(square.first);
+
+			return text;
+		}
+	}
+
+	void boardValidatorTests(unsigned int seed)
+	{
+		static constexpr int RANDOM_BOARDS_COUNT = 100000;
+
+		std::mt19937 random(seed);
+		int validCount = 0;
+		int changedErrorsCount = 0;
+
+		for (int boardIndex = 0; boardIndex < RANDOM_BOARDS_COUNT; ++boardIndex)
+		{
+			int width, height, depth;
+			map<Coordinate, char> boardMap = randomBoard(random, width, height, depth);
+
+			Validation byMasks = validateByMasks(boardMap, width, height, depth);
+			Validation byBuilder = validateByBuilder(boardMap, width, height, depth);
+			string board = boardText(boardMap, width, height, depth);
+
+			// The same boards are valid, with the same pieces and warnings
+			if (!TestRunner::check(byMasks.isValid == byBuilder.isValid, "Validity differs on board " + board))
+				continue;
+
+			if (byMasks.isValid)
+			{
+				validCount++;
+				TestRunner::check(byMasks.pieces == byBuilder.pieces, "Pieces differ on board " + board);
+				TestRunner::check(byMasks.errors == byBuilder.errors, "Warnings differ on board " + board);
+				continue;
+			}
+
+			// An invalid board reports every wrong size error the masks found, and possibly more (see below)
+			for (int error = static_cast<int>(ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_B_PLAYER_A);
+				 error <= static_cast<int>(ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_D_PLAYER_B); ++error)
+			{
+				TestRunner::check(!hasError(byMasks, static_cast<ErrorPriorityEnum>(error)) ||
+								  hasError(byBuilder, static_cast<ErrorPriorityEnum>(error)),
+								  "Missing wrong size error on board " + board);
+			}
+
+			// Adjacent ships are reported exactly when two ships share a face. The masks also flagged ships that
+			// only touch a ship of a wrong shape diagonally (see below), so they aren't the reference here.
+			// The ship count errors (unbalanced players, no ships) count only the ships of the right size, so they
+			// change along with the wrong size errors.
+			TestRunner::check(hasError(byBuilder, ErrorPriorityEnum::ADJACENT_SHIPS_ON_BOARD) == hasTouchingShips(boardMap),
+							  "Adjacent ships error mismatch on board " + board);
+			changedErrorsCount += (byBuilder.errors != byMasks.errors) ? 1 : 0;
+		}
+
+		cout << "validator: " << validCount << " of " << RANDOM_BOARDS_COUNT << " random boards are valid, "
+			 << changedErrorsCount << " invalid boards report other errors than before" << endl;
+
+		// Intended deviation: the masks missed a ship that is too short when another ship fills its next square,
+		// such as a single 'p' next to a 'b'. Both validators reject the board, only the new one says why.
+		{
+			map<Coordinate, char> boardMap = { { Coordinate(0, 0, 0), 'p' }, { Coordinate(0, 1, 0), 'b' },
+											   { Coordinate(2, 0, 0), 'P' }, { Coordinate(2, 1, 0), 'P' },
+											   { Coordinate(2, 3, 0), 'B' } };
+			Validation byMasks = validateByMasks(boardMap, 4, 3, 1);
+			Validation byBuilder = validateByBuilder(boardMap, 4, 3, 1);
+
+			TEST_CHECK(!byMasks.isValid && !byBuilder.isValid);
+			TEST_CHECK(!hasError(byMasks, ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_P_PLAYER_B));
+			TEST_CHECK(hasError(byBuilder, ErrorPriorityEnum::WRONG_SIZE_SHAPE_FOR_SHIP_P_PLAYER_B));
+		}
+
+		// Intended deviation: a mask counted squares of the same ship type that weren't connected to the ship, so a
+		// ship of a wrong shape was reported as adjacent to a ship it only touches diagonally
+		{
+			map<Coordinate, char> boardMap = { { Coordinate(0, 2, 0), 'B' }, { Coordinate(1, 1, 0), 'M' },
+											   { Coordinate(1, 3, 0), 'M' } };
+			Validation byMasks = validateByMasks(boardMap, 4, 2, 1);
+			Validation byBuilder = validateByBuilder(boardMap, 4, 2, 1);
+
+			TEST_CHECK(!byMasks.isValid && !byBuilder.isValid);
+			TEST_CHECK(hasError(byMasks, ErrorPriorityEnum::ADJACENT_SHIPS_ON_BOARD));
+			TEST_CHECK(!hasError(byBuilder, ErrorPriorityEnum::ADJACENT_SHIPS_ON_BOARD));
+		}
+
+		// Intended deviation: squares past the declared dimensions (the parser reads an extra row) used to become
+		// pieces that could never be attacked, they are no longer part of the board
+		{
+			map<Coordinate, char> boardMap = { { Coordinate(0, 0, 0), 'B' }, { Coordinate(0, 2, 0), 'b' },
+											   { Coordinate(2, 0, 0), 'B' } };
+			Validation byMasks = validateByMasks(boardMap, 3, 2, 1);
+			Validation byBuilder = validateByBuilder(boardMap, 3, 2, 1);
+
+			TEST_CHECK(byMasks.isValid && byBuilder.isValid);
+			TEST_CHECK(byMasks.pieces.size() == 3);
+			TEST_CHECK(byBuilder.pieces.size() == 2);
+			TEST_CHECK(byBuilder.errors.empty()); // The extra square no longer unbalances the players' ships
+		}
+	}
+}
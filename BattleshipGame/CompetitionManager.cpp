@@ -1,9 +1,12 @@
 #include "CompetitionManager.h"
 #include "Logger.h"
+#include "EventLog.h"
 #include <string>
 #include <algorithm>
+#include <chrono>
 
 using std::lock_guard;
+using std::unique_lock;
 using std::to_string;
 using std::min;
 using std::max;
@@ -11,94 +14,302 @@ using std::max;
 namespace battleship
 {
 	void CompetitionManager::prepareCompetition(shared_ptr<BattleshipGameBoardFactory> boardLoader,
-												shared_ptr<AlgoLoader> algoLoader)
+												shared_ptr<AlgoLoader> algoLoader,
+												const Configuration& config)
 	{
 		auto boards = boardLoader->loadedBoardsList(); // Valid boards
 		auto algos = algoLoader->loadedGameAlgos(); // Valid loaded algorithms
 
-		// Total games for each player: play twice against each player other player on each board
-		auto totalRounds = (algos.size() - 1) * 2 * boards.size();
+		if (config.preview.isEnabled)
+		{
+			// Quick preview on a sample of the boards, stratified by board dimensions
+			map<string, vector<string>> boardsByDimensions;
+			for (const auto& board : boards)
+			{
+				int width = 0, height = 0, depth = 0;
+				boardLoader->boardDimensions(board, width, height, depth);
+				boardsByDimensions[to_string(height) + "x" + to_string(width) + "x" + to_string(depth)].push_back(board);
+			}
+
+			vector<vector<string>> strata;
+			for (const auto& stratum : boardsByDimensions)
+				strata.push_back(stratum.second);
+
+			_format = std::make_unique<BoardSamplingFormat>(algos, strata, config.preview);
+		}
+		else
+		{
+			_format = TournamentFormat::create(config.tournament, algos, boards);
+		}
 
-		// Reset scoreboard (casting totalRounds to int is safe since we don't expect that many games)
-		_scoreboard = std::make_unique<Scoreboard>(algos, static_cast<int>(totalRounds));
-		
-		// Iterate all boards and players and create SingleGameTask for each valid combination
-		queue<unique_ptr<SingleGameTask>> inversedGamesSet;
-		size_t numOfAlgos = algos.size() - 1;
-		for (const auto& board : boards)
+		// Reset scoreboard with the most games a player may play in this format
+		_scoreboard = std::make_unique<Scoreboard>(algos, _format->maxRoundsPerPlayer(), config.renderFps);
+
+		// Fill queue with the games of the first stage, later stages depend on its results
+		scheduleNextStage();
+	}
+
+	bool CompetitionManager::scheduleNextStage()
+	{
+		// The next stage is built from the standings, so apply all results published by the workers first
+		_scoreboard->drainPublishedResults();
+
+		TournamentStage stage;
+
+		// Stages that consist of byes only have no games to wait for, so move on to the next one
+		while (stage.games.empty())
+		{
+			stage = TournamentStage();
+			bool isScheduled = _format->nextStage(_scoreboard->standings(), stage);
+
+			// Rounds stop waiting for retired players since they won't have more games scheduled
+			for (const auto& player : stage.retiredPlayers)
+				Logger::getInstance().log(Severity::INFO_LEVEL, "Player " + player + " is out of the tournament");
+
+			if (!isScheduled)
+				return false;
+
+			for (const auto& bye : stage.byes)
+				_scoreboard->recordBye(bye.first, bye.second);
+		}
+
+		for (const auto& game : stage.games)
+		{
+			_scoreboard->expectGames(game->playerAName(), 1);
+			_scoreboard->expectGames(game->playerBName(), 1);
+		}
+
+		// Games are planned and queued at once, so workers can't finish the stage before it's fully queued
+		{
+			lock_guard<mutex> lock(_gameSetLock);
+			for (auto& game : stage.games)
+				enqueueGame(std::move(game));
+		}
+
+		_gameSetCV.notify_all();
+		return true;
+	}
+
+	void CompetitionManager::finishTournament()
+	{
 		{
-			// Each round is a diagonal in the game matrix (without the main diagonal),
-			// and we run over it from both sides in order to get a balanced tournament 
-			for (size_t round = 1; round <= numOfAlgos; ++round)
+			lock_guard<mutex> lock(_gameSetLock);
+			_isTournamentOver = true;
+		}
+
+		_gameSetCV.notify_all();
+
+		if (_isEarlyStop)
+		{
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Early stopping skipped " + to_string(_skippedGames.load()) +
+									  " games of settled matchups", true); // true = Print to log & console
+		}
+
+		if (_symmetricGames != nullptr)
+		{
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Symmetric boards saved " + to_string(_symmetricGames->savedGames()) +
+									  " games, credited from the same game on a mirrored or rotated board",
+									  true); // true = Print to log & console
+		}
+
+		Logger::getInstance().log(Severity::INFO_LEVEL, _scoreboard->ratings().report(), true);
+
+		string summary = _format->summary();
+		if (!summary.empty())
+			Logger::getInstance().log(Severity::INFO_LEVEL, summary, true); // true = Print to log & console
+	}
+
+	void CompetitionManager::enqueueGame(unique_ptr<SingleGameTask> game)
+	{
+		_progress.addPlannedGame(game->boardName());
+		_gamesSet.push(std::move(game));
+	}
+
+	unique_ptr<SingleGameTask> CompetitionManager::fetchNextGame(size_t workerIndex)
+	{
+		while (true)
+		{
+			unique_ptr<SingleGameTask> task;
+			vector<unique_ptr<SingleGameTask>> skippedTasks;
+
 			{
-				for (size_t algo1 = 0, algo2 = round; ((algo1 <= (numOfAlgos - algo2)) && (algo2 <= numOfAlgos)); ++algo1, ++algo2)
+				// Protect the game-set queue from concurrent access, each worker fetches a task and releases the lock.
+				// Between stages the queue is empty until the main thread schedules the next stage.
+				unique_lock<mutex> lock(_gameSetLock);
+
+				_gameSetCV.wait(lock, [this] { return !_gamesSet.empty() || _isTournamentOver; });
+				if (_gamesSet.empty())
+					return nullptr;
+
+				// Pop next game task from game-queue, games of settled matchups are set aside on the way.
+				// Games are expected to be pre-sorted in a fair manner for all players.
+				while (!_gamesSet.empty() && (task == nullptr))
 				{
-					_gamesSet.push(std::make_unique<SingleGameTask>(algos[algo1], algos[algo2], board));
-					inversedGamesSet.push(std::make_unique<SingleGameTask>(algos[algo2], algos[algo1], board));
-					if (algo1 != (numOfAlgos - algo2))	// On the secondary diagonal 'algo1' and 'numOfAlgos-algo2' indices meet
-														// and we don't want to add them twice
+					unique_ptr<SingleGameTask> next = std::move(_gamesSet.front());
+					_gamesSet.pop();
+
+					if (!_isEarlyStop || !_scoreboard->ratings().isMatchupSettled(next->playerAName(), next->playerBName()))
+					{
+						_progress.onGameStarted();
+						task = std::move(next);
+					}
+					else
 					{
-						_gamesSet.push(std::make_unique<SingleGameTask>(algos[numOfAlgos-algo2], algos[numOfAlgos-algo1], board));
-						inversedGamesSet.push(std::make_unique<SingleGameTask>(algos[numOfAlgos-algo1], algos[numOfAlgos-algo2], board));
+						skippedTasks.push_back(std::move(next));
 					}
 				}
 			}
-		}
 
-		// Move inversed games to the main queue
-		while (!inversedGamesSet.empty())
-		{
-			_gamesSet.push(std::move(inversedGamesSet.front()));
-			inversedGamesSet.pop();
+			// Publishing may wait for the main thread to drain the worker's ring, so it's done without the lock
+			for (auto& skippedTask : skippedTasks)
+				skipGame(workerIndex, std::move(skippedTask));
+
+			if (task != nullptr)
+				return task;
 		}
 	}
 
+	void CompetitionManager::skipGame(size_t workerIndex, unique_ptr<SingleGameTask> task)
+	{
+		LOG_DEBUG_EVENT(LogEvent::GAME_SKIPPED, EventLog::getInstance().playerId(task->playerAName()),
+						EventLog::getInstance().playerId(task->playerBName()), EventLog::getInstance().boardId(task->boardName()));
+
+		_skippedGames++;
+		string boardName = task->boardName();
+
+		// The main thread cancels the expected games of both players when it drains the skip
+		_scoreboard->publishSkippedGame(workerIndex, std::move(task));
+
+		// Skipping the last game of a stage releases the latch just like finishing it
+		if (_progress.onGameSkipped(boardName))
+			_scoreboard->notifyGamesFinished();
+	}
+
 	CompetitionManager::CompetitionManager(shared_ptr<BattleshipGameBoardFactory> boardLoader,
 										   shared_ptr<AlgoLoader> algoLoader,
-										   int threadCount):
+										   const Configuration& config):
 										   _boardLoader(boardLoader),
-										   _algoLoader(algoLoader)
+										   _algoLoader(algoLoader),
+										   _isTournamentOver(false),
+										   _isEarlyStop(config.isEarlyStop),
+										   _skippedGames(0),
+										   _placement(config.placement)
 	{
-		// Fill priority queue with tasks for all possible games in competition
-		prepareCompetition(boardLoader, algoLoader);
+		// Events refer to players and boards by id, they are assigned before any game is created
+		EventLog::getInstance().registerNames(algoLoader->loadedGameAlgos(), boardLoader->loadedBoardsList());
+
+		// Fill queue with tasks for the first stage of the tournament
+		prepareCompetition(boardLoader, algoLoader, config);
+
+		size_t threadCount = static_cast<size_t>(config.threads);
+		bool isAdaptiveThreadCount = config.isAutoThreads;
+
+		if (config.isResourceAware)
+		{
+			_resourceScheduler = std::make_unique<ResourceAwareScheduler>(boardLoader, algoLoader);
+		}
+
+		// Only kept if there are symmetric boards and symmetry invariant players
+		_symmetricGames = std::make_unique<SymmetricGamesCache>(boardLoader, algoLoader);
+		if (!_symmetricGames->isEffective())
+			_symmetricGames = nullptr;
+
+		// Adaptive pool starts from threadCount workers, but may grow beyond it
+		size_t maxThreadCount = isAdaptiveThreadCount ? (threadCount * MAX_ADAPTIVE_THREADS_FACTOR) : threadCount;
 
 		// Don't use more threads than needed, even if count says so
-		_workerThreadsCount = threadCount < _gamesSet.size() ? 
-							  threadCount : _gamesSet.size();
+		_workerThreadsCount = maxThreadCount < _gamesSet.size() ?
+							  maxThreadCount : _gamesSet.size();
 		_workerThreads.reserve(_workerThreadsCount);
+
+		_workerPool = std::make_unique<AdaptiveWorkerPool>(_workerThreadsCount, threadCount, isAdaptiveThreadCount);
+
+		// Each worker publishes its game results to a ring of its own
+		_scoreboard->registerWorkers(_workerThreadsCount);
+
+		// Records of games and rounds are exported by the main thread as it drains the results
+		if (config.exportSettings.format != ExportFormat::NONE)
+		{
+			_exporter = std::make_unique<ResultsExporter>(config.exportSettings, config.path);
+			_scoreboard->setExporter(_exporter.get());
+		}
+
+		if (!config.resultsStore.empty())
+		{
+			_resultsStore = std::make_unique<ResultsStoreWriter>(config.path + "\\" + config.resultsStore);
+			if (_resultsStore->isOpen())
+			{
+				_scoreboard->setResultsStore(_resultsStore.get());
+			}
+			else
+			{
+				Logger::getInstance().log(Severity::WARNING_LEVEL,
+										  "Results store " + config.resultsStore + " could not be opened, games won't be stored",
+										  true); // true = Print to log & console
+				_resultsStore = nullptr;
+			}
+		}
 	}
 
 	void CompetitionManager::runWorkerThread(shared_ptr<BattleshipGameBoardFactory> boardLoader,
 											 shared_ptr<AlgoLoader> algoLoader,
 											 int threadId)
 	{
+		// Pin the worker before it allocates anything, so its resources are committed on the
+		// NUMA node it runs on and stay warm in its caches for the rest of the competition
+		_placement.pinCurrentThread(threadId - 1);
+
 		// Each thread keeps it's own pool of resources that are created on demand,
 		// to avoid wasting time on locking shared resources between multiple threads
 		WorkerThreadResourcePool resourcePool(boardLoader, algoLoader);
 
 		Logger::getInstance().log(Severity::INFO_LEVEL, "Worker thread #" + to_string(threadId) + " started..");
 
-		while (!_gamesSet.empty()) // While there are still games to be played
+		while (true)
 		{
-			unique_ptr<SingleGameTask> task;
+			// Park here while this worker is outside of the pool's active set
+			_workerPool->waitUntilActive(threadId - 1);
 
-			// Protect the game-set queue from concurrent access, each worker fetches a task and releases the lock
-			{
-				lock_guard<mutex> lock(_gameSetLock);
-				if (_gamesSet.empty()) // Check that nobody stole the last game before the snatched the lock
-					break;
+			// The queue is only checked under its lock, nullptr means all games were handed out
+			unique_ptr<SingleGameTask> task = fetchNextGame(threadId - 1);
+			if (task == nullptr)
+				break;
 
-				// Pop next game task from game-queue.
-				// Games are expected to be pre-sorted in a fair manner for all players.
-				task = std::move(_gamesSet.front());
-				_gamesSet.pop();
-			}
+			GameResults results;
+			double gameSeconds = 0;
 
-			// Lock is released and the thread now runs the game the task represents
-			if (task != nullptr)
+			// A game credited from an equivalent game takes no resources, so it isn't admitted.
+			// It isn't timed either, its duration is reported as 0 and left out of the timing averages.
+			bool isCredited = (_symmetricGames != nullptr) && _symmetricGames->findResults(*task, results);
+			if (!isCredited)
 			{
-				task->run(resourcePool, _scoreboard.get());
+				// Wait until the game fits the host's free resources
+				if (_resourceScheduler != nullptr)
+					_resourceScheduler->admit(task->playerAName(), task->playerBName());
+
+				auto gameStart = std::chrono::steady_clock::now();
+				results = task->run(resourcePool);
+				gameSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - gameStart).count();
+
+				if (_resourceScheduler != nullptr)
+					_resourceScheduler->release(task->playerAName(), task->playerBName());
+
+				if (_symmetricGames != nullptr)
+					_symmetricGames->storeResults(*task, results);
 			}
+
+			_format->recordGame(*task, results);
+
+			// Results must be published before the game counts as finished,
+			// so the main thread finds them all once the stage is completed
+			string boardName = task->boardName();
+			_scoreboard->publishGameResults(threadId - 1, std::move(task), results, gameSeconds);
+
+			// The worker that finishes the last scheduled game wakes up the main thread
+			if (_progress.onGameFinished(boardName, gameSeconds, isCredited))
+				_scoreboard->notifyGamesFinished();
 		}
 
 		Logger::getInstance().log(Severity::INFO_LEVEL, "Worker thread #" + to_string(threadId) + " finished..");
@@ -117,17 +328,26 @@ namespace battleship
 		Logger::getInstance().log(Severity::INFO_LEVEL,
 								  "Competition started with " + 
 								  to_string(_gamesSet.size()) +
-			                      " games run by " +
+			                      " games in the first stage run by " +
 								  to_string(_workerThreadsCount) +
 								  " threads.");
 
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  _placement.topologyReport(static_cast<int>(_workerThreadsCount)));
+
+		// Calibration games run here, before any worker competes with them for resources
+		if (_resourceScheduler != nullptr)
+		{
+			_resourceScheduler->prepareProfiles(_algoLoader->loadedGameAlgos());
+		}
+
 		// Start all worker threads
 		for (int threadId = 1; threadId <= _workerThreadsCount; threadId++)
 		{
 			// This statement takes care of the edge case where we have too many worker threads running.
 			// If all existing worker threads have already drained the game tasks queue there is no point
 			// in creating any additional threads that will do nothing
-			if (!_gamesSet.empty())
+			if (_progress.remainingGames() > 0)
 			{
 				_workerThreads.push_back(std::move(thread(&CompetitionManager::runWorkerThread,
 										 this, _boardLoader, _algoLoader, threadId)));
@@ -140,22 +360,35 @@ namespace battleship
 			}
 		}
 
-		// While competition is not over, wake up when round results are ready and print them
-		while (!_gamesSet.empty())
+		// While competition is not over, wake up when round results are ready and print them.
+		// The worker that finishes the last scheduled game releases the latch and wakes up the main thread,
+		// which then schedules the next stage of the tournament (if any).
+		while (true)
 		{
 			// Wait on conditional_variable predicate and wake up when some round results are ready
 			// Then print all ready round results from the scoreboard and drain the RoundResults queue
 			_scoreboard->waitOnRoundResults();
+
+			// Let the pool resize itself according to the throughput measured so far
+			_workerPool->sample(_progress.completedGames());
+
+			string progressLine = _progress.progressReport(_workerPool->activeWorkers(), PROGRESS_REPORT_INTERVAL_MILLIS);
+			if (!progressLine.empty())
+				Logger::getInstance().log(Severity::INFO_LEVEL, progressLine);
+
+			if (_progress.isCompleted() && !scheduleNextStage())
+				break;
 		}
 
-		// Drain any existing round results in queue and report to screen / log.
-		// Make sure to lock the results queue since the _gameSet may have been drained but it's
-		// possible some worker threads are still executing their games.
-		// This print command exists to take care of the edge case where too many threads exist and the
-		// gameSet is drained before the main thread have had a chance to print results even once.
-		// We give it some time to print the ready round results here, before waiting for all worker threads
-		// to finish
+		// Draw the latest round before anything else is printed below the results table
 		_scoreboard->processRoundResultsQueue(true);
+		_scoreboard->finishRendering();
+
+		Logger::getInstance().log(Severity::INFO_LEVEL, _progress.progressReport(0, 0));
+
+		// All games are over, release waiting and parked workers so they can exit
+		finishTournament();
+		_workerPool->shutdown();
 
 		// Wait for all worker threads to finish
 		for (auto& worker : _workerThreads)
@@ -166,8 +399,23 @@ namespace battleship
 			}
 		}
 
-		// Drain any remaining round results in queue and report to screen / log,
-		// without locking the results queue since the game is finished
+		// Drain any remaining results and round results in queue and report to screen / log,
+		// without locking the results queue since all workers are done
+		_scoreboard->drainPublishedResults();
 		_scoreboard->processRoundResultsQueue(false);
+		_scoreboard->finishRendering();
+
+		// All records are in, write them out before the competition is reported as over
+		if (_exporter != nullptr)
+		{
+			_scoreboard->setExporter(nullptr);
+			_exporter->close();
+		}
+
+		if (_resultsStore != nullptr)
+		{
+			_scoreboard->setResultsStore(nullptr);
+			_resultsStore->close();
+		}
 	}
 }
\ No newline at end of file
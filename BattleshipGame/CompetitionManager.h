@@ -5,10 +5,20 @@
 #include <queue>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <condition_variable>
 #include "SingleGameTask.h"
 #include "Scoreboard.h"
 #include "AlgoLoader.h"
 #include "BattleshipGameBoardFactory.h"
+#include "WorkerThreadPlacement.h"
+#include "AdaptiveWorkerPool.h"
+#include "ResourceAwareScheduler.h"
+#include "SymmetricGamesCache.h"
+#include "CompetitionProgress.h"
+#include "TournamentFormat.h"
+#include "BoardSamplingFormat.h"
+#include "Configuration.h"
 
 using std::vector;
 using std::queue;
@@ -16,6 +26,7 @@ using std::shared_ptr;
 using std::unique_ptr;
 using std::thread;
 using std::mutex;
+using std::condition_variable;
 
 namespace battleship
 {
@@ -25,17 +36,20 @@ namespace battleship
 	{
 	public:
 		/** Creates a new CompetitionManager which loads resources using the boardLoader and algoLoader.
-		 *  threadCount is the amount of threads used to run games in parallel.
+		 *  config defines how the competition is run: the amount of threads used to run games in parallel
+		 *  (fixed or adaptive), their placement on the host's cores and how games are scheduled.
 		 */
 		CompetitionManager(shared_ptr<BattleshipGameBoardFactory> boardLoader,
 						   shared_ptr<AlgoLoader> algoLoader,
-						   int threadCount);
+						   const Configuration& config);
 		virtual ~CompetitionManager() = default;
 
 		/** Start digesting priority queue of games by worker threads and print round results when ready */
 		void run();
 
-		/** Logic for a single worker thread: constantly drain and process SingleGameTasks from gameSet until empty */
+		/** Logic for a single worker thread: constantly drain and process SingleGameTasks from gameSet until
+		 *  the tournament is over
+		 */
 		void runWorkerThread(shared_ptr<BattleshipGameBoardFactory> boardLoader,
 							 shared_ptr<AlgoLoader> algoLoader, int threadId);
 
@@ -47,7 +61,7 @@ namespace battleship
 		queue<unique_ptr<SingleGameTask>> _gamesSet;
 
 		/** Scoreboard of in game results for each round.
-		 *  Functions relevant for competition time are protected by locks to enable concurrency.
+		 *  Workers publish results to it lock-free, the main thread applies and reports them.
 		 */
 		unique_ptr<Scoreboard> _scoreboard;
 
@@ -63,11 +77,77 @@ namespace battleship
 		/** Locks the gameSet when multiple threads aim to pull from it */
 		mutex _gameSetLock;
 
+		/** Wakes up workers waiting for the next stage of the tournament (or for its end) */
+		condition_variable _gameSetCV;
+
+		/** Set once the tournament has no more stages (protected by _gameSetLock) */
+		bool _isTournamentOver;
+
+		/** Builds the tournament stage by stage according to the configured format */
+		unique_ptr<TournamentFormat> _format;
+
+		/** If true, games between players whose matchup is statistically settled are skipped */
+		bool _isEarlyStop;
+
+		/** Number of games skipped by early stopping */
+		std::atomic<size_t> _skippedGames;
+
 		/** Number of actual worker threads the competition manager employs */
 		size_t _workerThreadsCount;
 
-		/** Creates priority queue of games to run */
+		/** Pins worker threads to the host's cores according to the configured policy */
+		WorkerThreadPlacement _placement;
+
+		/** Controls which of the worker threads are allowed to run games (all of them, unless adaptive) */
+		unique_ptr<AdaptiveWorkerPool> _workerPool;
+
+		/** Admits games only while they fit the host's resources (nullptr if scheduling isn't resource aware) */
+		unique_ptr<ResourceAwareScheduler> _resourceScheduler;
+
+		/** Credits games on symmetric boards from an equivalent game (nullptr if no games may be credited) */
+		unique_ptr<SymmetricGamesCache> _symmetricGames;
+
+		/** Streams records of games and rounds to files (nullptr if results aren't exported) */
+		unique_ptr<ResultsExporter> _exporter;
+
+		/** Appends every game outcome to the columnar results store (nullptr if there is no store) */
+		unique_ptr<ResultsStoreWriter> _resultsStore;
+
+		/** Completed / in flight / remaining games counters, per board game times and the completion latch */
+		CompetitionProgress _progress;
+
+		/** In adaptive mode, the pool may grow up to this factor times the initial threads count */
+		static constexpr size_t MAX_ADAPTIVE_THREADS_FACTOR = 2;
+
+		/** Minimal time between two progress lines reported by the main thread */
+		static constexpr int PROGRESS_REPORT_INTERVAL_MILLIS = 5000;
+
+		/** Creates the tournament format (or the board sampling preview) and the queue of games for its
+		 *  first stage
+		 */
 		void prepareCompetition(shared_ptr<BattleshipGameBoardFactory> boardLoader,
-							    shared_ptr<AlgoLoader> algoLoader);
+							    shared_ptr<AlgoLoader> algoLoader,
+								const Configuration& config);
+
+		/** Queues the games of the next tournament stage, and applies its byes.
+		 *  Must be called only when all scheduled games are finished.
+		 *  Returns false if the tournament is over.
+		 */
+		bool scheduleNextStage();
+
+		/** Releases workers waiting for more games and logs the final placements of the tournament */
+		void finishTournament();
+
+		/** Appends the game to the games queue and registers it as planned in the competition progress */
+		void enqueueGame(unique_ptr<SingleGameTask> game);
+
+		/** Pops the next game from the games queue, returns nullptr if no games are left.
+		 *  In early stopping mode, games of settled matchups are skipped on the way.
+		 *  This method is thread safe, skipped games are published to the ring of workerIndex.
+		 */
+		unique_ptr<SingleGameTask> fetchNextGame(size_t workerIndex);
+
+		/** Drops a game that won't be played. Expects _gameSetLock not to be held, publishing may block. */
+		void skipGame(size_t workerIndex, unique_ptr<SingleGameTask> task);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "CompetitionProgress.h"
+#include <sstream>
+#include <iomanip>
+
+using std::lock_guard;
+using std::stringstream;
+using std::setw;
+using std::setfill;
+using std::setprecision;
+using std::fixed;
+
+namespace battleship
+{
+	CompetitionProgress::CompetitionProgress() :
+		_plannedGames(0),
+		_completedGames(0),
+		_inFlightGames(0),
+		_remainingGames(0),
+		_startTime(std::chrono::steady_clock::now()),
+		_lastReportTime(_startTime),
+		_isReportedOnce(false)
+	{
+	}
+
+	void CompetitionProgress::addPlannedGame(const string& boardName)
+	{
+		{
+			lock_guard<mutex> lock(_boardTimesLock);
+			_boardTimes[boardName].plannedGames++;
+		}
+
+		// Throughput is measured from the moment the first game is planned
+		if (_plannedGames++ == 0)
+			_startTime = std::chrono::steady_clock::now();
+
+		_remainingGames++;
+	}
+
+	void CompetitionProgress::onGameStarted()
+	{
+		_remainingGames--;
+		_inFlightGames++;
+	}
+
+	bool CompetitionProgress::onGameFinished(const string& boardName, double durationSeconds, bool isCredited)
+	{
+		{
+			lock_guard<mutex> lock(_boardTimesLock);
+			BoardTimes& times = _boardTimes[boardName];
+			times.finishedGames++;
+
+			if (!isCredited)
+			{
+				times.timedGames++;
+				times.totalSeconds += durationSeconds;
+			}
+		}
+
+		_inFlightGames--;
+
+		// Only a single worker can observe the counter reaching the total
+		return (++_completedGames == _plannedGames);
+	}
+
+	bool CompetitionProgress::onGameSkipped(const string& boardName)
+	{
+		{
+			lock_guard<mutex> lock(_boardTimesLock);
+			_boardTimes[boardName].plannedGames--;
+		}
+
+		_remainingGames--;
+
+		// A worker finishing the last running game at the same time sees the updated total,
+		// or we see its completed game
+		return (--_plannedGames == _completedGames);
+	}
+
+	bool CompetitionProgress::isCompleted() const
+	{
+		return (_completedGames >= _plannedGames);
+	}
+
+	size_t CompetitionProgress::completedGames() const
+	{
+		return _completedGames;
+	}
+
+	size_t CompetitionProgress::inFlightGames() const
+	{
+		return _inFlightGames;
+	}
+
+	size_t CompetitionProgress::remainingGames() const
+	{
+		return _remainingGames;
+	}
+
+	double CompetitionProgress::estimateRemainingSeconds(size_t activeWorkers)
+	{
+		lock_guard<mutex> lock(_boardTimesLock);
+
+		// Boards with no timed games yet are estimated by the average time of all games
+		size_t allTimed = 0;
+		double allSeconds = 0;
+		for (const auto& boardEntry : _boardTimes)
+		{
+			allTimed += boardEntry.second.timedGames;
+			allSeconds += boardEntry.second.totalSeconds;
+		}
+
+		if (allTimed == 0)
+			return -1; // Nothing to base an estimation on yet
+
+		double averageSeconds = allSeconds / allTimed;
+		double remainingSeconds = 0;
+
+		for (const auto& boardEntry : _boardTimes)
+		{
+			const BoardTimes& times = boardEntry.second;
+			size_t unfinished = times.plannedGames - times.finishedGames;
+			double boardAverage = (times.timedGames > 0) ? (times.totalSeconds / times.timedGames) : averageSeconds;
+			remainingSeconds += unfinished * boardAverage;
+		}
+
+		return remainingSeconds / ((activeWorkers > 0) ? activeWorkers : 1);
+	}
+
+	string CompetitionProgress::formatDuration(double seconds)
+	{
+		long long totalSeconds = static_cast<long long>(seconds + 0.5);
+		stringstream ss;
+		ss << setfill('0') << setw(2) << (totalSeconds / 3600) << ":"
+		   << setw(2) << ((totalSeconds / 60) % 60) << ":"
+		   << setw(2) << (totalSeconds % 60);
+		return ss.str();
+	}
+
+	string CompetitionProgress::progressReport(size_t activeWorkers, int minIntervalMillis)
+	{
+		auto now = std::chrono::steady_clock::now();
+		auto sinceLastReport = std::chrono::duration_cast<std::chrono::milliseconds>(now - _lastReportTime).count();
+
+		// Throttle progress lines
+		if (_isReportedOnce && (sinceLastReport < minIntervalMillis))
+			return "";
+
+		_lastReportTime = now;
+		_isReportedOnce = true;
+
+		size_t planned = _plannedGames;
+		size_t completed = _completedGames;
+		double elapsedSeconds = std::chrono::duration<double>(now - _startTime).count();
+		double gamesPerSecond = (elapsedSeconds > 0) ? (completed / elapsedSeconds) : 0;
+		double percent = (planned > 0) ? (100.0 * completed / planned) : 100.0;
+		double etaSeconds = estimateRemainingSeconds(activeWorkers);
+
+		stringstream ss;
+		ss << "Progress: " << completed << "/" << planned << " games completed (" << fixed << setprecision(1)
+		   << percent << "%), " << _inFlightGames << " in flight, " << _remainingGames << " remaining, "
+		   << setprecision(2) << gamesPerSecond << " games/sec, elapsed " << formatDuration(elapsedSeconds)
+		   << ", ETA " << ((etaSeconds < 0) ? string("unknown") : formatDuration(etaSeconds));
+
+		return ss.str();
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+using std::atomic;
+using std::mutex;
+using std::string;
+using std::unordered_map;
+
+namespace battleship
+{
+	/** Tracks the progress of the competition: how many games were completed, are in flight or still remain,
+	 *  and the time games take on each board. Used as a completion latch (the competition is over once
+	 *  all planned games are completed) and for reporting throughput and an estimated time of arrival.
+	 *  Counters are atomic so worker threads update them without taking locks,
+	 *  only the per-board timing statistics are protected by a lock.
+	 */
+	class CompetitionProgress
+	{
+	public:
+		CompetitionProgress();
+		virtual ~CompetitionProgress() = default;
+
+		/** Registers a game planned on the given board. Games may be planned in stages, as long as a stage is
+		 *  fully planned before any of its games is started.
+		 */
+		void addPlannedGame(const string& boardName);
+
+		/** A worker fetched a game and starts running it */
+		void onGameStarted();
+
+		/** A worker finished running a game on the given board, which took durationSeconds.
+		 *  A credited game wasn't run, it isn't part of the timing averages.
+		 *  Returns true if this was the last game of the competition (the latch was released).
+		 *  This method is thread safe.
+		 */
+		bool onGameFinished(const string& boardName, double durationSeconds, bool isCredited);
+
+		/** A game planned on the given board won't be played after all.
+		 *  Returns true if it was the last game of the competition (the latch was released).
+		 *  This method is thread safe.
+		 */
+		bool onGameSkipped(const string& boardName);
+
+		/** Returns true once all games planned so far are completed */
+		bool isCompleted() const;
+
+		/** Returns number of completed / in flight / remaining (not started yet) games */
+		size_t completedGames() const;
+		size_t inFlightGames() const;
+		size_t remainingGames() const;
+
+		/** Returns a progress line with throughput and ETA, or an empty string if the last line was reported
+		 *  less than minIntervalMillis ago. activeWorkers is the number of workers currently running games.
+		 *  Called by the main thread only.
+		 */
+		string progressReport(size_t activeWorkers, int minIntervalMillis);
+
+	private:
+		/** Timing statistics for the games of a single board */
+		struct BoardTimes
+		{
+			size_t plannedGames = 0;
+			size_t finishedGames = 0;
+			size_t timedGames = 0; // Finished games that were actually run
+			double totalSeconds = 0;
+		};
+
+		atomic<size_t> _plannedGames;
+		atomic<size_t> _completedGames;
+		atomic<size_t> _inFlightGames;
+		atomic<size_t> _remainingGames;
+
+		// Per board timings, game times vary widely between boards of different dimensions
+		unordered_map<string, BoardTimes> _boardTimes;
+		mutex _boardTimesLock;
+
+		std::chrono::steady_clock::time_point _startTime;
+		std::chrono::steady_clock::time_point _lastReportTime;
+		bool _isReportedOnce;
+
+		/** Estimates how many seconds the unfinished games will take for activeWorkers running in parallel */
+		double estimateRemainingSeconds(size_t activeWorkers);
+
+		/** Formats seconds as HH:MM:SS */
+		static string formatDuration(double seconds);
+	};
+}
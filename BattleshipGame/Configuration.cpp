@@ -2,6 +2,7 @@
 #include "IOUtil.h"
 #include <iostream>
 #include <string>
+#include "AdaptiveWorkerPool.h"
 
 using std::cout;
 using std::cerr;
@@ -15,7 +16,7 @@ namespace battleship
 	{
 		if (argc > MAX_ARG_COUNT)
 		{
-			string error = "Error: Too many arguments given. Try: BattleShipGame [path] [-threads <#count>]";
+			string error = "Error: Too many arguments given. Try: BattleShipGame [path] [-threads <#count|auto>]";
 			configurationIssues.push_back(std::make_pair(Severity::ERROR_LEVEL, error));
 			return false;
 		}
@@ -34,9 +35,15 @@ namespace battleship
 				if (argc > i + 1)
 				{
 					string argVal = argv[i + 1];
-					if (IOUtil::isInteger(argVal))
+					if (argVal == CONFIG_VALUE_AUTO_THREADS)
+					{
+						this->threads = static_cast<int>(AdaptiveWorkerPool::defaultWorkersCount());
+						this->isAutoThreads = true;
+					}
+					else if (IOUtil::isInteger(argVal))
 					{
 						this->threads = std::stoi(argv[i + 1]);
+						this->isAutoThreads = false;
 
 						if (this->threads <= 0)	// Invalid thread count value
 						{
@@ -47,14 +54,14 @@ namespace battleship
 					}
 					else
 					{
-						string error = "Error: Illegal threads field value. Try: -threads <#count>";
+						string error = "Error: Illegal threads field value. Try: -threads <#count|auto>";
 						configurationIssues.push_back(std::make_pair(Severity::ERROR_LEVEL, error));
 						return false;
 					}
 				}
 				else
 				{
-					string error = "Error: Threads argument missing value field. Try: -threads <#count>";
+					string error = "Error: Threads argument missing value field. Try: -threads <#count|auto>";
 					configurationIssues.push_back(std::make_pair(Severity::ERROR_LEVEL, error));
 					return false;
 				}
@@ -98,6 +105,23 @@ namespace battleship
 		return true;
 	}
 
+	bool Configuration::parseIntAttribute(string& line, const char* header, int min, int max, int& value,
+										  const string& attributeDescription)
+	{
+		IOUtil::removePrefix(line, header);
+		normalizeValue(line);
+
+		if (!validateInt(line, min, max)) // Only use the value if this is a valid int
+		{
+			string warning = "Configuration file traced invalid " + attributeDescription + " value";
+			configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+			return false;
+		}
+
+		value = std::stoi(line.c_str());
+		return true;
+	}
+
 	bool Configuration::loadConfigFile()
 	{
 		auto config = [this](string& nextLine, int lineNum, bool& isHeader, bool& isValidFile)
@@ -116,9 +140,15 @@ namespace battleship
 				IOUtil::removePrefix(nextLine, CONFIG_HEADER_THREADS);
 				normalizeValue(nextLine);
 
-				if (validateInt(nextLine, 1, INT_MAX)) // Only use the value if this is a valid int
+				if (nextLine == CONFIG_VALUE_AUTO_THREADS) // Adaptive threads count
+				{
+					this->threads = static_cast<int>(AdaptiveWorkerPool::defaultWorkersCount());
+					this->isAutoThreads = true;
+				}
+				else if (validateInt(nextLine, 1, INT_MAX)) // Only use the value if this is a valid int
 				{
 					this->threads = std::stoi(nextLine.c_str());
+					this->isAutoThreads = false;
 				}
 				else
 				{
@@ -146,6 +176,205 @@ namespace battleship
 					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
 				}
 			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_LOG_ASYNC)) // Asynchronous logging parameter (0/1)
+			{
+				int isLogAsync = 0;
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_LOG_ASYNC, 0, 1, isLogAsync, "asynchronous logging");
+				if (isValidFile)
+					this->isLogAsync = (isLogAsync == 1);
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_LOG_OVERFLOW)) // Log overflow parameter (string)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_LOG_OVERFLOW);
+				normalizeValue(nextLine);
+
+				if (!Logger::parseOverflowPolicy(nextLine, this->logOverflow))
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid log overflow policy value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_LOG_FORMAT)) // Events log format parameter (string)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_LOG_FORMAT);
+				normalizeValue(nextLine);
+
+				if (!EventLog::parseFormat(nextLine, this->logFormat))
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid log format value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_LOG_RATE_LIMIT)) // Log rate limit parameter (int)
+			{
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_LOG_RATE_LIMIT, 0, INT_MAX,
+												this->logRateLimit, "log rate limit");
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_LOG_DEBUG_SAMPLING)) // Debug sampling parameter (int)
+			{
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_LOG_DEBUG_SAMPLING, 1, 100,
+												this->logDebugSampling, "debug log sampling");
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_AFFINITY)) // Placement policy parameter (string)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_AFFINITY);
+				normalizeValue(nextLine);
+
+				if (!WorkerThreadPlacement::parsePolicy(nextLine, this->placement))
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid worker threads affinity value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_RESOURCE_AWARE)) // Resource aware parameter (0/1)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_RESOURCE_AWARE);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 0, 1)) // Only use the value if this is a valid boolean
+				{
+					this->isResourceAware = (std::stoi(nextLine.c_str()) == 1);
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid resource aware scheduling value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_FORMAT)) // Tournament format parameter (string)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_FORMAT);
+				normalizeValue(nextLine);
+
+				if (!TournamentFormat::parseType(nextLine, this->tournament.type))
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid tournament format value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_SWISS_ROUNDS)) // Swiss rounds parameter (int)
+			{
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_SWISS_ROUNDS, 0, INT_MAX,
+												this->tournament.swissRounds, "swiss rounds");
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_MATCH_BOARDS)) // Match boards parameter (int)
+			{
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_MATCH_BOARDS, 0, INT_MAX,
+												this->tournament.matchBoards, "match boards");
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_GROUP_SIZE)) // Group size parameter (int)
+			{
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_GROUP_SIZE, 2, INT_MAX,
+												this->tournament.groupSize, "group size");
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_GROUP_ADVANCE)) // Group advance parameter (int)
+			{
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_GROUP_ADVANCE, 1, INT_MAX,
+												this->tournament.groupAdvance, "group advance");
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_EARLY_STOP)) // Early stopping parameter (0/1)
+			{
+				int isEarlyStop = 0;
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_EARLY_STOP, 0, 1, isEarlyStop, "early stopping");
+				if (isValidFile)
+					this->isEarlyStop = (isEarlyStop == 1);
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_PREVIEW_SEED)) // Preview seed parameter (int)
+			{
+				int seed = 0;
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_PREVIEW_SEED, 0, INT_MAX, seed, "preview seed");
+				if (isValidFile)
+					this->preview.seed = static_cast<unsigned int>(seed);
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_PREVIEW_GAME_BUDGET)) // Preview games (int)
+			{
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_PREVIEW_GAME_BUDGET, 0, INT_MAX,
+												this->preview.gameBudget, "preview game budget");
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_PREVIEW_TIME_BUDGET)) // Preview seconds (int)
+			{
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_PREVIEW_TIME_BUDGET, 0, INT_MAX,
+												this->preview.timeBudgetSeconds, "preview time budget");
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_PREVIEW)) // Preview parameter (0/1)
+			{
+				int isPreview = 0;
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_PREVIEW, 0, 1, isPreview, "preview");
+				if (isValidFile)
+					this->preview.isEnabled = (isPreview == 1);
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_EXPORT_FORMAT)) // Export format parameter (string)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_EXPORT_FORMAT);
+				normalizeValue(nextLine);
+
+				if (!ResultsExporter::parseFormat(nextLine, this->exportSettings.format))
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid results export format value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_EXPORT_FILE)) // Export file name parameter (string)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_EXPORT_FILE);
+				normalizeValue(nextLine);
+				this->exportSettings.fileName = (!(nextLine.empty())) ? nextLine : DEFAULT_EXPORT_FILE;
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_RENDER_FPS)) // Console frame rate parameter (int)
+			{
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_RENDER_FPS, 0, INT_MAX,
+												this->renderFps, "render frame rate");
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_RESULTS_STORE)) // Results store parameter (string)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_RESULTS_STORE);
+				normalizeValue(nextLine);
+				this->resultsStore = nextLine;
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_GENERATED_BOARDS)) // Generated boards parameter (int)
+			{
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_GENERATED_BOARDS, 0, MAX_GENERATED_BOARDS,
+												this->generator.boardsCount, "generated boards");
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_GENERATED_BOARD_SIZE)) // Board size parameter (string)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_GENERATED_BOARD_SIZE);
+				normalizeValue(nextLine);
+
+				if (!BoardGenerator::parseDimensions(nextLine, this->generator.width, this->generator.height,
+													 this->generator.depth))
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid generated board size value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_GENERATED_FLEET)) // Fleet parameter (string)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_GENERATED_FLEET);
+				normalizeValue(nextLine);
+
+				if (!BoardGenerator::parseFleet(nextLine, this->generator.fleet))
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid generated fleet value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_GENERATED_SEED)) // Generator seed parameter (int)
+			{
+				int seed = 0;
+				isValidFile = parseIntAttribute(nextLine, CONFIG_HEADER_GENERATED_SEED, 0, INT_MAX, seed,
+												"generated boards seed");
+				if (isValidFile)
+					this->generator.seed = static_cast<unsigned int>(seed);
+			}
 			else if ((IOUtil::startsWith(nextLine, CONFIG_HEADER_COMMENT)) ||  // Comment %%
 					 (IOUtil::isContainOnlyWhitespaces(nextLine))) // Empty line
 			{
@@ -172,7 +401,34 @@ namespace battleship
 	{
 		this->path = DEFAULT_PATH;			   // Nameless param, default is working directory
 		this->threads = DEFAULT_THREAD_COUNT;  // Optional param: worker threads count
+		this->isAutoThreads = false;		   // Default is a fixed worker threads count
 		this->logSeverity = DEFAULT_SEVERITY;  // Default is info level
+		this->isLogAsync = DEFAULT_LOG_ASYNC;  // Default is a background log writer
+		this->logOverflow = DEFAULT_LOG_OVERFLOW; // Default is to wait for the writer when a buffer is full
+		this->logFormat = DEFAULT_LOG_FORMAT;  // Default is to render events to the text log
+		this->logRateLimit = DEFAULT_LOG_RATE_LIMIT; // Default is to limit repeating warnings and errors
+		this->logDebugSampling = DEFAULT_LOG_DEBUG_SAMPLING; // Default is to log all debug messages
+		this->placement = DEFAULT_PLACEMENT;   // Default is no pinning
+		this->isResourceAware = DEFAULT_RESOURCE_AWARE; // Default is to ignore resource profiles
+		this->tournament.type = DEFAULT_FORMAT; // Default is a full round robin
+		this->tournament.swissRounds = DEFAULT_SWISS_ROUNDS;
+		this->tournament.matchBoards = DEFAULT_MATCH_BOARDS;
+		this->tournament.groupSize = DEFAULT_GROUP_SIZE;
+		this->tournament.groupAdvance = DEFAULT_GROUP_ADVANCE;
+		this->isEarlyStop = DEFAULT_EARLY_STOP; // Default is to play all games
+		this->preview.isEnabled = DEFAULT_PREVIEW; // Default is a full run on all boards
+		this->preview.seed = DEFAULT_PREVIEW_SEED;
+		this->preview.gameBudget = DEFAULT_PREVIEW_GAME_BUDGET;
+		this->preview.timeBudgetSeconds = DEFAULT_PREVIEW_TIME_BUDGET;
+		this->exportSettings.format = DEFAULT_EXPORT_FORMAT; // Default is no export
+		this->exportSettings.fileName = DEFAULT_EXPORT_FILE;
+		this->renderFps = DEFAULT_RENDER_FPS; // Default is a few tables per second
+		this->resultsStore = DEFAULT_RESULTS_STORE; // Default is no results store
+		this->generator.boardsCount = DEFAULT_GENERATED_BOARDS; // Default is boards from path only
+		BoardGenerator::parseDimensions(DEFAULT_GENERATED_BOARD_SIZE, this->generator.width, this->generator.height,
+										this->generator.depth);
+		BoardGenerator::parseFleet(DEFAULT_GENERATED_FLEET, this->generator.fleet);
+		this->generator.seed = DEFAULT_GENERATED_SEED;
 	}
 
 	Configuration::Configuration()
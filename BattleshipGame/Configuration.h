@@ -3,6 +3,12 @@
 #include <vector>
 #include <utility>
 #include "Logger.h"
+#include "EventLog.h"
+#include "WorkerThreadPlacement.h"
+#include "TournamentFormat.h"
+#include "BoardSamplingFormat.h"
+#include "ResultsExporter.h"
+#include "BoardGenerator.h"
 
 using std::string;
 using std::pair;
@@ -27,9 +33,55 @@ namespace battleship
 		// Number of worker threads to run games in competition
 		int threads;
 
+		// If true, the number of worker threads is tuned during the competition by measured throughput
+		// (threads then holds the initial number of active workers)
+		bool isAutoThreads;
+
 		// Severity filter for logger messages
 		Severity logSeverity;
 
+		// If true, messages are written to the log file by a background thread
+		bool isLogAsync;
+
+		// What the asynchronous logger does with messages of a thread whose buffer is full
+		LogOverflowPolicy logOverflow;
+
+		// Output of the structured events (games and moves): the text log or a compact binary log
+		LogFormat logFormat;
+
+		// Maximal number of messages per second logged by each repeating warning / error call site (0 for no limit)
+		int logRateLimit;
+
+		// Percentage of debug messages that are logged (the rest are dropped at random)
+		int logDebugSampling;
+
+		// Placement policy of worker threads on the host's cores
+		PlacementPolicy placement;
+
+		// If true, games are admitted only while the resource profiles of running players fit the host
+		bool isResourceAware;
+
+		// Format of the tournament and its parameters
+		TournamentSettings tournament;
+
+		// If true, games of matchups whose result is statistically settled are skipped
+		bool isEarlyStop;
+
+		// Board sampling preview mode (replaces the tournament format when enabled)
+		PreviewSettings preview;
+
+		// Machine readable export of games and rounds results
+		ExportSettings exportSettings;
+
+		// Maximal number of round results tables drawn to the console per second (0 for no limit)
+		int renderFps;
+
+		// File name (in path) of the columnar store that game outcomes are appended to, empty for none
+		string resultsStore;
+
+		// Random boards generated in addition to the boards loaded from path
+		GeneratorSettings generator;
+
 		// List of textual warnings (if any) for incorrect configuration setup.
 		// The configuration object accumulates these since nothing is loaded in the app yet,
 		// including the logger.
@@ -53,6 +105,64 @@ namespace battleship
 		// Default logger severity
 		static constexpr Severity DEFAULT_SEVERITY = Severity::INFO_LEVEL;
 
+		// Default is asynchronous logging, that never loses messages
+		static constexpr bool DEFAULT_LOG_ASYNC = true;
+		static constexpr LogOverflowPolicy DEFAULT_LOG_OVERFLOW = LogOverflowPolicy::BLOCK;
+
+		// Default is a single, readable text log
+		static constexpr LogFormat DEFAULT_LOG_FORMAT = LogFormat::TEXT;
+
+		// Default is a few messages per second from each repeating call site, and all debug messages
+		static constexpr int DEFAULT_LOG_RATE_LIMIT = 10;
+		static constexpr int DEFAULT_LOG_DEBUG_SAMPLING = 100;
+
+		// Default worker threads placement (not pinned)
+		static constexpr PlacementPolicy DEFAULT_PLACEMENT = PlacementPolicy::NONE;
+
+		// Default games scheduling (resource profiles are ignored)
+		static constexpr bool DEFAULT_RESOURCE_AWARE = false;
+
+		// Default tournament format (full double round robin)
+		static constexpr TournamentFormatType DEFAULT_FORMAT = TournamentFormatType::ROUND_ROBIN;
+
+		// Default number of swiss rounds (0 = log2 of the number of players)
+		static constexpr int DEFAULT_SWISS_ROUNDS = 0;
+
+		// Default number of boards a match is played on (0 = all boards)
+		static constexpr int DEFAULT_MATCH_BOARDS = 0;
+
+		// Default group size and number of players advancing from each group to the playoffs
+		static constexpr int DEFAULT_GROUP_SIZE = 4;
+		static constexpr int DEFAULT_GROUP_ADVANCE = 2;
+
+		// Default is to play all scheduled games
+		static constexpr bool DEFAULT_EARLY_STOP = false;
+
+		// Default is a full run on all boards, and the defaults of the preview when enabled
+		static constexpr bool DEFAULT_PREVIEW = false;
+		static constexpr int DEFAULT_PREVIEW_SEED = 0;
+		static constexpr int DEFAULT_PREVIEW_GAME_BUDGET = 0;
+		static constexpr int DEFAULT_PREVIEW_TIME_BUDGET = 0;
+
+		// Default is no export, and the base name of the export files when enabled
+		static constexpr ExportFormat DEFAULT_EXPORT_FORMAT = ExportFormat::NONE;
+		static constexpr auto DEFAULT_EXPORT_FILE = "results";
+
+		// Default frame rate of the round results tables in the console
+		static constexpr int DEFAULT_RENDER_FPS = 4;
+
+		// Default is not to keep game outcomes beyond the export
+		static constexpr auto DEFAULT_RESULTS_STORE = "";
+
+		// Default is no generated boards, otherwise boards of one ship of each type per player
+		static constexpr int DEFAULT_GENERATED_BOARDS = 0;
+		static constexpr auto DEFAULT_GENERATED_BOARD_SIZE = "10x10x10";
+		static constexpr auto DEFAULT_GENERATED_FLEET = "BPMD";
+		static constexpr int DEFAULT_GENERATED_SEED = 0;
+
+		// Generated boards are all kept in memory for the whole competition
+		static constexpr int MAX_GENERATED_BOARDS = 10000;
+
 		// Maximum number of arguments in a legal command line
 		static constexpr int MAX_ARG_COUNT = 4;
 
@@ -65,9 +175,61 @@ namespace battleship
 		// Header of threads arg in configuration file
 		static constexpr auto CONFIG_HEADER_THREADS = "THREADS=";
 
+		// Value of threads arg (config file or command line) for adaptive worker threads count
+		static constexpr auto CONFIG_VALUE_AUTO_THREADS = "auto";
+
 		// Header of log level arg in configuration file
 		static constexpr auto CONFIG_HEADER_LOGLEVEL = "LOG_LEVEL=";
 
+		// Headers of asynchronous logging args in configuration file
+		static constexpr auto CONFIG_HEADER_LOG_ASYNC = "LOG_ASYNC=";
+		static constexpr auto CONFIG_HEADER_LOG_OVERFLOW = "LOG_OVERFLOW=";
+
+		// Header of the structured events format arg in configuration file
+		static constexpr auto CONFIG_HEADER_LOG_FORMAT = "LOG_FORMAT=";
+
+		// Headers of log volume limiting args in configuration file
+		static constexpr auto CONFIG_HEADER_LOG_RATE_LIMIT = "LOG_RATE_LIMIT=";
+		static constexpr auto CONFIG_HEADER_LOG_DEBUG_SAMPLING = "LOG_DEBUG_SAMPLING=";
+
+		// Header of worker threads placement policy arg in configuration file
+		static constexpr auto CONFIG_HEADER_AFFINITY = "AFFINITY=";
+
+		// Header of resource aware scheduling arg in configuration file
+		static constexpr auto CONFIG_HEADER_RESOURCE_AWARE = "RESOURCE_AWARE=";
+
+		// Headers of tournament format args in configuration file
+		static constexpr auto CONFIG_HEADER_FORMAT = "FORMAT=";
+		static constexpr auto CONFIG_HEADER_SWISS_ROUNDS = "SWISS_ROUNDS=";
+		static constexpr auto CONFIG_HEADER_MATCH_BOARDS = "MATCH_BOARDS=";
+		static constexpr auto CONFIG_HEADER_GROUP_SIZE = "GROUP_SIZE=";
+		static constexpr auto CONFIG_HEADER_GROUP_ADVANCE = "GROUP_ADVANCE=";
+
+		// Header of early stopping arg in configuration file
+		static constexpr auto CONFIG_HEADER_EARLY_STOP = "EARLY_STOP=";
+
+		// Headers of board sampling preview args in configuration file
+		static constexpr auto CONFIG_HEADER_PREVIEW = "PREVIEW=";
+		static constexpr auto CONFIG_HEADER_PREVIEW_SEED = "PREVIEW_SEED=";
+		static constexpr auto CONFIG_HEADER_PREVIEW_GAME_BUDGET = "PREVIEW_GAME_BUDGET=";
+		static constexpr auto CONFIG_HEADER_PREVIEW_TIME_BUDGET = "PREVIEW_TIME_BUDGET=";
+
+		// Headers of results export args in configuration file
+		static constexpr auto CONFIG_HEADER_EXPORT_FORMAT = "EXPORT_FORMAT=";
+		static constexpr auto CONFIG_HEADER_EXPORT_FILE = "EXPORT_FILE=";
+
+		// Header of the console frame rate arg in configuration file
+		static constexpr auto CONFIG_HEADER_RENDER_FPS = "RENDER_FPS=";
+
+		// Header of the results store arg in configuration file
+		static constexpr auto CONFIG_HEADER_RESULTS_STORE = "RESULTS_STORE=";
+
+		// Headers of generated boards args in configuration file
+		static constexpr auto CONFIG_HEADER_GENERATED_BOARDS = "GENERATED_BOARDS=";
+		static constexpr auto CONFIG_HEADER_GENERATED_BOARD_SIZE = "GENERATED_BOARD_SIZE=";
+		static constexpr auto CONFIG_HEADER_GENERATED_FLEET = "GENERATED_FLEET=";
+		static constexpr auto CONFIG_HEADER_GENERATED_SEED = "GENERATED_SEED=";
+
 		// Beginning of comments in config file - to be ignored by the parser
 		static constexpr auto CONFIG_HEADER_COMMENT = "%%";
 
@@ -82,6 +244,12 @@ namespace battleship
 		/** Loads default values for configuration (last fallback) */
 		void loadDefaults();
 
+		/** Parses an int attribute of the configuration file in the range [min, max] into value.
+		 *  Returns false (and records a warning) if the value is invalid.
+		 */
+		bool parseIntAttribute(string& line, const char* header, int min, int max, int& value,
+							   const string& attributeDescription);
+
 		/** Normalizes the value given: if it starts and ends with quotation marks they will be removed */
 		static void normalizeValue(string& value);
 	};
@@ -0,0 +1,152 @@
+#include "EliminationFormat.h"
+#include "Logger.h"
+#include <sstream>
+
+using std::to_string;
+using std::stringstream;
+
+namespace battleship
+{
+	EliminationFormat::EliminationFormat(const vector<string>& players, const vector<string>& boards,
+										 int matchBoards, int maxLosses, bool isSeededByOrder) :
+		TournamentFormat(players, boards, matchBoards),
+		_maxLosses((maxLosses > 0) ? maxLosses : 1),
+		_isSeededByOrder(isSeededByOrder)
+	{
+		for (const auto& player : players)
+			_losses[player] = 0;
+	}
+
+	size_t EliminationFormat::maxRoundsPerPlayer() const
+	{
+		// The winners bracket takes log2 stages, every extra life adds the way through the next bracket
+		// and a final against the leader of the better bracket
+		size_t stages = log2Ceil(_players.size()) * _maxLosses + (_maxLosses - 1) * 2;
+		return stages * gamesPerMatch();
+	}
+
+	void EliminationFormat::recordLastStage(const Standings& standings, vector<string>& retiredPlayers)
+	{
+		for (const auto& match : _lastMatches)
+		{
+			const string& winner = matchWinner(match, _lastStageStandings, standings);
+			const string& loser = (winner == match.playerA) ? match.playerB : match.playerA;
+
+			Logger::getInstance().log(Severity::INFO_LEVEL, "Match won by " + winner + " against " + loser);
+
+			if (++_losses[loser] >= _maxLosses)
+			{
+				_eliminated.push_back(std::make_pair(loser, _stagesPlayed));
+				retiredPlayers.push_back(loser);
+			}
+		}
+
+		_lastMatches.clear();
+	}
+
+	bool EliminationFormat::nextStage(const Standings& standings, TournamentStage& stage)
+	{
+		recordLastStage(standings, stage.retiredPlayers);
+
+		vector<string> alive;
+		for (const auto& player : _players)
+		{
+			if (_losses[player] < _maxLosses)
+				alive.push_back(player);
+		}
+
+		if (alive.size() <= 1)
+		{
+			_champion = alive.empty() ? "" : alive.front();
+			return false;
+		}
+
+		// Split remaining players into brackets by number of losses, each sorted by seed
+		vector<string> ranked = ((_stagesPlayed == 0) && _isSeededByOrder) ? alive : rankPlayers(alive, standings);
+		vector<vector<string>> brackets(_maxLosses);
+		for (const auto& player : ranked)
+			brackets[_losses[player]].push_back(player);
+
+		vector<Match> matches;
+		string carriedPlayer; // Odd player out of the previous bracket
+
+		for (size_t bracket = 0; bracket < brackets.size(); ++bracket)
+		{
+			vector<string>& players = brackets[bracket];
+
+			if (!carriedPlayer.empty() && !players.empty())
+			{
+				matches.push_back(Match{ carriedPlayer, players.front() });
+				players.erase(players.begin());
+				carriedPlayer.clear();
+			}
+
+			if (players.size() % 2 != 0)
+			{
+				bool isLaterBracket = false;
+				for (size_t later = bracket + 1; later < brackets.size(); ++later)
+					isLaterBracket = isLaterBracket || !brackets[later].empty();
+
+				if (isLaterBracket)
+				{	// Worst seed of this bracket meets the best seed of the next one
+					carriedPlayer = players.back();
+					players.pop_back();
+				}
+				else
+				{	// Best seed sits this stage out
+					stage.byes.push_back(std::make_pair(players.front(), gamesPerMatch()));
+					players.erase(players.begin());
+				}
+			}
+
+			// Best seed against worst seed
+			for (size_t i = 0; i < players.size() / 2; ++i)
+				matches.push_back(Match{ players[i], players[players.size() - 1 - i] });
+		}
+
+		if (!carriedPlayer.empty())
+			stage.byes.push_back(std::make_pair(carriedPlayer, gamesPerMatch()));
+
+		appendMatchGames(matches, stage);
+		_lastMatches = matches;
+		_lastStageStandings = standings;
+		_stagesPlayed++;
+
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Elimination stage " + to_string(_stagesPlayed) + ": " + to_string(alive.size()) +
+								  " players remaining, " + to_string(matches.size()) + " matches, " +
+								  to_string(stage.byes.size()) + " byes");
+		return true;
+	}
+
+	string EliminationFormat::summary() const
+	{
+		if (_champion.empty())
+			return "";
+
+		stringstream ss;
+		ss << "Final placements:" << std::endl << "1. " << _champion;
+
+		// Players knocked out later are placed higher, players knocked out in the same stage share a place
+		size_t place = 2;
+		for (auto it = _eliminated.rbegin(); it != _eliminated.rend();)
+		{
+			size_t stageNum = it->second;
+			vector<string> sharedPlace;
+			for (; (it != _eliminated.rend()) && (it->second == stageNum); ++it)
+				sharedPlace.push_back(it->first);
+
+			ss << std::endl << place;
+			if (sharedPlace.size() > 1)
+				ss << "-" << (place + sharedPlace.size() - 1);
+			ss << ". ";
+
+			for (size_t i = 0; i < sharedPlace.size(); ++i)
+				ss << ((i > 0) ? ", " : "") << sharedPlace[i];
+
+			place += sharedPlace.size();
+		}
+
+		return ss.str();
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <unordered_map>
+#include "TournamentFormat.h"
+
+using std::unordered_map;
+
+namespace battleship
+{
+	/** Knockout tournament: a player is out after losing maxLosses matches (1 for single elimination,
+	 *  2 for double elimination). In each stage every remaining player plays exactly one match or has a bye:
+	 *  players are paired within their bracket (players with the same number of losses), best seed against
+	 *  worst seed by the current standings. An odd player out plays the best seed of the next bracket,
+	 *  or has a bye if there is no such bracket. Costs O(players * boards) games.
+	 */
+	class EliminationFormat : public TournamentFormat
+	{
+	public:
+		/** If isSeededByOrder is true, the first stage is seeded by the order of players instead of their standings */
+		EliminationFormat(const vector<string>& players, const vector<string>& boards, int matchBoards, int maxLosses,
+						  bool isSeededByOrder = false);
+		virtual ~EliminationFormat() = default;
+
+		size_t maxRoundsPerPlayer() const override;
+		bool nextStage(const Standings& standings, TournamentStage& stage) override;
+		string summary() const override;
+
+	private:
+		// Number of lost matches that knock a player out
+		int _maxLosses;
+
+		// Seed the first stage by the order of players
+		bool _isSeededByOrder;
+
+		// Number of matches each player lost so far
+		unordered_map<string, int> _losses;
+
+		// Matches of the last stage, and the standings when it started (to tell their winners)
+		vector<Match> _lastMatches;
+		Standings _lastStageStandings;
+
+		// Knocked out players, in order of elimination, with the stage they were knocked out in
+		vector<pair<string, size_t>> _eliminated;
+
+		// Last player standing, once the tournament is over
+		string _champion;
+
+		/** Records the results of the last stage's matches, knocked out players are added to retiredPlayers */
+		void recordLastStage(const Standings& standings, vector<string>& retiredPlayers);
+	};
+}
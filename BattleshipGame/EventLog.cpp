@@ -0,0 +1,594 @@
+#include "EventLog.h"
+#include <iostream>
+
+using std::cerr;
+using std::endl;
+using std::lock_guard;
+using std::to_string;
+
+namespace battleship
+{
+	// Template table, indexed by the event's code
+	static const EventTemplate EVENT_TEMPLATES[] =
+	{
+		{ "game_created", Severity::DEBUG_LEVEL, "Created game between Player A: {} and Player B: {} on board: {}.",
+		  3, { EventArgKind::PLAYER, EventArgKind::PLAYER, EventArgKind::BOARD } },
+		{ "game_started", Severity::DEBUG_LEVEL, "Game started between Player A: {} and Player B: {} on board: {}.",
+		  3, { EventArgKind::PLAYER, EventArgKind::PLAYER, EventArgKind::BOARD } },
+		{ "attack", Severity::DEBUG_LEVEL, "Player {} attacks at ({}, {}, {})",
+		  4, { EventArgKind::SIDE, EventArgKind::INT, EventArgKind::INT, EventArgKind::INT } },
+		{ "no_more_moves", Severity::DEBUG_LEVEL, "Player {} has no more moves.",
+		  1, { EventArgKind::SIDE } },
+		{ "invalid_attack", Severity::DEBUG_LEVEL, "Player {} tried to perform an invalid attack - loses turn.",
+		  1, { EventArgKind::SIDE } },
+		{ "attack_result", Severity::DEBUG_LEVEL, "Attack result: {}",
+		  1, { EventArgKind::ATTACK_RESULT } },
+		{ "game_finished", Severity::INFO_LEVEL, "Game finished between Player A: {} (Round #{}, {} pts) and "
+												 "Player B: {} (Round #{}, {} pts) on board: {}. Game result: {}",
+		  8, { EventArgKind::PLAYER, EventArgKind::INT, EventArgKind::INT, EventArgKind::PLAYER, EventArgKind::INT,
+			   EventArgKind::INT, EventArgKind::BOARD, EventArgKind::GAME_RESULT } },
+		{ "game_skipped", Severity::DEBUG_LEVEL, "Skipped game between Player A: {} and Player B: {} on board: {} "
+												 "(matchup is settled).",
+		  3, { EventArgKind::PLAYER, EventArgKind::PLAYER, EventArgKind::BOARD } }
+	};
+
+	static_assert(sizeof(EVENT_TEMPLATES) / sizeof(EVENT_TEMPLATES[0]) == static_cast<size_t>(LogEvent::COUNT),
+				  "Every event needs a template");
+
+	static constexpr auto BINARY_LOG_MAGIC = "BEL1";
+	static constexpr char CHUNK_TYPE_NAMES = 'N';
+	static constexpr char CHUNK_TYPE_EVENTS = 'E';
+	static constexpr uint8_t NAMES_KIND_PLAYERS = 0;
+	static constexpr uint8_t NAMES_KIND_BOARDS = 1;
+
+	// Buffer of the calling thread (shared with the event log, which writes it on close)
+	static thread_local shared_ptr<ThreadEventBuffer> currentThreadEventBuffer;
+
+	static void writeVarint(vector<uint8_t>& bytes, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			bytes.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+
+		bytes.push_back(static_cast<uint8_t>(value));
+	}
+
+	static bool readVarint(const vector<uint8_t>& bytes, size_t& position, uint64_t& value)
+	{
+		value = 0;
+		for (int shift = 0; (shift < 64) && (position < bytes.size()); shift += 7)
+		{
+			uint8_t byte = bytes[position++];
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0)
+				return true;
+		}
+
+		return false; // Truncated or too long
+	}
+
+	// Zigzag encoding keeps small negative numbers short
+	static uint64_t zigzagEncode(int64_t value)
+	{
+		return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+	}
+
+	static int64_t zigzagDecode(uint64_t value)
+	{
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+	static void writeUInt32(vector<uint8_t>& bytes, size_t offset, uint32_t value)
+	{
+		for (size_t i = 0; i < sizeof(value); ++i)
+			bytes[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+	}
+
+	static uint64_t readUInt(const uint8_t* bytes, size_t size)
+	{
+		uint64_t value = 0;
+		for (size_t i = 0; i < size; ++i)
+			value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+
+		return value;
+	}
+
+	static int64_t microsSinceEpoch(std::chrono::system_clock::time_point time)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+	}
+
+	EventLog::EventLog() :
+		_isBinary(false),
+		_startMicros(0)
+	{
+	}
+
+	EventLog::~EventLog()
+	{
+		close();
+	}
+
+	EventLog& EventLog::getInstance()
+	{
+		// Created after the logger (it's used once the logger is loaded), so it's destroyed before it
+		static EventLog instance;
+
+		return instance;
+	}
+
+	const EventTemplate& EventLog::eventTemplate(LogEvent event)
+	{
+		return EVENT_TEMPLATES[static_cast<size_t>(event)];
+	}
+
+	bool EventLog::parseFormat(const string& text, LogFormat& format)
+	{
+		if (text == "text")
+			format = LogFormat::TEXT;
+		else if (text == "binary")
+			format = LogFormat::BINARY;
+		else
+			return false;
+
+		return true;
+	}
+
+	string EventLog::formatToString(LogFormat format)
+	{
+		return (format == LogFormat::BINARY) ? "binary" : "text";
+	}
+
+	string EventLog::formatMessage(LogEvent event, const vector<int64_t>& args, const EventNames& names)
+	{
+		const EventTemplate& eventTemplate = EVENT_TEMPLATES[static_cast<size_t>(event)];
+		string msg;
+		size_t argIndex = 0;
+
+		for (const char* c = eventTemplate.text; *c != '\0'; ++c)
+		{
+			if ((c[0] != '{') || (c[1] != '}') || (argIndex >= eventTemplate.argsCount) || (argIndex >= args.size()))
+			{
+				msg += *c;
+				continue;
+			}
+
+			int64_t value = args[argIndex];
+			switch (eventTemplate.args[argIndex])
+			{
+				case EventArgKind::PLAYER:
+				case EventArgKind::BOARD:
+				{
+					const auto& list = (eventTemplate.args[argIndex] == EventArgKind::PLAYER) ? names.players : names.boards;
+					msg += ((value >= 0) && (static_cast<size_t>(value) < list.size())) ? list[static_cast<size_t>(value)] : "?";
+					break;
+				}
+				case EventArgKind::SIDE:
+					msg += (value == 0) ? "A" : "B";
+					break;
+				case EventArgKind::ATTACK_RESULT:
+					msg += (value == 0) ? "Miss" : ((value == 1) ? "Hit" : "Sink");
+					break;
+				case EventArgKind::GAME_RESULT:
+					msg += (value == 0) ? "Player A wins" : ((value == 1) ? "Player B wins" : "Tie");
+					break;
+				case EventArgKind::INT:
+				default:
+					msg += to_string(value);
+			}
+
+			argIndex++;
+			++c; // Skip the closing brace
+		}
+
+		return msg;
+	}
+
+	void EventLog::setFormat(LogFormat format, const string& path)
+	{
+		if ((format != LogFormat::BINARY) || _isBinary)
+			return;
+
+		auto logFilePath = path + "\\" + BINARY_LOG_FILE;
+		_fs.open(logFilePath, std::fstream::out | std::fstream::binary | std::fstream::trunc);
+		if (!_fs.is_open() || !_fs.good())
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+									  "IO error when creating binary log file at: " + logFilePath +
+									  " [events will be written to the text log]", true);
+			return;
+		}
+
+		_startMicros = microsSinceEpoch(std::chrono::system_clock::now());
+
+		vector<uint8_t> header(HEADER_SIZE, 0);
+		for (size_t i = 0; i < 4; ++i)
+			header[i] = static_cast<uint8_t>(BINARY_LOG_MAGIC[i]);
+		writeUInt32(header, 4, VERSION);
+		writeUInt32(header, 8, static_cast<uint32_t>(_startMicros));
+		writeUInt32(header, 12, static_cast<uint32_t>(static_cast<uint64_t>(_startMicros) >> 32));
+		_fs.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+		_isBinary = true;
+
+		// Names registered so far are needed to decode the events
+		writeNames(NAMES_KIND_PLAYERS, _names.players);
+		writeNames(NAMES_KIND_BOARDS, _names.boards);
+	}
+
+	void EventLog::registerNames(const vector<string>& players, const vector<string>& boards)
+	{
+		vector<string> newPlayers;
+		for (const auto& player : players)
+		{
+			if (_playerIds.emplace(player, static_cast<uint32_t>(_names.players.size())).second)
+			{
+				_names.players.push_back(player);
+				newPlayers.push_back(player);
+			}
+		}
+
+		vector<string> newBoards;
+		for (const auto& board : boards)
+		{
+			if (_boardIds.emplace(board, static_cast<uint32_t>(_names.boards.size())).second)
+			{
+				_names.boards.push_back(board);
+				newBoards.push_back(board);
+			}
+		}
+
+		if (!_isBinary)
+			return;
+
+		// Ids continue from the ones already written, so only the new names are needed
+		lock_guard<mutex> lock(_fileLock);
+		size_t firstPlayer = _names.players.size() - newPlayers.size();
+		size_t firstBoard = _names.boards.size() - newBoards.size();
+
+		vector<uint8_t> payload;
+		for (size_t i = 0; i < newPlayers.size(); ++i)
+		{
+			payload.push_back(NAMES_KIND_PLAYERS);
+			writeVarint(payload, firstPlayer + i);
+			writeVarint(payload, newPlayers[i].length());
+			payload.insert(payload.end(), newPlayers[i].begin(), newPlayers[i].end());
+		}
+		for (size_t i = 0; i < newBoards.size(); ++i)
+		{
+			payload.push_back(NAMES_KIND_BOARDS);
+			writeVarint(payload, firstBoard + i);
+			writeVarint(payload, newBoards[i].length());
+			payload.insert(payload.end(), newBoards[i].begin(), newBoards[i].end());
+		}
+
+		if (!payload.empty())
+			writeChunk(CHUNK_TYPE_NAMES, payload);
+	}
+
+	uint32_t EventLog::playerId(const string& name) const
+	{
+		auto id = _playerIds.find(name);
+		return (id != _playerIds.end()) ? id->second : UNKNOWN_ID;
+	}
+
+	uint32_t EventLog::boardId(const string& name) const
+	{
+		auto id = _boardIds.find(name);
+		return (id != _boardIds.end()) ? id->second : UNKNOWN_ID;
+	}
+
+	void EventLog::record(LogEvent event, initializer_list<int64_t> args)
+	{
+		const EventTemplate& eventTemplate = EVENT_TEMPLATES[static_cast<size_t>(event)];
+
+		if (!_isBinary)
+		{
+			Logger::getInstance().log(eventTemplate.severity, formatMessage(event, vector<int64_t>(args), _names));
+			return;
+		}
+
+		int64_t eventMicros = microsSinceEpoch(std::chrono::system_clock::now()) - _startMicros;
+		ThreadEventBuffer& buffer = threadBuffer();
+		lock_guard<mutex> lock(buffer.lock);
+
+		if (!_isBinary)
+		{	// Closed while this event was recorded
+			Logger::getInstance().log(eventTemplate.severity, formatMessage(event, vector<int64_t>(args), _names));
+			return;
+		}
+
+		// A chunk starts with its own time, events only keep the time since the previous one
+		if (buffer.bytes.empty())
+		{
+			buffer.lastMicros = (eventMicros > 0) ? eventMicros : 0;
+			writeVarint(buffer.bytes, static_cast<uint64_t>(buffer.lastMicros));
+		}
+
+		int64_t deltaMicros = (eventMicros > buffer.lastMicros) ? (eventMicros - buffer.lastMicros) : 0;
+		buffer.lastMicros += deltaMicros;
+
+		buffer.bytes.push_back(static_cast<uint8_t>(event));
+		writeVarint(buffer.bytes, static_cast<uint64_t>(deltaMicros));
+
+		size_t argIndex = 0;
+		for (int64_t arg : args)
+		{
+			if (argIndex >= eventTemplate.argsCount)
+				break;
+
+			if (eventTemplate.args[argIndex] == EventArgKind::INT)
+				writeVarint(buffer.bytes, zigzagEncode(arg));
+			else
+				writeVarint(buffer.bytes, static_cast<uint64_t>(arg));
+
+			argIndex++;
+		}
+
+		// Missing arguments are written as zeros, so the decoder always finds the template's arguments
+		for (; argIndex < eventTemplate.argsCount; ++argIndex)
+			buffer.bytes.push_back(0);
+
+		if (buffer.bytes.size() >= CHUNK_SIZE)
+			writeEventsChunk(buffer);
+	}
+
+	void EventLog::close()
+	{
+		// Events recorded from now on are rendered to the text log
+		if (!_isBinary.exchange(false))
+			return;
+
+		vector<shared_ptr<ThreadEventBuffer>> buffers;
+		{
+			lock_guard<mutex> lock(_buffersLock);
+			buffers = _threadBuffers;
+		}
+
+		// An event being encoded holds its buffer's lock, so it is in the buffer once the lock is taken
+		for (auto& buffer : buffers)
+		{
+			lock_guard<mutex> lock(buffer->lock);
+			writeEventsChunk(*buffer);
+		}
+
+		lock_guard<mutex> lock(_fileLock);
+		_fs.close();
+		if (!_fs)
+			cerr << "Error: IO error when flushing the binary log content to " << BINARY_LOG_FILE << endl;
+	}
+
+	ThreadEventBuffer& EventLog::threadBuffer()
+	{
+		if (currentThreadEventBuffer == nullptr)
+		{
+			auto buffer = std::make_shared<ThreadEventBuffer>();
+			buffer->bytes.reserve(CHUNK_SIZE + 64);
+			buffer->lastMicros = 0;
+			currentThreadEventBuffer = buffer;
+
+			lock_guard<mutex> lock(_buffersLock);
+			_threadBuffers.push_back(buffer);
+		}
+
+		return *currentThreadEventBuffer;
+	}
+
+	void EventLog::writeEventsChunk(ThreadEventBuffer& buffer)
+	{
+		if (buffer.bytes.empty())
+			return;
+
+		{
+			lock_guard<mutex> lock(_fileLock);
+			writeChunk(CHUNK_TYPE_EVENTS, buffer.bytes);
+		}
+
+		buffer.bytes.clear();
+	}
+
+	void EventLog::writeChunk(char type, const vector<uint8_t>& payload)
+	{
+		vector<uint8_t> chunkHeader(5, 0);
+		chunkHeader[0] = static_cast<uint8_t>(type);
+		writeUInt32(chunkHeader, 1, static_cast<uint32_t>(payload.size()));
+
+		_fs.write(reinterpret_cast<const char*>(chunkHeader.data()), chunkHeader.size());
+		_fs.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+	}
+
+	void EventLog::writeNames(uint8_t kind, const vector<string>& names)
+	{
+		if (names.empty())
+			return;
+
+		vector<uint8_t> payload;
+		for (size_t id = 0; id < names.size(); ++id)
+		{
+			payload.push_back(kind);
+			writeVarint(payload, id);
+			writeVarint(payload, names[id].length());
+			payload.insert(payload.end(), names[id].begin(), names[id].end());
+		}
+
+		lock_guard<mutex> lock(_fileLock);
+		writeChunk(CHUNK_TYPE_NAMES, payload);
+	}
+
+	EventLogReader::EventLogReader(const string& path) :
+		_fs(path, std::ios::in | std::ios::binary),
+		_isOpen(false),
+		_isCorrupt(false),
+		_fileSize(0),
+		_chunkPosition(0),
+		_lastMicros(0)
+	{
+		_fs.seekg(0, std::ios::end);
+		std::streamoff fileSize = _fs.tellg();
+		_fs.seekg(0);
+		if (fileSize <= 0)
+			return;
+
+		_fileSize = static_cast<uint64_t>(fileSize);
+
+		char header[EventLog::HEADER_SIZE];
+		if (!_fs.read(header, sizeof(header)))
+			return;
+
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(header);
+		uint64_t startMicros = readUInt(bytes + 8, 8);
+		if ((std::string(header, 4) != BINARY_LOG_MAGIC) || (readUInt(bytes + 4, 4) != EventLog::VERSION) ||
+			(startMicros > static_cast<uint64_t>(MAX_MICROS)))
+		{
+			return;
+		}
+
+		_startTime = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+						std::chrono::microseconds(static_cast<int64_t>(startMicros))));
+		_isOpen = true;
+	}
+
+	bool EventLogReader::isOpen() const
+	{
+		return _isOpen;
+	}
+
+	bool EventLogReader::isCorrupt() const
+	{
+		return _isCorrupt;
+	}
+
+	const EventNames& EventLogReader::names() const
+	{
+		return _names;
+	}
+
+	bool EventLogReader::next(Event& event)
+	{
+		if (!_isOpen || _isCorrupt)
+			return false;
+
+		if ((_chunkPosition >= _chunk.size()) && !loadEventsChunk())
+			return false;
+
+		uint8_t code = _chunk[_chunkPosition++];
+		uint64_t deltaMicros = 0;
+		if ((code >= static_cast<uint8_t>(LogEvent::COUNT)) || !readVarint(_chunk, _chunkPosition, deltaMicros) ||
+			(deltaMicros > static_cast<uint64_t>(MAX_MICROS - _lastMicros)))
+		{
+			_isCorrupt = true;
+			return false;
+		}
+
+		event.event = static_cast<LogEvent>(code);
+		_lastMicros += static_cast<int64_t>(deltaMicros);
+		event.time = _startTime + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+									std::chrono::microseconds(_lastMicros));
+
+		const EventTemplate& eventTemplate = EventLog::eventTemplate(event.event);
+		event.args.clear();
+		for (size_t argIndex = 0; argIndex < eventTemplate.argsCount; ++argIndex)
+		{
+			uint64_t value = 0;
+			if (!readVarint(_chunk, _chunkPosition, value))
+			{
+				_isCorrupt = true;
+				return false;
+			}
+
+			event.args.push_back((eventTemplate.args[argIndex] == EventArgKind::INT) ? zigzagDecode(value) :
+																					   static_cast<int64_t>(value));
+		}
+
+		return true;
+	}
+
+	bool EventLogReader::loadEventsChunk()
+	{
+		char chunkHeader[5];
+		while (_fs.read(chunkHeader, sizeof(chunkHeader)))
+		{
+			char type = chunkHeader[0];
+			uint64_t size = readUInt(reinterpret_cast<const uint8_t*>(chunkHeader) + 1, 4);
+
+			// The size is checked before the payload is allocated, so a corrupt size can't exhaust the memory
+			std::streamoff position = _fs.tellg();
+			if ((position < 0) || (size > _fileSize - static_cast<uint64_t>(position)))
+			{
+				_isCorrupt = true; // Truncated, e.g. the tournament was killed
+				return false;
+			}
+
+			vector<uint8_t> payload(static_cast<size_t>(size));
+			if ((size > 0) && !_fs.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(size)))
+			{
+				_isCorrupt = true;
+				return false;
+			}
+
+			if (type == CHUNK_TYPE_NAMES)
+			{
+				if (!readNames(payload))
+				{
+					_isCorrupt = true;
+					return false;
+				}
+			}
+			else if (type == CHUNK_TYPE_EVENTS)
+			{
+				uint64_t chunkMicros = 0;
+				size_t position = 0;
+				if (!readVarint(payload, position, chunkMicros) || (chunkMicros > static_cast<uint64_t>(MAX_MICROS)))
+				{
+					_isCorrupt = true;
+					return false;
+				}
+
+				if (position >= payload.size())
+					continue; // No events
+
+				_chunk = std::move(payload);
+				_chunkPosition = position;
+				_lastMicros = static_cast<int64_t>(chunkMicros);
+				return true;
+			}
+			else
+			{
+				_isCorrupt = true;
+				return false;
+			}
+		}
+
+		return false;
+	}
+
+	bool EventLogReader::readNames(const vector<uint8_t>& payload)
+	{
+		size_t position = 0;
+		while (position < payload.size())
+		{
+			uint8_t kind = payload[position++];
+			uint64_t id = 0;
+			uint64_t length = 0;
+			if (!readVarint(payload, position, id) || !readVarint(payload, position, length) ||
+				(length > payload.size() - position))
+			{
+				return false;
+			}
+
+			// Ids continue from the names read so far, and each name of the chunk takes at least a byte of it
+			auto& names = (kind == NAMES_KIND_PLAYERS) ? _names.players : _names.boards;
+			if (id > names.size() + payload.size())
+				return false;
+
+			if (names.size() <= id)
+				names.resize(static_cast<size_t>(id) + 1);
+			names[static_cast<size_t>(id)] = string(payload.begin() + position, payload.begin() + position + length);
+			position += static_cast<size_t>(length);
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
+#include <unordered_map>
+#include "Logger.h"
+
+using std::string;
+using std::vector;
+using std::shared_ptr;
+using std::mutex;
+using std::atomic;
+using std::fstream;
+using std::ifstream;
+using std::unordered_map;
+using std::initializer_list;
+
+/** Logs an event of the template table (see LogEvent) with its arguments, e.g.
+ *  LOG_EVENT(LogEvent::GAME_FINISHED, playerA, ...). Arguments are evaluated only if the event's severity
+ *  passes the logger's filter.
+ */
+#define LOG_EVENT(event, ...)														\
+	do																				\
+	{																				\
+		battleship::EventLog& eventLog = battleship::EventLog::getInstance();		\
+		if (eventLog.isEnabled(event))												\
+			eventLog.record((event), { __VA_ARGS__ });								\
+	} while (0)
+
+// Debug events are removed at compile time along with the other debug messages (see LOG_DEBUG)
+#ifdef BATTLESHIP_STRIP_DEBUG_LOGS
+#define LOG_DEBUG_EVENT(event, ...) do { } while (0)
+#else
+#define LOG_DEBUG_EVENT(event, ...) LOG_EVENT(event, __VA_ARGS__)
+#endif
+
+namespace battleship
+{
+	/** Events of the template table, the numeric value is the event's code in the binary log */
+	enum class LogEvent : uint8_t
+	{
+		GAME_CREATED = 0,
+		GAME_STARTED = 1,
+		ATTACK = 2,
+		NO_MORE_MOVES = 3,
+		INVALID_ATTACK = 4,
+		ATTACK_RESULT = 5,
+		GAME_FINISHED = 6,
+		GAME_SKIPPED = 7,
+		COUNT
+	};
+
+	/** How an event argument is encoded and rendered */
+	enum class EventArgKind : uint8_t
+	{
+		INT,			// Signed number (zigzag varint)
+		PLAYER,			// Player id (varint), rendered as the player's name
+		BOARD,			// Board id (varint), rendered as the board's name
+		SIDE,			// 0 / 1, rendered as A / B
+		ATTACK_RESULT,	// AttackResult value, rendered as Miss / Hit / Sink
+		GAME_RESULT		// PlayerEnum value of the winner, rendered as Player A wins / Player B wins / Tie
+	};
+
+	/** An entry of the template table. The text has a {} placeholder for each argument. */
+	struct EventTemplate
+	{
+		static constexpr size_t MAX_ARGS = 8;
+
+		const char* name;
+		Severity severity;
+		const char* text;
+		size_t argsCount;
+		EventArgKind args[MAX_ARGS];
+	};
+
+	/** Output of the structured events */
+	enum class LogFormat
+	{
+		TEXT,	// Events are rendered to the text log (game.log) like any other message
+		BINARY	// Events are written to the binary log (game.blog), other messages still go to the text log
+	};
+
+	/** Names of the players and boards that event arguments refer to, ids are indices into these lists */
+	struct EventNames
+	{
+		vector<string> players;
+		vector<string> boards;
+	};
+
+	/** Events encoded by a single thread, waiting to be written as a chunk */
+	struct ThreadEventBuffer
+	{
+		mutex lock; // Only contended when the log is closed while the thread is logging
+		vector<uint8_t> bytes;
+		int64_t lastMicros; // Time of the last event in the buffer, in microseconds since the start of the log
+	};
+
+	/** Messages repeated for every game and every move are logged as events of a static template table.
+	 *  In text mode an event is rendered into the text log. In binary mode only its code, time and
+	 *  varint encoded arguments are written, with players and boards referred to by id, so debug tracing
+	 *  of a whole tournament stays small. The LogDecoder tool renders a binary log back to text or JSON.
+	 *
+	 *  Binary log layout (little endian):
+	 *  Header   - "BEL1", version, start time in microseconds since the epoch (16 bytes)
+	 *  Chunks   - type (1 byte), payload size (4 bytes), payload:
+	 *             'N' names   - kind (0 player / 1 board), id, length (varints) and the name's characters
+	 *             'E' events  - time of the chunk in microseconds since the start (varint), then events:
+	 *                           code (1 byte), microseconds since the previous event (varint), arguments
+	 *
+	 *  Each thread encodes its events into a buffer of its own, written as a chunk once full, so the events
+	 *  of a thread are in time order but chunks of different threads may overlap in time.
+	 */
+	class EventLog
+	{
+	public:
+		static constexpr uint32_t VERSION = 1;
+		static constexpr size_t HEADER_SIZE = 16;
+		static constexpr uint32_t UNKNOWN_ID = 0xFFFFFFFF;
+
+		/** Writes the remaining buffered events */
+		virtual ~EventLog();
+
+		/** Gets single instance of the event log */
+		static EventLog& getInstance();
+
+		EventLog(EventLog const&) = delete;
+		void operator=(EventLog const&) = delete;
+
+		/** Returns the template table entry of the event */
+		static const EventTemplate& eventTemplate(LogEvent event);
+
+		static bool parseFormat(const string& text, LogFormat& format);
+		static string formatToString(LogFormat format);
+
+		/** Renders the event's message from its template, names are looked up by id */
+		static string formatMessage(LogEvent event, const vector<int64_t>& args, const EventNames& names);
+
+		/** Starts writing events to the binary log in path (or rendering them to the text log).
+		 *  Must be called after the logger is loaded and before other threads start logging.
+		 */
+		void setFormat(LogFormat format, const string& path);
+
+		/** Assigns ids to the players and boards of the competition.
+		 *  Must be called before other threads start logging, names are read without locks afterwards.
+		 */
+		void registerNames(const vector<string>& players, const vector<string>& boards);
+
+		/** Returns the id of a registered player / board, or UNKNOWN_ID */
+		uint32_t playerId(const string& name) const;
+		uint32_t boardId(const string& name) const;
+
+		/** Returns true if the event passes the logger's filter (and debug sampling) */
+		bool isEnabled(LogEvent event) const
+		{
+			Logger& logger = Logger::getInstance();
+			Severity severity = eventTemplate(event).severity;
+			return logger.isEnabled(severity) && ((severity != Severity::DEBUG_LEVEL) || logger.isDebugSampled());
+		}
+
+		/** Logs the event, args must match its template */
+		void record(LogEvent event, initializer_list<int64_t> args);
+
+		/** Writes all buffered events to the binary log and closes it, later events are rendered as text */
+		void close();
+
+	private:
+		static constexpr auto BINARY_LOG_FILE = "game.blog"; // Binary log file name
+		static constexpr size_t CHUNK_SIZE = 64 * 1024; // A thread writes its buffer once it reaches this size
+
+		atomic<bool> _isBinary;
+		fstream _fs;
+		int64_t _startMicros; // Start time of the binary log, in microseconds since the epoch
+		mutex _fileLock; // Keeps chunks whole when multiple threads write them
+
+		EventNames _names;
+		unordered_map<string, uint32_t> _playerIds;
+		unordered_map<string, uint32_t> _boardIds;
+
+		vector<shared_ptr<ThreadEventBuffer>> _threadBuffers; // Buffers of all threads that logged, protected by _buffersLock
+		mutex _buffersLock;
+
+		EventLog();
+
+		/** Returns the buffer of the calling thread, registering a new one on its first event */
+		ThreadEventBuffer& threadBuffer();
+
+		/** Writes the buffer as an events chunk and clears it. Expects the buffer's lock to be held. */
+		void writeEventsChunk(ThreadEventBuffer& buffer);
+
+		/** Writes a chunk of the given type. Expects _fileLock to be held. */
+		void writeChunk(char type, const vector<uint8_t>& payload);
+
+		void writeNames(uint8_t kind, const vector<string>& names);
+	};
+
+	/** Reads the events of a binary log one by one, without loading the whole file */
+	class EventLogReader
+	{
+	public:
+		/** A single decoded event */
+		struct Event
+		{
+			LogEvent event;
+			std::chrono::system_clock::time_point time;
+			vector<int64_t> args;
+		};
+
+		/** Opens the binary log (check isOpen) */
+		explicit EventLogReader(const string& path);
+		virtual ~EventLogReader() = default;
+
+		bool isOpen() const;
+
+		/** Reads the next event, returns false at the end of the log or if the rest of it is corrupt (check isCorrupt) */
+		bool next(Event& event);
+
+		bool isCorrupt() const;
+
+		/** Names of the players and boards read so far */
+		const EventNames& names() const;
+
+	private:
+		// Start and event times past this many microseconds are corrupt (and their sum would overflow a time point)
+		static constexpr int64_t MAX_MICROS = 140LL * 365 * 24 * 3600 * 1000000;
+
+		ifstream _fs;
+		bool _isOpen;
+		bool _isCorrupt;
+		std::chrono::system_clock::time_point _startTime;
+		EventNames _names;
+		uint64_t _fileSize; // Chunks can't be larger than the rest of the file
+
+		// Events chunk being read
+		vector<uint8_t> _chunk;
+		size_t _chunkPosition;
+		int64_t _lastMicros;
+
+		/** Reads chunks until an events chunk is loaded, returns false at the end of the log */
+		bool loadEventsChunk();
+
+		bool readNames(const vector<uint8_t>& payload);
+	};
+}
@@ -0,0 +1,295 @@
+#include "Tests.h"
+#include "EventLog.h"
+#include <limits>
+#include <random>
+#include <thread>
+
+namespace battleship
+{
+	namespace
+	{
+		constexpr auto LOG_DIRECTORY = ".";
+		constexpr auto BINARY_LOG_PATH = ".\\game.blog"; // As the event log joins its directory and file name
+
+		/** An event as it was recorded */
+		struct RecordedEvent
+		{
+			LogEvent event;
+			vector<int64_t> args;
+		};
+
+		/** Returns an event with random arguments of the kinds its template expects */
+		RecordedEvent randomEvent(std::mt19937& random, const EventNames& names)
+		{
+			auto uniform = [&random](int64_t min, int64_t max) { return std::uniform_int_distribution<int64_t>(min, max)(random); };
+
+			RecordedEvent recorded{ static_cast<LogEvent>(uniform(0, static_cast<int64_t>(LogEvent::COUNT) - 1)), {} };
+			const EventTemplate& eventTemplate = EventLog::eventTemplate(recorded.event);
+			for (size_t argIndex = 0; argIndex < eventTemplate.argsCount; ++argIndex)
+			{
+				switch (eventTemplate.args[argIndex])
+				{
+					case EventArgKind::PLAYER:
+						recorded.args.push_back(uniform(0, static_cast<int64_t>(names.players.size()) - 1));
+						break;
+					case EventArgKind::BOARD:
+						recorded.args.push_back(uniform(0, static_cast<int64_t>(names.boards.size()) - 1));
+						break;
+					case EventArgKind::SIDE:
+						recorded.args.push_back(uniform(0, 1));
+						break;
+					case EventArgKind::ATTACK_RESULT:
+					case EventArgKind::GAME_RESULT:
+						recorded.args.push_back(uniform(0, 2));
+						break;
+					case EventArgKind::INT:
+					default:
+						// Mostly coordinates and points, sometimes numbers that take the whole varint
+						recorded.args.push_back((uniform(0, 9) != 0) ? uniform(-5, 100) :
+												uniform(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()));
+				}
+			}
+
+			return recorded;
+		}
+
+		/** Records the event through LOG_EVENT's entry point, which takes the arguments as an initializer list */
+		void recordEvent(const RecordedEvent& recorded)
+		{
+			EventLog& eventLog = EventLog::getInstance();
+			const vector<int64_t>& args = recorded.args;
+
+			switch (args.size())
+			{
+				case 1:
+					eventLog.record(recorded.event, { args[0] });
+					break;
+				case 3:
+					eventLog.record(recorded.event, { args[0], args[1], args[2] });
+					break;
+				case 4:
+					eventLog.record(recorded.event, { args[0], args[1], args[2], args[3] });
+					break;
+				case 8:
+					eventLog.record(recorded.event, { args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7] });
+					break;
+				default:
+					TestRunner::check(false, "No test case for events of " + std::to_string(args.size()) + " arguments");
+			}
+		}
+
+		/** Reads a (possibly damaged) binary log, checks that the events it reads are the first recorded events.
+		 *  Returns the number of events read.
+		 */
+		size_t readRecordedPrefix(const string& path, const vector<RecordedEvent>& recorded)
+		{
+			EventLogReader reader(path);
+			EventLogReader::Event event;
+			size_t eventsCount = 0;
+			bool isPrefix = true;
+
+			while (reader.next(event))
+			{
+				isPrefix = isPrefix && (eventsCount < recorded.size()) && (event.event == recorded[eventsCount].event) &&
+						   (event.args == recorded[eventsCount].args);
+				eventsCount++;
+			}
+
+			TEST_CHECK(isPrefix);
+			return eventsCount;
+		}
+
+		/** Returns the header of a log followed by a single chunk */
+		vector<char> logWithChunk(const vector<char>& log, char type, const vector<char>& payload, uint32_t payloadSize)
+		{
+			vector<char> bytes(log.begin(), log.begin() + EventLog::HEADER_SIZE);
+			bytes.push_back(type);
+			for (size_t i = 0; i < sizeof(payloadSize); ++i)
+				bytes.push_back(static_cast<char>(payloadSize >> (8 * i)));
+			bytes.insert(bytes.end(), payload.begin(), payload.end());
+			return bytes;
+		}
+	}
+
+	void eventLogTests(unsigned int seed)
+	{
+		static constexpr size_t EVENTS_COUNT = 50000; // Several chunks
+		static constexpr int THREADS_COUNT = 4;
+		static constexpr int THREAD_EVENTS_COUNT = 30000;
+
+		std::mt19937 random(seed);
+		EventLog& eventLog = EventLog::getInstance();
+		string damagedPath = TestRunner::scratchPath("damaged.blog");
+
+		// Names are written when the log starts, names registered later are added by their own chunk
+		eventLog.registerNames({ "HuntTargetAlgo.dll", "NaiveAlgo.dll" }, { "good_board_0.sboard" });
+		EventNames names;
+		for (const auto& name : { "HuntTargetAlgo.dll", "NaiveAlgo.dll", "SmartAlgo.dll" })
+			names.players.push_back(name);
+		for (const auto& name : { "good_board_0.sboard", "big.sboardb" })
+			names.boards.push_back(name);
+
+		// Round trip of a single thread's events: codes, arguments, times and names
+		vector<RecordedEvent> recorded;
+		auto startTime = std::chrono::system_clock::now() - std::chrono::milliseconds(1);
+		eventLog.setFormat(LogFormat::BINARY, LOG_DIRECTORY);
+
+		EventNames firstNames{ { names.players[0], names.players[1] }, { names.boards[0] } };
+		for (size_t event = 0; event < EVENTS_COUNT; ++event)
+		{
+			if (event == EVENTS_COUNT / 2)
+				eventLog.registerNames(names.players, names.boards);
+
+			recorded.push_back(randomEvent(random, (event < EVENTS_COUNT / 2) ? firstNames : names));
+			recordEvent(recorded.back());
+		}
+
+		eventLog.close();
+		auto endTime = std::chrono::system_clock::now();
+
+		{
+			EventLogReader reader(BINARY_LOG_PATH);
+			if (!TEST_CHECK(reader.isOpen()))
+				return;
+
+			EventLogReader::Event event;
+			size_t eventsCount = 0;
+			bool isEqual = true;
+			bool isInTimeOrder = true;
+			auto lastTime = startTime;
+
+			while (reader.next(event))
+			{
+				isEqual = isEqual && (eventsCount < recorded.size()) && (event.event == recorded[eventsCount].event) &&
+						  (event.args == recorded[eventsCount].args);
+				isInTimeOrder = isInTimeOrder && (event.time >= lastTime) && (event.time <= endTime);
+				lastTime = event.time;
+				eventsCount++;
+			}
+
+			TEST_CHECK(!reader.isCorrupt());
+			TEST_CHECK(isEqual && (eventsCount == recorded.size()));
+			TEST_CHECK(isInTimeOrder);
+
+			// The log may hold names registered by other suites, ids are the ones the event log assigned
+			const EventNames& readNames = reader.names();
+			for (const auto& player : names.players)
+			{
+				uint32_t id = eventLog.playerId(player);
+				TEST_CHECK((id < readNames.players.size()) && (readNames.players[id] == player));
+			}
+
+			for (const auto& board : names.boards)
+			{
+				uint32_t id = eventLog.boardId(board);
+				TEST_CHECK((id < readNames.boards.size()) && (readNames.boards[id] == board));
+			}
+		}
+
+		vector<char> log = TestRunner::readBytes(BINARY_LOG_PATH);
+
+		// A truncated log (e.g. the tournament was killed) reads as the events before the cut
+		for (size_t size = 0; size < log.size(); size += 1 + (size * 5) % 4093)
+		{
+			TestRunner::writeBytes(damagedPath, vector<char>(log.begin(), log.begin() + size));
+			size_t eventsCount = readRecordedPrefix(damagedPath, recorded);
+			TestRunner::check(eventsCount < recorded.size(), "Truncated log of " + std::to_string(size) + " bytes read all events");
+		}
+
+		// Random damage never makes the reader read out of its chunk
+		for (int damage = 0; damage < 300; ++damage)
+		{
+			vector<char> damaged = log;
+			int changesCount = std::uniform_int_distribution<int>(1, 4)(random);
+			for (int change = 0; change < changesCount; ++change)
+			{
+				size_t offset = std::uniform_int_distribution<size_t>(0, damaged.size() - 1)(random);
+				damaged[offset] = static_cast<char>(std::uniform_int_distribution<int>(0, 255)(random));
+			}
+
+			TestRunner::writeBytes(damagedPath, damaged);
+			EventLogReader reader(damagedPath);
+			EventLogReader::Event event;
+			while (reader.next(event));
+		}
+
+		// A chunk larger than the rest of the file is rejected before its payload is allocated
+		{
+			TestRunner::writeBytes(damagedPath, logWithChunk(log, 'E', { 0, 0 }, 0xFFFFFFFF));
+			EventLogReader reader(damagedPath);
+			EventLogReader::Event event;
+			TEST_CHECK(reader.isOpen() && !reader.next(event) && reader.isCorrupt());
+		}
+
+		// A name id far past the names read so far is rejected instead of growing the names list to it
+		{
+			vector<char> payload = { 0, static_cast<char>(0xFF), static_cast<char>(0xFF), static_cast<char>(0xFF),
+									 static_cast<char>(0xFF), 0x0F, 1, 'x' };
+			TestRunner::writeBytes(damagedPath, logWithChunk(log, 'N', payload, static_cast<uint32_t>(payload.size())));
+			EventLogReader reader(damagedPath);
+			EventLogReader::Event event;
+			TEST_CHECK(reader.isOpen() && !reader.next(event) && reader.isCorrupt());
+			TEST_CHECK(reader.names().players.empty());
+		}
+
+		// An unknown chunk type or a log of another version is rejected
+		{
+			TestRunner::writeBytes(damagedPath, logWithChunk(log, 'X', { 0 }, 1));
+			EventLogReader reader(damagedPath);
+			EventLogReader::Event event;
+			TEST_CHECK(reader.isOpen() && !reader.next(event) && reader.isCorrupt());
+
+			vector<char> damaged = log;
+			damaged[4]++;
+			TestRunner::writeBytes(damagedPath, damaged);
+			TEST_CHECK(!EventLogReader(damagedPath).isOpen());
+		}
+
+		// Threads write their chunks independently, the events of each thread keep their order.
+		// Events are recorded without LOG_EVENT, which skips them unless the logger is loaded
+		eventLog.setFormat(LogFormat::BINARY, LOG_DIRECTORY);
+		{
+			vector<std::thread> threads;
+			for (int thread = 0; thread < THREADS_COUNT; ++thread)
+			{
+				threads.emplace_back([&eventLog, thread]()
+				{
+					for (int event = 0; event < THREAD_EVENTS_COUNT; ++event)
+						eventLog.record(LogEvent::ATTACK, { thread % 2, thread, event, -event });
+				});
+			}
+
+			for (auto& thread : threads)
+				thread.join();
+		}
+
+		eventLog.close();
+
+		{
+			EventLogReader reader(BINARY_LOG_PATH);
+			EventLogReader::Event event;
+			vector<int64_t> nextEvents(THREADS_COUNT, 0);
+			bool isOrdered = true;
+
+			while (reader.next(event))
+			{
+				int64_t thread = event.args[1];
+				if ((event.event != LogEvent::ATTACK) || (thread < 0) || (thread >= THREADS_COUNT))
+				{
+					isOrdered = false;
+					break;
+				}
+
+				isOrdered = isOrdered && (event.args[0] == thread % 2) && (event.args[2] == nextEvents[thread]) &&
+							(event.args[3] == -nextEvents[thread]);
+				nextEvents[thread]++;
+			}
+
+			TEST_CHECK(!reader.isCorrupt());
+			TEST_CHECK(isOrdered);
+			for (int thread = 0; thread < THREADS_COUNT; ++thread)
+				TestRunner::check(nextEvents[thread] == THREAD_EVENTS_COUNT, "Thread " + std::to_string(thread) + " wrote " +
+								  std::to_string(nextEvents[thread]) + " of its events");
+		}
+	}
+}
@@ -4,6 +4,7 @@
 #include "GameManager.h"
 #include "AlgoCommon.h"
 #include "Logger.h"
+#include "EventLog.h"
 
 using std::cout;
 using std::endl;
@@ -112,13 +113,14 @@ namespace battleship
 			bool isPlayerBForfeit = false;
 			int playerAPoints = 0;
 			int playerBPoints = 0;
+			int movesCount = 0;
 
 			while (!isGameOver(board.get(), isPlayerAForfeit, isPlayerBForfeit))
 			{
 				// Attack
 				auto target = currentPlayer->attack();
-				string currPlayerStr = (currentPlayer == playerA) ? "A" : "B";
-				Logger::getInstance().log(Severity::DEBUG_LEVEL, "Player " + currPlayerStr + " attacks at " + to_string(target));
+				int currPlayerSide = (currentPlayer == playerB); // A - 0, B - 1
+				LOG_DEBUG_EVENT(LogEvent::ATTACK, currPlayerSide, target.row, target.col, target.depth);
 
 				if (target == NO_MORE_MOVES)
 				{	// Player chose not to attack - from now on this player forfeits the game
@@ -127,20 +129,19 @@ namespace battleship
 					else
 						isPlayerBForfeit = true;
 
-					Logger::getInstance().log(Severity::DEBUG_LEVEL,
-											  "Player " + currPlayerStr + " has no more moves.");
+					LOG_DEBUG_EVENT(LogEvent::NO_MORE_MOVES, currPlayerSide);
 					currentPlayer = switchPlayerTurns(playerA, playerB, currentPlayer, nullptr,
 						isPlayerAForfeit, isPlayerBForfeit);
 					continue;
 				}
 				else
 				{
+					movesCount++;
 					AttackValidator validator;
 
 					if (NO_MORE_MOVES == validator(target, board->height(), board->width(), board->depth()))
 					{
-						Logger::getInstance().log(Severity::DEBUG_LEVEL,
-												  "Player " + currPlayerStr + " tried to perform an invalid attack - loses turn.");
+						LOG_DEBUG_EVENT(LogEvent::INVALID_ATTACK, currPlayerSide);
 
 						// Player performed an illegal move and will lose his turn
 						currentPlayer = switchPlayerTurns(playerA, playerB, currentPlayer, nullptr,
@@ -159,23 +160,19 @@ namespace battleship
 				// Notify on attack results
 				int attackingPlayerNumber = (currentPlayer == playerB); // A - 0, B - 1
 				AttackResult attackResult;
-				string attackResultStr;
 
 				if (attackedGamePiece == nullptr)
 				{	// Miss
 					attackResult = AttackResult::Miss;
-					attackResultStr = "Miss";
 				}
 				else if (attackedGamePiece->_lifeLeft == 0)
 				{	// Sink
 					attackResult = AttackResult::Sink;
-					attackResultStr = "Sink";
 					updateCurrentGamePoints(attackedGamePiece.get(), playerAPoints, playerBPoints);
 				}
 				else
 				{	// Hit
 					attackResult = AttackResult::Hit;
-					attackResultStr = "Hit";
 				}
 
 				currentPlayer = switchPlayerTurns(playerA, playerB, currentPlayer, attackedGamePiece,
@@ -183,7 +180,7 @@ namespace battleship
 
 				playerA->notifyOnAttackResult(attackingPlayerNumber, target, attackResult);
 				playerB->notifyOnAttackResult(attackingPlayerNumber, target, attackResult);
-				Logger::getInstance().log(Severity::DEBUG_LEVEL, "Attack result: " + attackResultStr);
+				LOG_DEBUG_EVENT(LogEvent::ATTACK_RESULT, static_cast<int>(attackResult));
 			}
 
 			auto winner = getWinner(board.get());
@@ -192,6 +189,7 @@ namespace battleship
 			results->winner = winner;
 			results->playerAPoints = playerAPoints;
 			results->playerBPoints = playerBPoints;
+			results->movesCount = movesCount;
 
 			return results;
 		}
@@ -200,8 +198,8 @@ namespace battleship
 			// This is possible if one of the players causes a fault.
 			// Errors that are caught by this barrier are logged with the logger
 			string errorMsg = e.what();
-			Logger::getInstance().log(Severity::ERROR_LEVEL,
-									  "Error: an error occured during game session, declaring a tie with 0 points. Details: " + errorMsg);
+			LOG_LIMITED(Severity::ERROR_LEVEL,
+						"Error: an error occured during game session, declaring a tie with 0 points. Details: " + errorMsg);
 			
 			// Since an error have occured and the game finished unexpectedly 
 			// we declare a tie and nobody gets points for this game
@@ -209,6 +207,7 @@ namespace battleship
 			results->winner = PlayerEnum::NONE;
 			results->playerAPoints = 0;
 			results->playerBPoints = 0;
+			results->movesCount = 0;
 
 			return results;
 		}
@@ -18,6 +18,7 @@ namespace battleship
 		PlayerEnum winner;
 		int playerAPoints;
 		int playerBPoints;
+		int movesCount; // Attacks performed by both players (including invalid attacks)
 	};
 
 	/** Manages a session of a single game, in stateless manner to enable thread-saftey */
@@ -0,0 +1,123 @@
+#include "GroupsPlayoffsFormat.h"
+#include "Logger.h"
+
+using std::to_string;
+
+namespace battleship
+{
+	GroupsPlayoffsFormat::GroupsPlayoffsFormat(const vector<string>& players, const vector<string>& boards,
+											   int matchBoards, int groupSize, int groupAdvance) :
+		TournamentFormat(players, boards, matchBoards),
+		_maxGroupSize(0)
+	{
+		size_t size = (groupSize >= 2) ? static_cast<size_t>(groupSize) : 2;
+		size_t groupsCount = (players.size() + size - 1) / size;
+		if (groupsCount < 1)
+			groupsCount = 1;
+
+		// Snake seeding keeps groups balanced: 1..n to the groups, then n..1, and so on
+		_groups.resize(groupsCount);
+		for (size_t i = 0; i < players.size(); ++i)
+		{
+			size_t pass = i / groupsCount;
+			size_t offset = i % groupsCount;
+			size_t group = (pass % 2 == 0) ? offset : (groupsCount - 1 - offset);
+			_groups[group].push_back(players[i]);
+		}
+
+		size_t minGroupSize = players.size();
+		for (const auto& group : _groups)
+		{
+			_maxGroupSize = (group.size() > _maxGroupSize) ? group.size() : _maxGroupSize;
+			minGroupSize = (group.size() < minGroupSize) ? group.size() : minGroupSize;
+		}
+
+		// Every group must be able to send the same number of players to the playoffs
+		_groupAdvance = (groupAdvance >= 1) ? static_cast<size_t>(groupAdvance) : 1;
+		if (_groupAdvance > minGroupSize)
+			_groupAdvance = minGroupSize;
+	}
+
+	size_t GroupsPlayoffsFormat::maxRoundsPerPlayer() const
+	{
+		size_t groupStageRounds = (_maxGroupSize - 1) * gamesPerMatch();
+		size_t playoffRounds = log2Ceil(_groups.size() * _groupAdvance) * gamesPerMatch();
+		return groupStageRounds + playoffRounds;
+	}
+
+	void GroupsPlayoffsFormat::buildGroupStage(TournamentStage& stage)
+	{
+		vector<Match> matches;
+
+		for (const auto& group : _groups)
+		{
+			for (size_t a = 0; a < group.size(); ++a)
+			{
+				for (size_t b = a + 1; b < group.size(); ++b)
+					matches.push_back(Match{ group[a], group[b] });
+			}
+
+			// Players of smaller groups are credited with byes to keep all players in step
+			size_t missingMatches = _maxGroupSize - group.size();
+			if (missingMatches > 0)
+			{
+				for (const auto& player : group)
+					stage.byes.push_back(std::make_pair(player, missingMatches * gamesPerMatch()));
+			}
+		}
+
+		appendMatchGames(matches, stage);
+
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Group stage: " + to_string(_groups.size()) + " groups, " +
+								  to_string(matches.size()) + " matches, top " + to_string(_groupAdvance) +
+								  " of each group advance to the playoffs");
+	}
+
+	void GroupsPlayoffsFormat::buildPlayoffs(const Standings& standings, vector<string>& retiredPlayers)
+	{
+		// Group winners are seeded first, then the runners up, and so on
+		vector<string> advancing;
+		vector<vector<string>> groupTables;
+		for (const auto& group : _groups)
+			groupTables.push_back(rankPlayers(group, standings));
+
+		for (size_t place = 0; place < _groupAdvance; ++place)
+		{
+			for (const auto& table : groupTables)
+				advancing.push_back(table[place]);
+		}
+
+		for (const auto& table : groupTables)
+		{
+			for (size_t place = _groupAdvance; place < table.size(); ++place)
+				retiredPlayers.push_back(table[place]);
+		}
+
+		_playoffs = std::make_unique<EliminationFormat>(advancing, _boards, static_cast<int>(_matchBoards), 1, true);
+	}
+
+	bool GroupsPlayoffsFormat::nextStage(const Standings& standings, TournamentStage& stage)
+	{
+		if (_players.size() < 2)
+			return false;
+
+		if (_stagesPlayed == 0)
+		{
+			buildGroupStage(stage);
+			_stagesPlayed++;
+			return true;
+		}
+
+		if (_playoffs == nullptr)
+			buildPlayoffs(standings, stage.retiredPlayers);
+
+		_stagesPlayed++;
+		return _playoffs->nextStage(standings, stage);
+	}
+
+	string GroupsPlayoffsFormat::summary() const
+	{
+		return (_playoffs != nullptr) ? _playoffs->summary() : "";
+	}
+}
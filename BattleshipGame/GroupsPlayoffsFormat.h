@@ -0,0 +1,44 @@
+#pragma once
+
+#include "TournamentFormat.h"
+#include "EliminationFormat.h"
+
+namespace battleship
+{
+	/** Group stage followed by playoffs: players are seeded into groups of groupSize (snake order),
+	 *  each group plays a round robin, and the top groupAdvance players of each group go on to a single
+	 *  elimination playoff. Costs O(players * groupSize * boards) games.
+	 */
+	class GroupsPlayoffsFormat : public TournamentFormat
+	{
+	public:
+		GroupsPlayoffsFormat(const vector<string>& players, const vector<string>& boards, int matchBoards,
+							 int groupSize, int groupAdvance);
+		virtual ~GroupsPlayoffsFormat() = default;
+
+		size_t maxRoundsPerPlayer() const override;
+		bool nextStage(const Standings& standings, TournamentStage& stage) override;
+		string summary() const override;
+
+	private:
+		// Players of each group
+		vector<vector<string>> _groups;
+
+		// Number of players advancing from each group
+		size_t _groupAdvance;
+
+		// Size of the largest group
+		size_t _maxGroupSize;
+
+		// Playoffs, created once the group stage is over
+		unique_ptr<EliminationFormat> _playoffs;
+
+		/** Builds the group stage: a round robin within each group */
+		void buildGroupStage(TournamentStage& stage);
+
+		/** Picks the players advancing from each group and creates the playoffs,
+		 *  the rest of the players are added to retiredPlayers
+		 */
+		void buildPlayoffs(const Standings& standings, vector<string>& retiredPlayers);
+	};
+}
@@ -15,6 +15,7 @@ HuntTargetAlgo::HuntTargetAlgo():  IBattleshipGameAlgo(),
 								   playerId(0),
 								   boardSize(std::make_tuple(0, 0, 0)),
 								   visitedCoords({}),
+								   unvisitedCursor(0),
 								   lastAttackDirection(AttackDirection::InPlace)
 {
 }
@@ -32,27 +33,27 @@ void HuntTargetAlgo::setPlayer(int player)
 void HuntTargetAlgo::markRowNeighbors(Coordinate coord)
 {
 	if ((coord.row + 1) < std::get<0>(boardSize))
-		visitedCoords.emplace(coord.row + 1, coord.col, coord.depth);
+		markVisited(Coordinate(coord.row + 1, coord.col, coord.depth));
 	if ((coord.row - 1) >= 0)
-		visitedCoords.emplace(coord.row - 1, coord.col, coord.depth);
+		markVisited(Coordinate(coord.row - 1, coord.col, coord.depth));
 }
 
 // This function assumes that coord is inside the board
 void HuntTargetAlgo::markColNeighbors(Coordinate coord)
 {
 	if ((coord.col + 1) < std::get<1>(boardSize))
-		visitedCoords.emplace(coord.row, coord.col + 1, coord.depth);
+		markVisited(Coordinate(coord.row, coord.col + 1, coord.depth));
 	if ((coord.col - 1) >= 0)
-		visitedCoords.emplace(coord.row, coord.col - 1, coord.depth);
+		markVisited(Coordinate(coord.row, coord.col - 1, coord.depth));
 }
 
 // This function assumes that coord is inside the board
 void HuntTargetAlgo::markDepthNeighbors(Coordinate coord)
 {
 	if ((coord.depth + 1) < std::get<2>(boardSize))
-		visitedCoords.emplace(coord.row, coord.col, coord.depth + 1);		
+		markVisited(Coordinate(coord.row, coord.col, coord.depth + 1));		
 	if ((coord.depth - 1) >= 0)
-		visitedCoords.emplace(coord.row, coord.col, coord.depth - 1);
+		markVisited(Coordinate(coord.row, coord.col, coord.depth - 1));
 }
 
 void HuntTargetAlgo::setBoard(const BoardData& board)
@@ -61,7 +62,10 @@ void HuntTargetAlgo::setBoard(const BoardData& board)
 	std::get<1>(boardSize) = board.cols();
 	std::get<2>(boardSize) = board.depth();
 
-	visitedCoords = {};
+	// A bit per square, a board of a million squares takes 125KB
+	visitedCoords.assign(static_cast<size_t>(std::get<0>(boardSize)) * std::get<1>(boardSize) * std::get<2>(boardSize),
+						 false);
+	unvisitedCursor = 0;
 	targetsMap = {};
 
 	// Mark our ships and their surrounding as visited
@@ -74,7 +78,7 @@ void HuntTargetAlgo::setBoard(const BoardData& board)
 				if (board.charAt(Coordinate(i+1, j+1, k+1)) != static_cast<char>(BoardSquare::Empty))
 				{
 					Coordinate coord(i, j, k);
-					visitedCoords.insert(coord);
+					markVisited(coord);
 					markRowNeighbors(coord);
 					markColNeighbors(coord);
 					markDepthNeighbors(coord);
@@ -86,21 +90,49 @@ void HuntTargetAlgo::setBoard(const BoardData& board)
 	srand(static_cast<unsigned int>(time(nullptr)));	// Initialize random seed
 }
 
-Coordinate HuntTargetAlgo::searchUnvisitedCoord()
+size_t HuntTargetAlgo::squareIndex(const Coordinate& coord) const
 {
-	for (int i = 0; i < std::get<0>(boardSize); ++i)
+	return (static_cast<size_t>(coord.row) * std::get<1>(boardSize) + coord.col) * std::get<2>(boardSize) + coord.depth;
+}
+
+bool HuntTargetAlgo::isVisited(const Coordinate& coord) const
+{
+	if ((coord.row < 0) || (coord.row >= std::get<0>(boardSize)) || (coord.col < 0) ||
+		(coord.col >= std::get<1>(boardSize)) || (coord.depth < 0) || (coord.depth >= std::get<2>(boardSize)))
 	{
-		for (int j = 0; j < std::get<1>(boardSize); ++j)
-		{
-			for (int k = 0; k < std::get<2>(boardSize); ++k)
-			{
-				if (visitedCoords.find(Coordinate(i, j, k)) == visitedCoords.end())
-					return Coordinate(i+1, j+1, k+1);
-			}
-		}
+		return false;
 	}
 
-	return NO_MORE_MOVES;
+	return visitedCoords[squareIndex(coord)];
+}
+
+void HuntTargetAlgo::markVisited(const Coordinate& coord)
+{
+	if ((coord.row < 0) || (coord.row >= std::get<0>(boardSize)) || (coord.col < 0) ||
+		(coord.col >= std::get<1>(boardSize)) || (coord.depth < 0) || (coord.depth >= std::get<2>(boardSize)))
+	{
+		return;
+	}
+
+	visitedCoords[squareIndex(coord)] = true;
+}
+
+Coordinate HuntTargetAlgo::searchUnvisitedCoord()
+{
+	// A visited square stays visited, so the squares before the cursor are never searched again
+	while ((unvisitedCursor < visitedCoords.size()) && visitedCoords[unvisitedCursor])
+		unvisitedCursor++;
+
+	if (unvisitedCursor == visitedCoords.size())
+		return NO_MORE_MOVES;
+
+	int depth = std::get<2>(boardSize);
+	int cols = std::get<1>(boardSize);
+	int k = static_cast<int>(unvisitedCursor % depth);
+	int j = static_cast<int>((unvisitedCursor / depth) % cols);
+	int i = static_cast<int>(unvisitedCursor / depth / cols);
+
+	return Coordinate(i+1, j+1, k+1);
 }
 
 AttackDirection HuntTargetAlgo::drawAvailableDirection(const map<AttackDirection, int>& directionMap)
@@ -144,7 +176,7 @@ bool HuntTargetAlgo::calcTargetNext(Coordinate& coord, AttackDirection direction
 	case AttackDirection::RowPlus:
 	{
 		if ((coord.row + size > std::get<0>(boardSize)) ||
-			(visitedCoords.find(Coordinate(coord.row-1+size, coord.col-1, coord.depth-1)) != visitedCoords.end()))
+			isVisited(Coordinate(coord.row-1+size, coord.col-1, coord.depth-1)))
 			return false;
 		coord.row += size;
 		return true;
@@ -152,7 +184,7 @@ bool HuntTargetAlgo::calcTargetNext(Coordinate& coord, AttackDirection direction
 	case AttackDirection::RowMinus:
 	{
 		if ((coord.row - size < 1) ||
-			(visitedCoords.find(Coordinate(coord.row-1-size, coord.col-1, coord.depth-1)) != visitedCoords.end()))
+			isVisited(Coordinate(coord.row-1-size, coord.col-1, coord.depth-1)))
 			return false;
 		coord.row -= size;
 		return true;
@@ -160,7 +192,7 @@ bool HuntTargetAlgo::calcTargetNext(Coordinate& coord, AttackDirection direction
 	case AttackDirection::ColPlus:
 	{
 		if ((coord.col + size > std::get<1>(boardSize)) ||
-			(visitedCoords.find(Coordinate(coord.row-1, coord.col-1+size, coord.depth-1)) != visitedCoords.end()))
+			isVisited(Coordinate(coord.row-1, coord.col-1+size, coord.depth-1)))
 			return false;
 		coord.col += size;
 		return true;
@@ -168,7 +200,7 @@ bool HuntTargetAlgo::calcTargetNext(Coordinate& coord, AttackDirection direction
 	case AttackDirection::ColMinus:
 	{
 		if ((coord.col - size < 1) ||
-			(visitedCoords.find(Coordinate(coord.row-1, coord.col-1-size, coord.depth-1)) != visitedCoords.end()))
+			isVisited(Coordinate(coord.row-1, coord.col-1-size, coord.depth-1)))
 			return false;
 		coord.col -= size;
 		return true;
@@ -176,7 +208,7 @@ bool HuntTargetAlgo::calcTargetNext(Coordinate& coord, AttackDirection direction
 	case AttackDirection::DepthPlus:
 	{
 		if ((coord.depth + size > std::get<2>(boardSize)) ||
-			(visitedCoords.find(Coordinate(coord.row-1, coord.col-1, coord.depth-1+size)) != visitedCoords.end()))
+			isVisited(Coordinate(coord.row-1, coord.col-1, coord.depth-1+size)))
 			return false;
 		coord.depth += size;
 		return true;
@@ -184,7 +216,7 @@ bool HuntTargetAlgo::calcTargetNext(Coordinate& coord, AttackDirection direction
 	case AttackDirection::DepthMinus:
 	{
 		if ((coord.depth - size < 1) ||
-			(visitedCoords.find(Coordinate(coord.row-1, coord.col-1, coord.depth-1-size)) != visitedCoords.end()))
+			isVisited(Coordinate(coord.row-1, coord.col-1, coord.depth-1-size)))
 			return false;
 		coord.depth -= size;
 		return true;
@@ -208,7 +240,7 @@ Coordinate HuntTargetAlgo::attack()
 				coord.col = rand() % std::get<1>(boardSize) + 1;	// In the range 1 to number of columns
 				coord.depth = rand() % std::get<2>(boardSize) + 1;	// In the range 1 to number of depths
 				drawsCounter++;
-			} while ((visitedCoords.find(Coordinate(coord.row-1, coord.col-1, coord.depth-1)) != visitedCoords.end()) &&
+			} while (isVisited(Coordinate(coord.row-1, coord.col-1, coord.depth-1)) &&
 					 (drawsCounter <= MAX_NUM_OF_DRAWS));
 			
 			lastAttackDirection = AttackDirection::InPlace;
@@ -368,7 +400,7 @@ void HuntTargetAlgo::removeRedundantTargets(Coordinate coord, AttackDirection di
 
 void HuntTargetAlgo::notifyOnAttackInTarget(Coordinate moveZeroBased, targetsMapEntry target, AttackResult result)
 {
-	visitedCoords.insert(moveZeroBased);
+	markVisited(moveZeroBased);
 
 	int currTargetSize = getTargetSize(target->second);
 
@@ -439,27 +471,27 @@ void HuntTargetAlgo::notifyOnAttackInTarget(Coordinate moveZeroBased, targetsMap
 		// Mark the other edge as visited
 		if ((lastAttackDirection == AttackDirection::RowPlus) && (moveZeroBased.row-currTargetSize >= 0))
 		{
-			visitedCoords.emplace(moveZeroBased.row-currTargetSize, moveZeroBased.col, moveZeroBased.depth);
+			markVisited(Coordinate(moveZeroBased.row-currTargetSize, moveZeroBased.col, moveZeroBased.depth));
 		}
 		else if ((lastAttackDirection == AttackDirection::RowMinus) && (moveZeroBased.row+currTargetSize < std::get<0>(boardSize)))
 		{
-			visitedCoords.emplace(moveZeroBased.row+currTargetSize, moveZeroBased.col, moveZeroBased.depth);
+			markVisited(Coordinate(moveZeroBased.row+currTargetSize, moveZeroBased.col, moveZeroBased.depth));
 		}
 		else if ((lastAttackDirection == AttackDirection::ColPlus) && (moveZeroBased.col-currTargetSize >= 0))
 		{
-			visitedCoords.emplace(moveZeroBased.row, moveZeroBased.col-currTargetSize, moveZeroBased.depth);
+			markVisited(Coordinate(moveZeroBased.row, moveZeroBased.col-currTargetSize, moveZeroBased.depth));
 		}
 		else if ((lastAttackDirection == AttackDirection::ColMinus) && (moveZeroBased.col+currTargetSize < std::get<1>(boardSize)))
 		{
-			visitedCoords.emplace(moveZeroBased.row, moveZeroBased.col+currTargetSize, moveZeroBased.depth);
+			markVisited(Coordinate(moveZeroBased.row, moveZeroBased.col+currTargetSize, moveZeroBased.depth));
 		}
 		else if ((lastAttackDirection == AttackDirection::DepthPlus) && (moveZeroBased.depth-currTargetSize >= 0))
 		{
-			visitedCoords.emplace(moveZeroBased.row, moveZeroBased.col, moveZeroBased.depth-currTargetSize);
+			markVisited(Coordinate(moveZeroBased.row, moveZeroBased.col, moveZeroBased.depth-currTargetSize));
 		}
 		else if ((lastAttackDirection == AttackDirection::DepthMinus) && (moveZeroBased.depth+currTargetSize < std::get<2>(boardSize)))
 		{
-			visitedCoords.emplace(moveZeroBased.row, moveZeroBased.col, moveZeroBased.depth+currTargetSize);
+			markVisited(Coordinate(moveZeroBased.row, moveZeroBased.col, moveZeroBased.depth+currTargetSize));
 		}
 
 		AttackDirection targetDirection = getTargetDirection(target);
@@ -477,9 +509,9 @@ void HuntTargetAlgo::notifyOnAttackResult(int player, Coordinate move, AttackRes
 		if (targetsMap.empty())	// The attack comes from Hunt mode or other player
 		{
 			if ((player == playerId) ||
-				((player != playerId) && (visitedCoords.find(moveZeroBased) == visitedCoords.end())))
+				((player != playerId) && (!isVisited(moveZeroBased))))
 			{
-				visitedCoords.insert(moveZeroBased);
+				markVisited(moveZeroBased);
 
 				if (result == AttackResult::Hit)	// New target
 				{
@@ -504,9 +536,9 @@ void HuntTargetAlgo::notifyOnAttackResult(int player, Coordinate move, AttackRes
 			// The attack comes from other player
 			if (player != playerId)
 			{
-				if (visitedCoords.find(moveZeroBased) == visitedCoords.end())
+				if (!isVisited(moveZeroBased))
 				{
-					visitedCoords.insert(moveZeroBased);
+					markVisited(moveZeroBased);
 					// Search for existing target
 					targetsMapEntry updateMapResult = updateMapOnOtherAttack(moveZeroBased, result);
 					if ((updateMapResult == targetsMap.end()) || (result == AttackResult::Miss))
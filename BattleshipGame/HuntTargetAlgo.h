@@ -3,14 +3,12 @@
 #include <tuple>
 #include <vector>
 #include <map>
-#include <unordered_set>
 #include "IBattleshipGameAlgo.h"
 #include "AlgoCommon.h"
 
 using std::tuple;
 using std::vector;
 using std::map;
-using std::unordered_set;
 
 enum class AttackDirection
 {
@@ -52,8 +50,12 @@ private:
 
 	tuple<int, int, int> boardSize;
 
-	// An unordered set of the coordinates that have already been visited (by us or by the opponent)
-	unordered_set<Coordinate, CoordinateHash> visitedCoords;
+	// The squares that have already been visited (by us or by the opponent), a bit per square of the board,
+	// indexed by squareIndex
+	vector<bool> visitedCoords;
+
+	// All squares before this index are visited
+	size_t unvisitedCursor;
 	
 	// Our last attack direction. If the last attack was in Hunt mode this field is not relevant
 	AttackDirection lastAttackDirection;
@@ -80,6 +82,15 @@ private:
 
 	static void advanceInDirection(Coordinate& coord, AttackDirection direction, int size);
 
+	// coord is in the range 0 to board size - 1
+	size_t squareIndex(const Coordinate& coord) const;
+
+	// coord is in the range 0 to board size - 1, squares outside the board are never visited
+	bool isVisited(const Coordinate& coord) const;
+
+	// coord is in the range 0 to board size - 1, squares outside the board are ignored
+	void markVisited(const Coordinate& coord);
+
 	// Search for an unvisited coordinate in 'visitedCoords'. The returned coordiante is in the range 1 to board size.
 	// If no square was found, battleship::NO_MORE_MOVES is returned.
 	Coordinate searchUnvisitedCoord();
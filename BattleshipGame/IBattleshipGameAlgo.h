@@ -63,3 +63,10 @@ public:
  * When working with shared objects (dlls), the interface must be a C interface.
  */
 ALGO_API IBattleshipGameAlgo* GetAlgorithm(); // This method must be implemented in each player(algorithm) .cpp file
+
+/* Optional export: a player that returns true declares that it plays a board the same no matter how the board is
+ * mirrored or rotated (e.g. it doesn't prefer scanning from a specific corner). When both players of a game declare
+ * it, the game is played on a single board of each group of mirrored or rotated boards, and its result is
+ * credited to the games on the other boards of the group.
+ */
+ALGO_API bool IsSymmetryInvariant();
@@ -77,7 +77,7 @@ namespace battleship
 		if (!fs.is_open())
 		{
 			string errorMsg = "Failed to open file " + filename;
-			Logger::getInstance().log(Severity::ERROR_LEVEL, errorMsg);
+			LOG_LIMITED(Severity::ERROR_LEVEL, errorMsg);
 			return false;
 		}
 
@@ -113,7 +113,7 @@ namespace battleship
 		// This term is activated only in the case when ifstream's badbit is set
 		if (fs.bad()) {
 			string errorMsg = "IO error occured while reading file " + filename;
-			Logger::getInstance().log(Severity::ERROR_LEVEL, errorMsg);
+			LOG_LIMITED(Severity::ERROR_LEVEL, errorMsg);
 			return false;
 		}
 
@@ -159,6 +159,12 @@ namespace battleship
 		return isValid;
 	}
 
+	bool IOUtil::validateFile(const string& path)
+	{
+		DWORD attributes = GetFileAttributesA(path.c_str()); // Notice: Unicode compatible version of GetFileAttributes
+		return ((attributes != INVALID_FILE_ATTRIBUTES) && !(attributes & FILE_ATTRIBUTE_DIRECTORY));
+	}
+
 	vector<string> IOUtil::listFilesInPath(const string& path, const string& extension)
 	{
 		vector<string> fileList;
@@ -186,6 +192,36 @@ namespace battleship
 		return fileList;
 	}
 
+	uint64_t IOUtil::hashBytes(const char* bytes, size_t count, uint64_t hash)
+	{
+		static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			hash ^= static_cast<unsigned char>(bytes[i]);
+			hash *= FNV_PRIME;
+		}
+
+		return hash;
+	}
+
+	void IOUtil::putString(vector<char>& buffer, const string& value)
+	{
+		putValue(buffer, static_cast<uint32_t>(value.size()));
+		buffer.insert(buffer.end(), value.begin(), value.end());
+	}
+
+	bool IOUtil::getString(const char*& cursor, const char* end, string& value)
+	{
+		uint32_t length = 0;
+		if (!getValue(cursor, end, length) || (static_cast<size_t>(end - cursor) < length))
+			return false;
+
+		value.assign(cursor, length);
+		cursor += length;
+		return true;
+	}
+
 	string IOUtil::convertPathToAbsolute(const string& path)
 	{
 		const int BUFFER_SIZE = 1024;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <vector>
@@ -64,6 +66,9 @@ namespace battleship
 		/** Returns true if the path argument points to a real valid path on disk, false if not. */
 		static bool validatePath(const string& path);
 
+		/** Returns true if the path argument points to an existing file (not a directory) on disk, false if not. */
+		static bool validateFile(const string& path);
+
 		/** Lists all files found in the given path with the given extension (without a dot, e.g. "sboard").
 		 *  Path is expected to be valid (e.g verified with "validatePath").
 		 *  If no files with the given extension are found, an empty vector is returned.
@@ -77,6 +82,37 @@ namespace battleship
 		 */
 		static string convertPathToAbsolute(const string& path);
 
+		/** Returns the 64 bit FNV-1a hash of the bytes. Pass the hash of previous bytes to hash a sequence in parts. */
+		static uint64_t hashBytes(const char* bytes, size_t count, uint64_t hash = HASH_OFFSET_BASIS);
+
+		static constexpr uint64_t HASH_OFFSET_BASIS = 14695981039346656037ULL;
+
+		/** Appends the raw bytes of value to the buffer */
+		template <typename T>
+		static void putValue(vector<char>& buffer, T value)
+		{
+			const char* bytes = reinterpret_cast<const char*>(&value);
+			buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+		}
+
+		/** Appends the string's length (4 bytes) and characters to the buffer */
+		static void putString(vector<char>& buffer, const string& value);
+
+		/** Reads a value at the cursor and advances it, returns false if the value exceeds the end */
+		template <typename T>
+		static bool getValue(const char*& cursor, const char* end, T& value)
+		{
+			if (static_cast<size_t>(end - cursor) < sizeof(T))
+				return false;
+
+			std::memcpy(&value, cursor, sizeof(T));
+			cursor += sizeof(T);
+			return true;
+		}
+
+		/** Reads a string written by putString at the cursor and advances it, returns false if it exceeds the end */
+		static bool getString(const char*& cursor, const char* end, string& value);
+
 	private:
 		IOUtil() = default;	// This helper class shouldn't be instantiated
 	};
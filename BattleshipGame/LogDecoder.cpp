@@ -0,0 +1,148 @@
+#include "EventLog.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <ctime>
+#include <string>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::stringstream;
+using battleship::EventLog;
+using battleship::EventLogReader;
+using battleship::EventTemplate;
+using battleship::EventArgKind;
+using battleship::Logger;
+
+/** Decoder of the binary events log (game.blog) written with LOG_FORMAT=binary in config.ini.
+ *  Usage: LogDecoder <binary log file> [text|json]
+ *  text - The same lines the text log (game.log) would have had
+ *  json - One JSON object per event (JSON Lines), with names in place of ids
+ */
+
+static constexpr int SUCCESS_CODE = 0;
+static constexpr int ERROR_CODE = -1;
+
+static string formatTime(std::chrono::system_clock::time_point time, const char* format)
+{
+	time_t t = std::chrono::system_clock::to_time_t(time);
+	struct tm timeinfo;
+	if (localtime_s(&timeinfo, &t))
+		return "";
+
+	stringstream ss;
+	ss << std::put_time(&timeinfo, format);
+	return ss.str();
+}
+
+static string jsonString(const string& value)
+{
+	string escaped = "\"";
+	for (char c : value)
+	{
+		if ((c == '"') || (c == '\\'))
+		{
+			escaped += '\\';
+			escaped += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+		{
+			stringstream ss;
+			ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+			escaped += ss.str();
+		}
+		else
+		{
+			escaped += c;
+		}
+	}
+
+	return escaped + "\"";
+}
+
+static void printText(const EventLogReader::Event& event, const battleship::EventNames& names)
+{
+	const EventTemplate& eventTemplate = EventLog::eventTemplate(event.event);
+
+	// Same layout as the lines of the text log
+	cout << "[" << formatTime(event.time, "%d-%m-%Y %H:%M:%S") << "][" << Logger::severityToString(eventTemplate.severity)
+		 << "] " << EventLog::formatMessage(event.event, event.args, names) << '\n';
+}
+
+static void printJson(const EventLogReader::Event& event, const battleship::EventNames& names)
+{
+	const EventTemplate& eventTemplate = EventLog::eventTemplate(event.event);
+	auto micros = std::chrono::duration_cast<std::chrono::microseconds>(event.time.time_since_epoch()).count() % 1000000;
+
+	stringstream time;
+	time << formatTime(event.time, "%Y-%m-%dT%H:%M:%S") << "." << std::setw(6) << std::setfill('0') << micros;
+
+	cout << "{\"time\":" << jsonString(time.str()) << ",\"severity\":"
+		 << jsonString(Logger::severityToString(eventTemplate.severity)) << ",\"event\":" << jsonString(eventTemplate.name)
+		 << ",\"args\":[";
+
+	for (size_t argIndex = 0; argIndex < event.args.size(); ++argIndex)
+	{
+		int64_t value = event.args[argIndex];
+		if (argIndex > 0)
+			cout << ",";
+
+		// Players and boards are written by name, everything else as a number
+		EventArgKind kind = eventTemplate.args[argIndex];
+		if ((kind == EventArgKind::PLAYER) || (kind == EventArgKind::BOARD))
+		{
+			const auto& list = (kind == EventArgKind::PLAYER) ? names.players : names.boards;
+			bool isKnown = (value >= 0) && (static_cast<size_t>(value) < list.size());
+			cout << (isKnown ? jsonString(list[static_cast<size_t>(value)]) : string("null"));
+		}
+		else
+		{
+			cout << value;
+		}
+	}
+
+	cout << "],\"message\":" << jsonString(EventLog::formatMessage(event.event, event.args, names)) << "}\n";
+}
+
+int main(int argc, char* argv[])
+{
+	if ((argc < 2) || (argc > 3))
+	{
+		cerr << "Error: Try: LogDecoder <binary log file> [text|json]" << endl;
+		return ERROR_CODE;
+	}
+
+	string output = (argc == 3) ? argv[2] : "text";
+	if ((output != "text") && (output != "json"))
+	{
+		cerr << "Error: Unknown output " << output << ". Try: text or json" << endl;
+		return ERROR_CODE;
+	}
+
+	EventLogReader log(argv[1]);
+	if (!log.isOpen())
+	{
+		cerr << "Error: " << argv[1] << " is missing or isn't a valid binary log" << endl;
+		return ERROR_CODE;
+	}
+
+	EventLogReader::Event event;
+	while (log.next(event))
+	{
+		if (output == "json")
+			printJson(event, log.names());
+		else
+			printText(event, log.names());
+	}
+
+	cout << std::flush;
+
+	if (log.isCorrupt())
+	{
+		cerr << "Error: " << argv[1] << " is truncated or corrupt, events after this point can't be decoded" << endl;
+		return ERROR_CODE;
+	}
+
+	return SUCCESS_CODE;
+}
@@ -3,28 +3,83 @@
 #include <iomanip>
 #include <ctime>
 #include <sstream>
+#include <algorithm>
 
 using std::cout;
 using std::cerr;
 using std::endl;
 using std::lock_guard;
+using std::unique_lock;
+using std::to_string;
 
 namespace battleship
-{		
+{
+	// Buffer of the calling thread in asynchronous mode (shared with the logger, which drains it)
+	static thread_local shared_ptr<ThreadLogBuffer> currentThreadBuffer;
+
+	// State of the debug sampling generator of the calling thread (xorshift)
+	static thread_local uint32_t currentThreadSampleState = 0;
+
+	LogSite::LogSite(const char* file, int line) :
+		file(file),
+		line(line),
+		windowStartMillis(0),
+		windowCount(0),
+		suppressedCount(0),
+		lastSeverity(static_cast<int>(Severity::WARNING_LEVEL))
+	{
+	}
+
+	ThreadLogBuffer::ThreadLogBuffer(size_t capacity) :
+		records(capacity),
+		droppedCount(0)
+	{
+	}
+
 	Logger::Logger():
 		_path(nullptr), // Default log level: show everything
-		_limit(Severity::DEBUG_LEVEL)
+		_limit(Severity::DEBUG_LEVEL),
+		_rateLimit(0),
+		_debugSamplingPercent(100),
+		_isAsync(false),
+		_overflowPolicy(LogOverflowPolicy::BLOCK),
+		_isWriterStopping(false),
+		_isDrainRequested(false),
+		_drainsCount(0)
 	{
 	} 
 
 	Logger::~Logger()
 	{
-		log(Severity::INFO_LEVEL, "Terminating logger..");
+		// shutdown() stops the background writer before main returns. A writer that is still running can't be
+		// joined safely during static destruction, so it's only detached and its buffered messages are lost.
+		if (_writerThread.joinable())
+			_writerThread.detach();
+
+		// The last messages are written directly, without the per-thread buffers (already destroyed by now)
+		if ((_path != nullptr) && _fs)
+		{
+			lock_guard<mutex> lock(_outputLock);
+			auto now = std::chrono::system_clock::now();
+
+			// Summaries of the messages suppressed since the last window of each site
+			for (auto& site : _sites)
+			{
+				Severity severity = static_cast<Severity>(site->lastSeverity.load());
+				string summary = suppressedSummary(*site);
+				if (!summary.empty() && (severity >= _limit))
+					writeRecord(severity, now, summary);
+			}
+
+			if (Severity::INFO_LEVEL >= _limit)
+				writeRecord(Severity::INFO_LEVEL, now, "Terminating logger..");
+		}
+
 		_fs.close();
 
 		// Stream errors are guaranteed to appear only after "flush",
 		// which is only guaranteed when we explicitly flush or close the file for writing
-		if (!_fs)
+		if ((_path != nullptr) && !_fs)
 		{
 			auto logFilePath = *_path + "\\" + LOG_FILE;
 			cerr << "Error: IO error when flushing logger content to " << logFilePath << endl;
@@ -72,19 +127,286 @@ namespace battleship
 		if (severity < _limit)
 			return;
 
-		string severityStr = severityToString(severity);
+		auto now = std::chrono::system_clock::now();
+
+		if (_isAsync)
+		{
+			// Hand the message to the background writer, without locks or IO on the calling thread
+			ThreadLogBuffer& buffer = threadBuffer();
+			LogRecord record{ severity, now, std::chrono::steady_clock::now(), msg };
+
+			bool isBuffered = buffer.records.tryPush(record);
+			while (!isBuffered)
+			{
+				if (_overflowPolicy == LogOverflowPolicy::DROP)
+				{
+					buffer.droppedCount++;
+					return;
+				}
+
+				// The writer was stopped meanwhile, the message is written synchronously below
+				if (!waitForDrain())
+					break;
+
+				isBuffered = buffer.records.tryPush(record);
+			}
+
+			if (isBuffered)
+				return;
+		}
 
 		{	// Keep output synchronized for multiple threads accessing it
 			lock_guard<mutex> lock(_outputLock);
+			writeRecord(severity, now, msg);
+			_fs.flush();
+		}
+	}
+
+	void Logger::logLimited(LogSite& site, Severity severity, const string& msg, bool isPrintToConsole)
+	{
+		if (_rateLimit <= 0)
+		{
+			log(severity, msg, isPrintToConsole);
+			return;
+		}
 
-			// Get current date-time
-			time_t t = time(nullptr);
-			struct tm timeinfo;
-			int rc = localtime_s(&timeinfo, &t);
+		int64_t nowMillis = std::chrono::duration_cast<std::chrono::milliseconds>(
+								std::chrono::steady_clock::now().time_since_epoch()).count();
 
-			if (!rc)
-				_fs << "[" << std::put_time(&timeinfo, "%d-%m-%Y %H:%M:%S") << "][" << severityStr << "] " << msg << endl;
+		// The first message after the window is over starts a new one and reports what the last one suppressed
+		int64_t windowStart = site.windowStartMillis;
+		if ((nowMillis - windowStart >= RATE_LIMIT_WINDOW_MILLIS) &&
+			site.windowStartMillis.compare_exchange_strong(windowStart, nowMillis))
+		{
+			site.windowCount = 0;
+			logSuppressed(site, severity);
 		}
+
+		if (++site.windowCount > static_cast<uint32_t>(_rateLimit))
+		{
+			site.lastSeverity = static_cast<int>(severity);
+			site.suppressedCount++;
+			return;
+		}
+
+		log(severity, msg, isPrintToConsole);
+	}
+
+	LogSite& Logger::site(const char* file, int line)
+	{
+		lock_guard<mutex> lock(_sitesLock);
+		_sites.push_back(std::make_unique<LogSite>(file, line));
+		return *_sites.back();
+	}
+
+	void Logger::logSuppressed(LogSite& site, Severity severity)
+	{
+		string summary = suppressedSummary(site);
+		if (!summary.empty())
+			log(severity, summary);
+	}
+
+	string Logger::suppressedSummary(LogSite& site)
+	{
+		uint32_t suppressed = site.suppressedCount.exchange(0);
+		if (suppressed == 0)
+			return "";
+
+		// Only the file name of the call site, not its full path
+		string file = site.file;
+		size_t separator = file.find_last_of("\\/");
+		if (separator != string::npos)
+			file = file.substr(separator + 1);
+
+		return to_string(suppressed) + " similar messages suppressed (" + file + ":" + to_string(site.line) + ")";
+	}
+
+	bool Logger::sampleDebug() const
+	{
+		uint32_t& state = currentThreadSampleState;
+		if (state == 0)
+		{	// Seeded differently on each thread
+			state = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+		}
+
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		return static_cast<int>(state % 100) < _debugSamplingPercent;
+	}
+
+	void Logger::writeRecord(Severity severity, std::chrono::system_clock::time_point time, const string& msg)
+	{
+		// Get date-time of the message
+		time_t t = std::chrono::system_clock::to_time_t(time);
+		struct tm timeinfo;
+		int rc = localtime_s(&timeinfo, &t);
+
+		if (!rc)
+			_fs << "[" << std::put_time(&timeinfo, "%d-%m-%Y %H:%M:%S") << "][" << severityToString(severity) << "] " << msg << '\n';
+	}
+
+	ThreadLogBuffer& Logger::threadBuffer()
+	{
+		if (currentThreadBuffer == nullptr)
+		{
+			currentThreadBuffer = std::make_shared<ThreadLogBuffer>(THREAD_BUFFER_CAPACITY);
+
+			lock_guard<mutex> lock(_buffersLock);
+			_threadBuffers.push_back(currentThreadBuffer);
+		}
+
+		return *currentThreadBuffer;
+	}
+
+	bool Logger::waitForDrain()
+	{
+		unique_lock<mutex> lock(_buffersLock);
+		uint64_t drainsCount = _drainsCount;
+		_isDrainRequested = true;
+		_writerCV.notify_one();
+
+		// Any drain that ends from now on made room in the buffer. Once the writer is stopped, the drain of
+		// stopWriterThread() is the last one.
+		_drainedCV.wait(lock, [this, drainsCount] { return (_drainsCount != drainsCount) || !_isAsync; });
+		return _isAsync;
+	}
+
+	void Logger::drainThreadBuffers()
+	{
+		vector<shared_ptr<ThreadLogBuffer>> buffers;
+		{
+			lock_guard<mutex> lock(_buffersLock);
+			buffers = _threadBuffers;
+		}
+
+		// Messages of different threads are merged in time order
+		vector<LogRecord> batch;
+		LogRecord record;
+		for (auto& buffer : buffers)
+		{
+			while (buffer->records.tryPop(record))
+				batch.push_back(std::move(record));
+
+			size_t dropped = buffer->droppedCount.exchange(0);
+			if (dropped > 0)
+			{
+				batch.push_back(LogRecord{ Severity::WARNING_LEVEL, std::chrono::system_clock::now(),
+										   std::chrono::steady_clock::now(),
+										   to_string(dropped) + " log messages were dropped (log buffer is full)" });
+			}
+		}
+
+		if (!batch.empty())
+		{
+			// Ordered by the steady clock, so the messages of a thread keep their order if the wall clock steps back
+			std::stable_sort(batch.begin(), batch.end(), [](const LogRecord& a, const LogRecord& b)
+			{
+				return a.orderTime < b.orderTime;
+			});
+
+			// A single flush for the whole batch
+			lock_guard<mutex> lock(_outputLock);
+			for (const auto& entry : batch)
+				writeRecord(entry.severity, entry.time, entry.msg);
+			_fs.flush();
+		}
+
+		{
+			lock_guard<mutex> lock(_buffersLock);
+			_drainsCount++;
+		}
+
+		_drainedCV.notify_all();
+	}
+
+	void Logger::runWriterThread()
+	{
+		bool isStopping = false;
+		while (!isStopping)
+		{
+			{
+				unique_lock<mutex> lock(_buffersLock);
+				_writerCV.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MILLIS),
+								   [this] { return _isWriterStopping || _isDrainRequested; });
+				isStopping = _isWriterStopping;
+				_isDrainRequested = false; // Requests made during the drain below get a drain of their own
+			}
+
+			drainThreadBuffers(); // The last drain happens after stopping is requested
+		}
+	}
+
+	void Logger::stopWriterThread()
+	{
+		if (!_writerThread.joinable())
+			return;
+
+		{
+			lock_guard<mutex> lock(_buffersLock);
+			_isWriterStopping = true;
+		}
+
+		_writerCV.notify_one();
+		_writerThread.join();
+		_isAsync = false;
+		_isWriterStopping = false;
+
+		// Messages logged while the writer was stopping
+		drainThreadBuffers();
+	}
+
+	void Logger::shutdown()
+	{
+		// Messages buffered by all threads are written before the writer is joined
+		stopWriterThread();
+	}
+
+	Logger* Logger::setAsync(bool isAsync, LogOverflowPolicy overflowPolicy)
+	{
+		_overflowPolicy = overflowPolicy;
+
+		if (!isAsync)
+		{
+			stopWriterThread();
+		}
+		else if (!_writerThread.joinable() && (_path != nullptr) && _fs)
+		{
+			_isAsync = true;
+			_writerThread = thread(&Logger::runWriterThread, this);
+		}
+
+		return this;
+	}
+
+	bool Logger::parseOverflowPolicy(const string& text, LogOverflowPolicy& policy)
+	{
+		if (text == "block")
+			policy = LogOverflowPolicy::BLOCK;
+		else if (text == "drop")
+			policy = LogOverflowPolicy::DROP;
+		else
+			return false;
+
+		return true;
+	}
+
+	string Logger::overflowPolicyToString(LogOverflowPolicy policy)
+	{
+		return (policy == LogOverflowPolicy::DROP) ? "drop" : "block";
+	}
+
+	Logger* Logger::setRateLimit(int messagesPerSecond)
+	{
+		_rateLimit = messagesPerSecond;
+		return this;
+	}
+
+	Logger* Logger::setDebugSampling(int percent)
+	{
+		_debugSamplingPercent = percent;
+		return this;
 	}
 
 	Logger* Logger::setLevel(Severity limit)
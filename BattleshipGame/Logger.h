@@ -1,13 +1,63 @@
 #pragma once
 
+#include <cstdint>
 #include <fstream>
 #include <mutex>
 #include <memory>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include "SpscRing.h"
 
 using std::fstream;
 using std::string;
 using std::mutex;
 using std::unique_ptr;
+using std::shared_ptr;
+using std::vector;
+using std::atomic;
+using std::thread;
+using std::condition_variable;
+
+/** Logs a message to the log file only (not to the console). The message expression is evaluated only
+ *  if its severity passes the logger's filter, so filtered messages cost no formatting or allocations.
+ */
+#define BATTLESHIP_LOG(severity, msg)												\
+	do																				\
+	{																				\
+		battleship::Logger& logger = battleship::Logger::getInstance();				\
+		if (logger.isEnabled(severity))												\
+			logger.log((severity), (msg));											\
+	} while (0)
+
+// Defining BATTLESHIP_STRIP_DEBUG_LOGS removes all debug messages (and their formatting) at compile time.
+// Otherwise only the sampled fraction of debug messages is formatted and written (see setDebugSampling).
+#ifdef BATTLESHIP_STRIP_DEBUG_LOGS
+#define LOG_DEBUG(msg) do { } while (0)
+#else
+#define LOG_DEBUG(msg)																\
+	do																				\
+	{																				\
+		battleship::Logger& logger = battleship::Logger::getInstance();				\
+		if (logger.isEnabled(battleship::Severity::DEBUG_LEVEL) && logger.isDebugSampled())	\
+			logger.log(battleship::Severity::DEBUG_LEVEL, (msg));					\
+	} while (0)
+#endif
+
+#define LOG_INFO(msg) BATTLESHIP_LOG(battleship::Severity::INFO_LEVEL, msg)
+
+/** Logs a message that may repeat many times (e.g. for every game, every board or every faulty player).
+ *  Messages of this call site beyond the rate limit are suppressed, and their number is logged once the
+ *  limit allows (see setRateLimit). Errors are limited on the console as well.
+ */
+#define LOG_LIMITED(severity, msg)													\
+	do																				\
+	{																				\
+		static battleship::LogSite& logSite = battleship::Logger::getInstance().site(__FILE__, __LINE__);	\
+		battleship::Logger::getInstance().logLimited(logSite, (severity), (msg));	\
+	} while (0)
 
 namespace battleship
 {
@@ -19,8 +69,49 @@ namespace battleship
 		ERROR_LEVEL = 3
 	};
 
+	/** What an asynchronous logger does with a message when the calling thread's buffer is full */
+	enum class LogOverflowPolicy
+	{
+		BLOCK,	// Wait for the background writer to make room, no message is lost
+		DROP	// Drop the message, the number of dropped messages is written to the log instead
+	};
+
+	/** A message waiting in a thread's buffer to be written by the background writer */
+	struct LogRecord
+	{
+		Severity severity;
+		std::chrono::system_clock::time_point time; // Timestamp written with the message
+		std::chrono::steady_clock::time_point orderTime; // Orders the messages of all threads, unlike time it never steps back
+		string msg;
+	};
+
+	/** Rate limiting state of a single LOG_LIMITED call site */
+	struct LogSite
+	{
+		LogSite(const char* file, int line);
+
+		const char* file;
+		int line;
+		atomic<int64_t> windowStartMillis; // Start of the current rate limiting window
+		atomic<uint32_t> windowCount; // Messages of this site logged or suppressed in the current window
+		atomic<uint32_t> suppressedCount; // Messages suppressed since the last summary
+		atomic<int> lastSeverity; // Severity of the suppressed messages, reported by the final summary
+	};
+
+	/** Messages logged by a single thread, waiting for the background writer */
+	struct ThreadLogBuffer
+	{
+		explicit ThreadLogBuffer(size_t capacity);
+
+		SpscRing<LogRecord> records;
+		atomic<size_t> droppedCount;
+	};
+
 	/** Thread safe singelton logger class.
 	 *	Logger is usable only after setPath() have been called and a log file have been created.
+	 *  In asynchronous mode callers only move their message into a buffer of their own thread, and a background
+	 *  thread timestamps, batches and writes the messages of all threads. shutdown() writes all remaining
+	 *  messages and stops the background thread, and must be called before main returns.
 	 */
 	class Logger
 	{
@@ -41,6 +132,26 @@ namespace battleship
 		/** Logs a single message to log file */
 		void log(Severity severity, const string& msg, bool isPrintToConsole = false);
 
+		/** Logs a message of a LOG_LIMITED call site, unless the site exceeded the rate limit */
+		void logLimited(LogSite& site, Severity severity, const string& msg, bool isPrintToConsole = false);
+
+		/** Returns the rate limiting state of a call site (created on its first message, owned by the logger) */
+		LogSite& site(const char* file, int line);
+
+		/** Returns true if messages of this severity are written to the log file.
+		 *  Lets callers skip building messages that would be filtered anyway (see LOG_DEBUG).
+		 */
+		bool isEnabled(Severity severity) const
+		{
+			return (severity >= _limit) && (_path != nullptr);
+		}
+
+		/** Returns true if the next debug message should be logged, according to the sampling percentage */
+		bool isDebugSampled() const
+		{
+			return (_debugSamplingPercent >= 100) || sampleDebug();
+		}
+
 		/** Set level of filtering messages for the logger.
 		 *  Messages with a lower severity than limit won't be logged.
 		 */
@@ -52,7 +163,30 @@ namespace battleship
 		 */
 		Logger* setPath(const string& path);
 
+		/** Switches to asynchronous logging (or back to synchronous logging) with the given overflow policy.
+		 *  Must be called before other threads start logging.
+		 */
+		Logger* setAsync(bool isAsync, LogOverflowPolicy overflowPolicy);
+
+		/** Writes all buffered messages and stops the asynchronous mode (joining the background writer).
+		 *  Must be called before main returns, later messages are written synchronously.
+		 */
+		void shutdown();
+
+		/** Sets the maximal number of messages each LOG_LIMITED call site logs per second (0 for no limit) */
+		Logger* setRateLimit(int messagesPerSecond);
+
+		/** Sets the percentage of debug messages that are logged, the rest are dropped at random */
+		Logger* setDebugSampling(int percent);
+
+		static bool parseOverflowPolicy(const string& text, LogOverflowPolicy& policy);
+		static string overflowPolicyToString(LogOverflowPolicy policy);
+
 	private:
+		static constexpr size_t THREAD_BUFFER_CAPACITY = 8192; // Messages buffered per thread
+		static constexpr int FLUSH_INTERVAL_MILLIS = 100; // The background writer wakes up at least this often
+		static constexpr int RATE_LIMIT_WINDOW_MILLIS = 1000; // LOG_LIMITED sites are limited per this window
+
 		static constexpr auto LOG_FILE = "game.log"; // Log file name
 		unique_ptr<string> _path; // Path of the log file, logger is active only after this is initialized
 
@@ -61,7 +195,56 @@ namespace battleship
 		
 		mutex _outputLock; // Keeps output synchronized
 
+		// Rate limiting and sampling
+		int _rateLimit; // Messages per LOG_LIMITED site per window, 0 for no limit
+		int _debugSamplingPercent;
+		vector<unique_ptr<LogSite>> _sites; // Protected by _sitesLock
+		mutex _sitesLock;
+
+		// Asynchronous mode
+		atomic<bool> _isAsync;
+		LogOverflowPolicy _overflowPolicy;
+		vector<shared_ptr<ThreadLogBuffer>> _threadBuffers; // Buffers of all threads that logged, protected by _buffersLock
+		mutex _buffersLock;
+		condition_variable _writerCV; // Wakes up the background writer (with _buffersLock)
+		condition_variable _drainedCV; // Wakes up threads blocked on a full buffer after each drain (with _buffersLock)
+		bool _isWriterStopping; // Protected by _buffersLock
+		bool _isDrainRequested; // A thread's buffer is full, protected by _buffersLock
+		uint64_t _drainsCount; // Protected by _buffersLock
+		thread _writerThread;
+
 		Logger(); // Don't allow instantiation from outside
+
+		/** Draws the sampling decision of a debug message */
+		bool sampleDebug() const;
+
+		/** Logs the number of messages a site suppressed (if any) and resets it */
+		void logSuppressed(LogSite& site, Severity severity);
+
+		/** Returns the message reporting the number of messages a site suppressed and resets it,
+		 *  or an empty string if it suppressed none
+		 */
+		static string suppressedSummary(LogSite& site);
+
+		/** Writes the message with its timestamp to the log file. Expects _outputLock to be held. */
+		void writeRecord(Severity severity, std::chrono::system_clock::time_point time, const string& msg);
+
+		/** Returns the buffer of the calling thread, registering a new one on its first message */
+		ThreadLogBuffer& threadBuffer();
+
+		/** Waits until the background writer drains the buffers, called when the calling thread's buffer is full.
+		 *  Returns false if the asynchronous mode was stopped instead.
+		 */
+		bool waitForDrain();
+
+		/** Moves all buffered messages to the log file, in time order, and wakes up the threads waiting for it */
+		void drainThreadBuffers();
+
+		/** Background writer loop of the asynchronous mode */
+		void runWriterThread();
+
+		/** Stops the background writer after it drains all buffered messages */
+		void stopWriterThread();
 	};
 }
 
@@ -0,0 +1,148 @@
+#include "Tests.h"
+#include "Logger.h"
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+namespace battleship
+{
+	namespace
+	{
+		constexpr auto LOG_DIRECTORY = ".";
+		constexpr auto LOG_FILE_PATH = ".\\game.log"; // As the logger joins its directory and file name
+		constexpr auto MESSAGE_PREFIX = "Logger test ";
+
+		/** Returns the lines of the log file past the given offset */
+		vector<string> readLogLines(size_t fromOffset)
+		{
+			vector<char> bytes = TestRunner::readBytes(LOG_FILE_PATH);
+			std::istringstream log(string(bytes.begin() + std::min(fromOffset, bytes.size()), bytes.end()));
+
+			vector<string> lines;
+			string line;
+			while (std::getline(log, line))
+				lines.push_back(line);
+
+			return lines;
+		}
+
+		/** Parses "<prefix><run> thread <thread> message <message>" at the end of a log line */
+		bool parseMessage(const string& line, int run, int& thread, int& message)
+		{
+			size_t start = line.find(MESSAGE_PREFIX);
+			if (start == string::npos)
+				return false;
+
+			std::istringstream fields(line.substr(start + string(MESSAGE_PREFIX).size()));
+			int lineRun = 0;
+			string threadWord;
+			string messageWord;
+			fields >> lineRun >> threadWord >> thread >> messageWord >> message;
+			return fields && (lineRun == run);
+		}
+
+		/** Logs messages of the given run from a few threads at once */
+		void logFromThreads(int run, int threadsCount, int messagesCount)
+		{
+			vector<std::thread> threads;
+			for (int thread = 0; thread < threadsCount; ++thread)
+			{
+				threads.emplace_back([run, thread, messagesCount]()
+				{
+					for (int message = 0; message < messagesCount; ++message)
+					{
+						Logger::getInstance().log(Severity::INFO_LEVEL, MESSAGE_PREFIX + std::to_string(run) + " thread " +
+												  std::to_string(thread) + " message " + std::to_string(message));
+					}
+				});
+			}
+
+			for (auto& thread : threads)
+				thread.join();
+		}
+	}
+
+	void loggerTests(unsigned int seed)
+	{
+		static constexpr int THREADS_COUNT = 8;
+		static constexpr int MESSAGES_COUNT = 20000; // Per thread, more than a thread's buffer holds
+		static constexpr auto DROPPED_SUFFIX = " log messages were dropped (log buffer is full)";
+
+		Logger& logger = Logger::getInstance();
+		logger.setPath(LOG_DIRECTORY)->setLevel(Severity::DEBUG_LEVEL)->setRateLimit(0)->setDebugSampling(100);
+		int run = static_cast<int>(seed % 100000) * 10; // Tells the messages of this run from earlier runs in the log
+
+		// Blocking: every message of every thread is written by shutdown(), in the order of its thread
+		{
+			size_t logOffset = TestRunner::readBytes(LOG_FILE_PATH).size();
+			logger.setAsync(true, LogOverflowPolicy::BLOCK);
+			logFromThreads(run, THREADS_COUNT, MESSAGES_COUNT);
+			logger.shutdown();
+
+			vector<int> nextMessages(THREADS_COUNT, 0);
+			bool isOrdered = true;
+			for (const auto& line : readLogLines(logOffset))
+			{
+				int thread = 0;
+				int message = 0;
+				if (!parseMessage(line, run, thread, message))
+					continue;
+
+				if ((thread < 0) || (thread >= THREADS_COUNT))
+				{
+					TestRunner::check(false, "Unexpected log line: " + line);
+					return;
+				}
+
+				isOrdered = isOrdered && (message == nextMessages[thread]);
+				nextMessages[thread] = message + 1;
+			}
+
+			TEST_CHECK(isOrdered);
+			for (int thread = 0; thread < THREADS_COUNT; ++thread)
+				TestRunner::check(nextMessages[thread] == MESSAGES_COUNT, "Thread " + std::to_string(thread) + " wrote " +
+								  std::to_string(nextMessages[thread]) + " of its messages");
+		}
+
+		// Dropping: every message is either written or counted by a dropped messages warning
+		{
+			size_t logOffset = TestRunner::readBytes(LOG_FILE_PATH).size();
+			logger.setAsync(true, LogOverflowPolicy::DROP);
+			logFromThreads(run + 1, THREADS_COUNT, MESSAGES_COUNT);
+			logger.shutdown();
+
+			long long writtenCount = 0;
+			long long droppedCount = 0;
+			for (const auto& line : readLogLines(logOffset))
+			{
+				int thread = 0;
+				int message = 0;
+				size_t droppedSuffix = line.find(DROPPED_SUFFIX);
+				if (parseMessage(line, run + 1, thread, message))
+				{
+					writtenCount++;
+				}
+				else if (droppedSuffix != string::npos)
+				{
+					size_t countStart = line.rfind(' ', droppedSuffix - 1) + 1;
+					droppedCount += std::stoll(line.substr(countStart, droppedSuffix - countStart));
+				}
+			}
+
+			TestRunner::check(writtenCount + droppedCount == THREADS_COUNT * MESSAGES_COUNT,
+							  std::to_string(writtenCount) + " messages written and " + std::to_string(droppedCount) +
+							  " dropped of " + std::to_string(THREADS_COUNT * MESSAGES_COUNT));
+		}
+
+		// After shutdown messages are written synchronously, each one is in the file when log() returns
+		{
+			size_t logOffset = TestRunner::readBytes(LOG_FILE_PATH).size();
+			logger.log(Severity::INFO_LEVEL, MESSAGE_PREFIX + std::to_string(run + 2) + " thread 0 message 0");
+
+			int thread = 0;
+			int message = 0;
+			vector<string> lines = readLogLines(logOffset);
+			TEST_CHECK((lines.size() == 1) && parseMessage(lines[0], run + 2, thread, message));
+		}
+	}
+}
@@ -26,10 +26,10 @@ namespace battleship
 			to_string(boardFactory->loadedBoardsList().size()),
 			PRINT_TO_CONSOLE);
 
-		Logger::getInstance().log(Severity::DEBUG_LEVEL, "All resources validated, proceeding to competition");
-		CompetitionManager competitionMgr(boardFactory, algoLoader, config.threads);
+		LOG_DEBUG("All resources validated, proceeding to competition");
+		CompetitionManager competitionMgr(boardFactory, algoLoader, config);
 
-		Logger::getInstance().log(Severity::DEBUG_LEVEL, "Competition tasks ready to run..");
+		LOG_DEBUG("Competition tasks ready to run..");
 		competitionMgr.run();
 
 		Logger::getInstance().log(Severity::INFO_LEVEL, "Battleship game ended.");
@@ -66,12 +66,14 @@ namespace battleship
 													    shared_ptr<BattleshipGameBoardFactory> boardFactory,
 														shared_ptr<AlgoLoader> algoLoader)
 	{
-		auto availableBoards = boardFactory->availableBoardsList();
+		bool isMissingBoards = boardFactory->availableBoardsList().empty() &&
+							   boardFactory->availableArchivesList().empty() &&
+							   (config.generator.boardsCount == 0);
 
-		if (availableBoards.empty())
+		if (isMissingBoards)
 		{
 			Logger::getInstance().log(Severity::ERROR_LEVEL,
-				"No board files (*.sboard) looking in path: " + config.path,
+				"No board files (*.sboard, *.sboardb) looking in path: " + config.path,
 				PRINT_TO_CONSOLE);
 		}
 
@@ -84,7 +86,7 @@ namespace battleship
 				PRINT_TO_CONSOLE);
 		}
 
-		if (availableBoards.empty() || availableAlgos.size() < 2)
+		if (isMissingBoards || availableAlgos.size() < 2)
 		{
 			Logger::getInstance().log(Severity::INFO_LEVEL, "Battleship game ended.");
 			return false;
@@ -107,7 +109,10 @@ namespace battleship
 
 	void MainBattleshipGame::startLogger(const Configuration& config, bool isLegalConfiguration)
 	{
-		Logger::getInstance().setPath(config.path)->setLevel(config.logSeverity);
+		Logger::getInstance().setPath(config.path)->setLevel(config.logSeverity)
+							 ->setAsync(config.isLogAsync, config.logOverflow)
+							 ->setRateLimit(config.logRateLimit)->setDebugSampling(config.logDebugSampling);
+		EventLog::getInstance().setFormat(config.logFormat, config.path);
 		Logger::getInstance().log(Severity::INFO_LEVEL, "Battleship game started.");
 
 		// Report all accumulated configuration issues now that the logger is loaded
@@ -123,9 +128,35 @@ namespace battleship
 		if (isLegalConfiguration)
 		{
 			Logger::getInstance().log(Severity::INFO_LEVEL, "Path = " + config.path);
-			Logger::getInstance().log(Severity::INFO_LEVEL, "Worker threads count = " + to_string(config.threads));
+			string threadsStr = config.isAutoThreads ? ("auto (starting from " + to_string(config.threads) + ")") :
+													   to_string(config.threads);
+			Logger::getInstance().log(Severity::INFO_LEVEL, "Worker threads count = " + threadsStr);
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Worker threads affinity = " + WorkerThreadPlacement::policyToString(config.placement));
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Resource aware scheduling = " + string(config.isResourceAware ? "on" : "off"));
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Tournament format = " + TournamentFormat::typeToString(config.tournament.type));
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Early stopping of settled matchups = " + string(config.isEarlyStop ? "on" : "off"));
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Board sampling preview = " + string(config.preview.isEnabled ? "on" : "off"));
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Results export = " + ResultsExporter::formatToString(config.exportSettings.format));
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Scoreboard rendering = " + ScoreboardRenderer::modeToString(ScoreboardRenderer::detectMode()) +
+									  " (" + to_string(config.renderFps) + " fps)");
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Results store = " + (config.resultsStore.empty() ? string("none") : config.resultsStore));
 			string severityStr = Logger::severityToString(config.logSeverity);
 			Logger::getInstance().log(Severity::INFO_LEVEL, "Logger level = " + severityStr);
+			string asyncStr = config.isLogAsync ? ("on (overflow: " + Logger::overflowPolicyToString(config.logOverflow) + ")") :
+												  "off";
+			Logger::getInstance().log(Severity::INFO_LEVEL, "Asynchronous logging = " + asyncStr);
+			Logger::getInstance().log(Severity::INFO_LEVEL, "Events log format = " + EventLog::formatToString(config.logFormat));
+			string rateLimitStr = (config.logRateLimit > 0) ? (to_string(config.logRateLimit) + " messages per second") : "none";
+			Logger::getInstance().log(Severity::INFO_LEVEL, "Log rate limit = " + rateLimitStr);
+			Logger::getInstance().log(Severity::INFO_LEVEL, "Debug log sampling = " + to_string(config.logDebugSampling) + "%");
 		}
 		else
 		{
@@ -163,6 +194,8 @@ namespace battleship
 				return ERROR_CODE;
 
 			auto loadedBoards = boardFactory->loadAllBattleBoards();
+			if (config.generator.boardsCount > 0)
+				loadedBoards = boardFactory->generateBattleBoards(config.generator);
 			auto loadedAlgos = algoLoader->loadAllAvailableAlgorithms();
 
 			// Validation #3: Not enough valid boards or dlls
@@ -1,5 +1,6 @@
 #include "MainGame.h"
 #include "MainBattleshipGame.h"
+#include "Logger.h"
 #include <iostream>
 
 using std::cerr;
@@ -8,6 +9,8 @@ using std::exception;
 
 int main(int argc, char* argv[])
 {
+	int exitCode = 0;
+
 	try
 	{
 		battleship::MainBattleshipGame::run(argc, argv);
@@ -16,6 +19,11 @@ int main(int argc, char* argv[])
 	{	// This should be the last barrier that stops the app from failing,
 		// We don't log here because anything can cause this error - including the logger itself.
 		cerr << "Error: General error of type " << e.what() << endl;
-		return battleship::MainBattleshipGame::ERROR_CODE;
+		exitCode = battleship::MainBattleshipGame::ERROR_CODE;
 	}
+
+	// Writes the buffered log messages and stops the logger's background writer before static destruction
+	battleship::Logger::getInstance().shutdown();
+
+	return exitCode;
 }
\ No newline at end of file
@@ -4,7 +4,7 @@ namespace battleship
 {
 	PlayerStatistics::PlayerStatistics(const string& aPlayerName) :
 		playerName(aPlayerName), pointsFor(0),
-		pointsAgainst(0), wins(0), loses(0), ties(0), rating(0)
+		pointsAgainst(0), wins(0), loses(0), ties(0), byes(0), rating(0)
 	{
 	}
 
@@ -13,14 +13,15 @@ namespace battleship
 		playerName(aPlayerName),
 		pointsFor(aPointsFor),
 		pointsAgainst(aPointsAgainst),
-		wins(aWins), loses(aLoses), ties(aTies),
+		wins(aWins), loses(aLoses), ties(aTies), byes(0),
 		rating(getPlayerRating(aWins, aLoses))
 	{
 	}
 
 	PlayerStatistics::PlayerStatistics(PlayerStatistics const& other) :
 		playerName(other.playerName), pointsFor(other.pointsFor),
-		pointsAgainst(other.pointsAgainst), wins(other.wins), loses(other.loses), ties(other.ties), rating(other.rating)
+		pointsAgainst(other.pointsAgainst), wins(other.wins), loses(other.loses), ties(other.ties), byes(other.byes),
+		rating(other.rating)
 	{
 	}
 
@@ -35,6 +36,7 @@ namespace battleship
 			wins = other.wins;
 			loses = other.loses;
 			ties = other.ties;
+			byes = other.byes;
 			rating = other.rating;
 		}
 
@@ -43,7 +45,8 @@ namespace battleship
 
 	PlayerStatistics::PlayerStatistics(PlayerStatistics&& other) noexcept:
 	playerName(std::move(other.playerName)), pointsFor(other.pointsFor),
-		pointsAgainst(other.pointsAgainst), wins(other.wins), loses(other.loses), ties(other.ties), rating(other.rating)
+		pointsAgainst(other.pointsAgainst), wins(other.wins), loses(other.loses), ties(other.ties), byes(other.byes),
+		rating(other.rating)
 	{
 	}
 
@@ -55,6 +58,7 @@ namespace battleship
 		wins = other.wins;
 		loses = other.loses;
 		ties = other.ties;
+		byes = other.byes;
 		rating = other.rating;
 
 		other.pointsFor = 0;
@@ -62,6 +66,7 @@ namespace battleship
 		other.wins = 0;
 		other.loses = 0;
 		other.ties = 0;
+		other.byes = 0;
 		other.rating = 0;
 
 		return *this;
@@ -71,12 +76,21 @@ namespace battleship
 		int addedPointsAgainst,
 		bool isWin, bool isLose) const
 	{
-		return PlayerStatistics(playerName,
+		PlayerStatistics updated(playerName,
 			pointsFor + addedPointsFor,
 			pointsAgainst + addedPointsAgainst,
 			wins + (isWin ? 1 : 0),
 			loses + (isLose ? 1 : 0),
 			ties + ((!isWin && !isLose) ? 1 : 0));
+		updated.byes = byes;
+		return updated;
+	}
+
+	PlayerStatistics PlayerStatistics::creditBye() const
+	{
+		PlayerStatistics updated(*this);
+		updated.byes++;
+		return updated;
 	}
 
 	float PlayerStatistics::getPlayerRating(int wins, int loses)
@@ -90,6 +104,6 @@ namespace battleship
 
 	int PlayerStatistics::getRoundsPlayed() const
 	{
-		return wins + loses + ties;
+		return wins + loses + ties + byes;
 	}
 }
@@ -23,7 +23,10 @@ namespace battleship
 		PlayerStatistics updateStatistics(int addedPointsFor, int addedPointsAgainst,
 			bool isWin, bool isLose) const;
 
-		/** Number of rounds the player have played so far */
+		/** Get new statistics with one more game credited for a bye, which isn't counted in the rating */
+		PlayerStatistics creditBye() const;
+
+		/** Number of rounds the player have played so far (byes included) */
 		int getRoundsPlayed() const;
 
 		// Components of player's statistics
@@ -33,6 +36,7 @@ namespace battleship
 		int wins;
 		int loses;
 		int ties;
+		int byes;		// Games credited for sitting out a stage of the tournament, not played
 		float rating;
 
 	private:
@@ -0,0 +1,149 @@
+#include "RatingEngine.h"
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+using std::lock_guard;
+using std::stringstream;
+using std::setw;
+using std::setprecision;
+using std::fixed;
+using std::left;
+using std::endl;
+
+namespace battleship
+{
+	static constexpr double PI = 3.14159265358979323846;
+
+	/** Glicko scale factor: ln(10) / 400 */
+	static const double Q = std::log(10.0) / 400;
+
+	/** Glicko attenuation of the opponent's rating by its deviation */
+	static double g(double deviation)
+	{
+		return 1 / std::sqrt(1 + 3 * Q * Q * deviation * deviation / (PI * PI));
+	}
+
+	double PlayerRating::lowerBound() const
+	{
+		return rating - 1.96 * deviation;
+	}
+
+	double PlayerRating::upperBound() const
+	{
+		return rating + 1.96 * deviation;
+	}
+
+	RatingEngine::RatingEngine(const vector<string>& players)
+	{
+		for (const auto& player : players)
+			_ratings[player] = PlayerRating{ INITIAL_RATING, INITIAL_DEVIATION };
+	}
+
+	PlayerRating RatingEngine::updatedRating(const PlayerRating& player, const PlayerRating& opponent, double score)
+	{
+		double gOpponent = g(opponent.deviation);
+		double expected = 1 / (1 + std::pow(10.0, -gOpponent * (player.rating - opponent.rating) / 400));
+		double dSquaredInverse = Q * Q * gOpponent * gOpponent * expected * (1 - expected);
+		double precision = 1 / (player.deviation * player.deviation) + dSquaredInverse;
+
+		PlayerRating updated;
+		updated.rating = player.rating + (Q / precision) * gOpponent * (score - expected);
+		updated.deviation = std::sqrt(1 / precision);
+		if (updated.deviation < MIN_DEVIATION)
+			updated.deviation = MIN_DEVIATION;
+
+		return updated;
+	}
+
+	void RatingEngine::recordGame(const string& playerAName, const string& playerBName, PlayerEnum winner)
+	{
+		double scoreA = (winner == PlayerEnum::A) ? 1 : ((winner == PlayerEnum::B) ? 0 : 0.5);
+
+		lock_guard<mutex> lock(_ratingsLock);
+
+		// Both players are updated by the ratings from before the game
+		PlayerRating ratingA = _ratings[playerAName];
+		PlayerRating ratingB = _ratings[playerBName];
+		_ratings[playerAName] = updatedRating(ratingA, ratingB, scoreA);
+		_ratings[playerBName] = updatedRating(ratingB, ratingA, 1 - scoreA);
+
+		bool isAFirst = (playerAName < playerBName);
+		HeadToHead& results = _headToHead[isAFirst ? std::make_pair(playerAName, playerBName) :
+													 std::make_pair(playerBName, playerAName)];
+		double scoreFirst = isAFirst ? scoreA : 1 - scoreA;
+		if (scoreFirst == 1)
+			results.wins++;
+		else if (scoreFirst == 0)
+			results.losses++;
+		else
+			results.ties++;
+	}
+
+	PlayerRating RatingEngine::rating(const string& playerName)
+	{
+		lock_guard<mutex> lock(_ratingsLock);
+		return _ratings[playerName];
+	}
+
+	bool RatingEngine::isMatchupSettled(const string& playerAName, const string& playerBName)
+	{
+		auto key = (playerAName < playerBName) ? std::make_pair(playerAName, playerBName) :
+												 std::make_pair(playerBName, playerAName);
+
+		lock_guard<mutex> lock(_ratingsLock);
+		auto entry = _headToHead.find(key);
+		if (entry == _headToHead.end())
+			return false;
+
+		const HeadToHead& results = entry->second;
+		double games = results.wins + results.losses + results.ties;
+		if (games < MIN_SETTLED_GAMES)
+			return false;
+
+		// Wilson score interval of the first player's expected score, ties count as half a win.
+		// The matchup is settled once the interval doesn't contain an even matchup.
+		double score = (results.wins + 0.5 * results.ties) / games;
+		double z2 = SETTLED_Z * SETTLED_Z;
+		double center = (score + z2 / (2 * games)) / (1 + z2 / games);
+		double margin = (SETTLED_Z / (1 + z2 / games)) *
+						std::sqrt(score * (1 - score) / games + z2 / (4 * games * games));
+
+		return ((center - margin) > 0.5) || ((center + margin) < 0.5);
+	}
+
+	string RatingEngine::report()
+	{
+		vector<pair<string, PlayerRating>> sorted;
+		{
+			lock_guard<mutex> lock(_ratingsLock);
+			sorted.assign(_ratings.begin(), _ratings.end());
+		}
+
+		std::sort(sorted.begin(), sorted.end(), [](const pair<string, PlayerRating>& a,
+												   const pair<string, PlayerRating>& b)
+		{
+			return a.second.rating > b.second.rating;
+		});
+
+		size_t nameWidth = 12;
+		for (const auto& entry : sorted)
+			nameWidth = (entry.first.length() + 2 > nameWidth) ? entry.first.length() + 2 : nameWidth;
+
+		stringstream ss;
+		ss << "Glicko ratings (95% confidence intervals)" << endl;
+		ss << left << setw(8) << "#" << setw(nameWidth) << "Team Name"
+		   << setw(10) << "Rating" << setw(10) << "RD" << "Interval" << endl << endl;
+
+		int place = 1;
+		for (const auto& entry : sorted)
+		{
+			ss << setw(8) << (std::to_string(place++) + ".") << setw(nameWidth) << entry.first
+			   << fixed << setprecision(0) << setw(10) << entry.second.rating << setw(10) << entry.second.deviation
+			   << "[" << entry.second.lowerBound() << ", " << entry.second.upperBound() << "]" << endl;
+		}
+
+		return ss.str();
+	}
+}
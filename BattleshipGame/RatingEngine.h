@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <mutex>
+#include "AlgoCommon.h"
+
+using std::string;
+using std::vector;
+using std::map;
+using std::pair;
+using std::mutex;
+
+namespace battleship
+{
+	/** Rating of a player with its uncertainty */
+	struct PlayerRating
+	{
+		double rating;		// Estimated strength on the Elo scale
+		double deviation;	// Rating deviation, shrinks as more games are played
+
+		/** Bounds of the 95% confidence interval of the rating */
+		double lowerBound() const;
+		double upperBound() const;
+	};
+
+	/** Streaming Glicko rating of the players, updated after every game (each game is a rating period
+	 *  of its own). Next to the ratings it keeps head to head results of each pairing, and tells when
+	 *  the result of a pairing is statistically settled so more games between them won't change it.
+	 *  All methods are thread safe.
+	 */
+	class RatingEngine
+	{
+	public:
+		RatingEngine(const vector<string>& players);
+		virtual ~RatingEngine() = default;
+
+		/** Updates the ratings of both players and their head to head results with a game result */
+		void recordGame(const string& playerAName, const string& playerBName, PlayerEnum winner);
+
+		/** Returns the current rating of the player */
+		PlayerRating rating(const string& playerName);
+
+		/** Returns true if enough games were played between the two players to tell (with high confidence)
+		 *  which of them is stronger. The order of the players doesn't matter.
+		 */
+		bool isMatchupSettled(const string& playerAName, const string& playerBName);
+
+		/** Returns a table of all players sorted by rating, with confidence intervals */
+		string report();
+
+	private:
+		/** Initial rating and deviation of a player without games */
+		static constexpr double INITIAL_RATING = 1500;
+		static constexpr double INITIAL_DEVIATION = 350;
+
+		/** Deviation never drops below this value, so ratings keep following changes in form */
+		static constexpr double MIN_DEVIATION = 30;
+
+		/** Normal quantile of the confidence used to settle a matchup (99%, conservative since
+		 *  the test is repeated after every game)
+		 */
+		static constexpr double SETTLED_Z = 2.576;
+
+		/** Minimal number of games between two players before their matchup may be settled */
+		static constexpr int MIN_SETTLED_GAMES = 6;
+
+		/** Head to head results between two players, from the point of view of the first (lower name) player */
+		struct HeadToHead
+		{
+			int wins = 0;
+			int losses = 0;
+			int ties = 0;
+		};
+
+		// Current rating of each player
+		map<string, PlayerRating> _ratings;
+
+		// Head to head results, key is the pair of player names ordered by name
+		map<pair<string, string>, HeadToHead> _headToHead;
+
+		// Protects ratings and head to head results from concurrent access
+		mutex _ratingsLock;
+
+		/** Returns the new rating of player after a game against opponent with the given score (1, 0.5 or 0) */
+		static PlayerRating updatedRating(const PlayerRating& player, const PlayerRating& opponent, double score);
+	};
+}
@@ -0,0 +1,277 @@
+#include "ResourceAwareScheduler.h"
+#include "BoardDataImpl.h"
+#include "GameManager.h"
+#include "IOUtil.h"
+#include "Logger.h"
+#include <windows.h>
+#include <psapi.h>
+#include <tlhelp32.h>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+using std::lock_guard;
+using std::unique_lock;
+using std::to_string;
+using std::atomic;
+using std::thread;
+
+namespace battleship
+{
+	ResourceAwareScheduler::ResourceAwareScheduler(shared_ptr<BattleshipGameBoardFactory> boardLoader,
+												   shared_ptr<AlgoLoader> algoLoader) :
+		_boardLoader(boardLoader),
+		_algoLoader(algoLoader),
+		_threadsInUse(0),
+		_memoryInUseMB(0),
+		_runningGames(0)
+	{
+		unsigned int processors = thread::hardware_concurrency();
+		_threadsCapacity = (processors > 0) ? static_cast<int>(processors) : 1;
+
+		MEMORYSTATUSEX memoryStatus = {};
+		memoryStatus.dwLength = sizeof(memoryStatus);
+		ULONGLONG availableMB = GlobalMemoryStatusEx(&memoryStatus) ? (memoryStatus.ullAvailPhys >> 20) : 0;
+		_memoryCapacityMB = static_cast<size_t>(availableMB * MEMORY_BUDGET_FRACTION);
+
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Resource aware scheduling: host capacity is " + to_string(_threadsCapacity) +
+								  " threads and " + to_string(_memoryCapacityMB) + " MB");
+	}
+
+	int ResourceAwareScheduler::processThreadCount()
+	{
+		HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+		if (snapshot == INVALID_HANDLE_VALUE)
+			return 0;
+
+		DWORD processId = GetCurrentProcessId();
+		int threadCount = 0;
+		THREADENTRY32 entry;
+		entry.dwSize = sizeof(entry);
+
+		// The snapshot holds threads of all processes in the system, count only ours
+		if (Thread32First(snapshot, &entry))
+		{
+			do
+			{
+				if (entry.th32OwnerProcessID == processId)
+					threadCount++;
+			} while (Thread32Next(snapshot, &entry));
+		}
+
+		CloseHandle(snapshot);
+		return threadCount;
+	}
+
+	size_t ResourceAwareScheduler::processPrivateBytes()
+	{
+		PROCESS_MEMORY_COUNTERS_EX counters = {};
+		counters.cb = sizeof(counters);
+
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters),
+								  sizeof(counters)))
+			return 0;
+
+		return counters.PrivateUsage;
+	}
+
+	bool ResourceAwareScheduler::loadDeclaredProfile(const string& algoName, AlgoResourceProfile& profile) const
+	{
+		string profileFile = _algoLoader->algosPath() + "\\" + algoName + PROFILE_SUFFIX;
+
+		// Profile files are optional, missing file simply means the algorithm should be measured
+		if (!IOUtil::validateFile(profileFile))
+			return false;
+
+		profile = AlgoResourceProfile{ 1, 0, true };
+
+		// Same format as the configuration file: ATTRIBUTE="value" lines and %% comments
+		auto profileParser = [&profile, &profileFile](string& nextLine, int lineNum, bool& isHeader, bool& isValidFile)
+		{
+			IOUtil::removeLeadingTrailingSpaces(nextLine);
+			bool isThreads = IOUtil::startsWith(nextLine, PROFILE_HEADER_THREADS);
+			bool isMemory = IOUtil::startsWith(nextLine, PROFILE_HEADER_MEMORY);
+
+			if (isThreads || isMemory)
+			{
+				IOUtil::removePrefix(nextLine, isThreads ? PROFILE_HEADER_THREADS : PROFILE_HEADER_MEMORY);
+
+				// Remove optional quotation marks
+				if ((nextLine.length() >= 2) && IOUtil::startsWith(nextLine, "\"") && IOUtil::endsWith(nextLine, "\""))
+					nextLine = nextLine.substr(1, nextLine.length() - 2);
+
+				if (!IOUtil::isInteger(nextLine))
+				{
+					LOG_LIMITED(Severity::WARNING_LEVEL,
+								"Invalid value in line " + to_string(lineNum) + " of " + profileFile);
+					isValidFile = false;
+				}
+				else if (isThreads)
+				{
+					int threads = std::stoi(nextLine);
+					profile.threads = (threads > 0) ? threads : 1;
+				}
+				else
+				{
+					profile.memoryMB = static_cast<size_t>(std::stoull(nextLine));
+				}
+			}
+			else if (!IOUtil::startsWith(nextLine, PROFILE_HEADER_COMMENT) && !IOUtil::isContainOnlyWhitespaces(nextLine))
+			{
+				LOG_LIMITED(Severity::WARNING_LEVEL,
+							"Unknown attribute in line " + to_string(lineNum) + " of " + profileFile);
+				isValidFile = false;
+			}
+
+			isHeader = true; // The entire profile file is treated as a header to ensure validity
+		};
+
+		auto emptyBodyParser = [](string& nextLine) {};
+
+		return IOUtil::parseFile(profileFile, emptyBodyParser, profileParser);
+	}
+
+	/** Raises peak to value if it's larger, without losing a larger value stored concurrently */
+	template <typename T>
+	static void raiseToMax(atomic<T>& peak, T value)
+	{
+		// A failed exchange reloads current, so the loop ends once peak is at least value
+		T current = peak;
+		while ((value > current) && !peak.compare_exchange_weak(current, value))
+			continue;
+	}
+
+	AlgoResourceProfile ResourceAwareScheduler::measureProfile(const string& algoName, const string& boardName) const
+	{
+		// Sample the process while the calibration game runs, peaks are what the algorithm really needs
+		atomic<bool> isCalibrating(true);
+		atomic<int> peakThreads(processThreadCount());
+		atomic<size_t> peakPrivateBytes(processPrivateBytes());
+
+		thread sampler([&isCalibrating, &peakThreads, &peakPrivateBytes]()
+		{
+			while (isCalibrating)
+			{
+				int threads = processThreadCount();
+				size_t privateBytes = processPrivateBytes();
+				raiseToMax(peakThreads, threads);
+				raiseToMax(peakPrivateBytes, privateBytes);
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(CALIBRATION_SAMPLE_MILLIS));
+			}
+		});
+
+		// Baseline includes the sampler thread itself
+		std::this_thread::sleep_for(std::chrono::milliseconds(CALIBRATION_SAMPLE_MILLIS));
+		int baselineThreads = processThreadCount();
+		size_t baselinePrivateBytes = processPrivateBytes();
+		peakThreads = baselineThreads;
+		peakPrivateBytes = baselinePrivateBytes;
+
+		{	// Instances and views are destroyed at the end of this scope, before the sampler stops
+			auto playerA = _algoLoader->requestAlgo(algoName);
+			auto playerB = _algoLoader->requestAlgo(algoName);
+			auto board = _boardLoader->requestBattleboard(boardName);
+
+			if ((playerA != nullptr) && (playerB != nullptr) && (board != nullptr))
+			{
+				BoardDataImpl playerAView(PlayerEnum::A, board);
+				BoardDataImpl playerBView(PlayerEnum::B, board);
+				GameManager::runGame(board, playerA.get(), playerB.get(), playerAView, playerBView);
+			}
+		}
+
+		isCalibrating = false;
+		sampler.join();
+
+		// The calibration game ran two instances of the algorithm, the profile is for a single instance.
+		// The process may shrink below the baseline while it runs, so the extras are never negative.
+		int peakThreadsCount = peakThreads;
+		size_t peakBytes = peakPrivateBytes;
+		int extraThreads = (peakThreadsCount > baselineThreads) ? (peakThreadsCount - baselineThreads) : 0;
+		size_t extraBytes = (peakBytes > baselinePrivateBytes) ? (peakBytes - baselinePrivateBytes) : 0;
+
+		AlgoResourceProfile profile;
+		profile.threads = 1 + (extraThreads + 1) / 2;
+		profile.memoryMB = ((extraBytes / 2) >> 20) + 1;
+		profile.isDeclared = false;
+		return profile;
+	}
+
+	void ResourceAwareScheduler::prepareProfiles(const vector<string>& algos)
+	{
+		auto boards = _boardLoader->loadedBoardsList();
+
+		for (const auto& algoName : algos)
+		{
+			AlgoResourceProfile profile;
+
+			if (!loadDeclaredProfile(algoName, profile))
+			{
+				if (boards.empty())
+					profile = AlgoResourceProfile{ 1, 0, false };
+				else
+					profile = measureProfile(algoName, boards.front());
+			}
+
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Resource profile of " + algoName + " (" +
+									  (profile.isDeclared ? "declared" : "measured") + "): " +
+									  to_string(profile.threads) + " threads, " +
+									  to_string(profile.memoryMB) + " MB");
+
+			_profiles[algoName] = profile;
+		}
+	}
+
+	ResourceAwareScheduler::GameDemand ResourceAwareScheduler::demandOf(const string& playerAName,
+																		const string& playerBName) const
+	{
+		auto profileA = _profiles.find(playerAName);
+		auto profileB = _profiles.find(playerBName);
+		int threadsA = (profileA != _profiles.end()) ? profileA->second.threads : 1;
+		int threadsB = (profileB != _profiles.end()) ? profileB->second.threads : 1;
+		size_t memoryA = (profileA != _profiles.end()) ? profileA->second.memoryMB : 0;
+		size_t memoryB = (profileB != _profiles.end()) ? profileB->second.memoryMB : 0;
+
+		// Players take turns, so a game keeps busy only the threads of the heavier player at a time.
+		// Memory of both players is held for the entire game.
+		GameDemand demand;
+		demand.threads = (threadsA > threadsB) ? threadsA : threadsB;
+		demand.memoryMB = memoryA + memoryB;
+		return demand;
+	}
+
+	void ResourceAwareScheduler::admit(const string& playerAName, const string& playerBName)
+	{
+		GameDemand demand = demandOf(playerAName, playerBName);
+
+		unique_lock<mutex> lock(_resourcesLock);
+		_resourcesCV.wait(lock, [this, &demand]
+		{
+			// A game that doesn't fit the host at all still runs, but only on its own
+			return (_runningGames == 0) ||
+				   (((_threadsInUse + demand.threads) <= _threadsCapacity) &&
+				    ((_memoryInUseMB + demand.memoryMB) <= _memoryCapacityMB));
+		});
+
+		_threadsInUse += demand.threads;
+		_memoryInUseMB += demand.memoryMB;
+		_runningGames++;
+	}
+
+	void ResourceAwareScheduler::release(const string& playerAName, const string& playerBName)
+	{
+		GameDemand demand = demandOf(playerAName, playerBName);
+
+		{
+			lock_guard<mutex> lock(_resourcesLock);
+			_threadsInUse -= demand.threads;
+			_memoryInUseMB -= demand.memoryMB;
+			_runningGames--;
+		}
+
+		_resourcesCV.notify_all();
+	}
+}
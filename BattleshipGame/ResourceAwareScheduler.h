@@ -0,0 +1,116 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include "AlgoLoader.h"
+#include "BattleshipGameBoardFactory.h"
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::shared_ptr;
+using std::mutex;
+using std::condition_variable;
+
+namespace battleship
+{
+	/** Resources a single instance of a player algorithm needs while it plays a game */
+	struct AlgoResourceProfile
+	{
+		int threads;		// Number of threads the algorithm keeps busy (including the game thread itself)
+		size_t memoryMB;	// Memory the algorithm instance allocates, in megabytes
+		bool isDeclared;	// True if loaded from a profile file, false if measured in a calibration game
+	};
+
+	/** Admits games for execution only while the total CPU and memory demand of running games fits the host.
+	 *  Each algorithm gets a resource profile, either declared in a "<algorithm name>.profile" file next to
+	 *  its dll, or measured by a calibration game the algorithm plays against itself before the competition.
+	 *  Worker threads ask for admission before running a game and release the resources when it's over,
+	 *  so internally multithreaded or memory heavy players never run in too many copies at once.
+	 */
+	class ResourceAwareScheduler
+	{
+	public:
+		ResourceAwareScheduler(shared_ptr<BattleshipGameBoardFactory> boardLoader,
+							   shared_ptr<AlgoLoader> algoLoader);
+		virtual ~ResourceAwareScheduler() = default;
+
+		/** Loads declared profiles and measures the rest with calibration games.
+		 *  Must be called before the worker threads start, as calibration runs on the calling thread.
+		 */
+		void prepareProfiles(const vector<string>& algos);
+
+		/** Blocks until the game between the two players fits the host's free resources.
+		 *  A game is always admitted when no other game is running, even if it doesn't fit the host.
+		 *  This method is thread safe.
+		 */
+		void admit(const string& playerAName, const string& playerBName);
+
+		/** Returns the resources of a game admitted before.
+		 *  This method is thread safe.
+		 */
+		void release(const string& playerAName, const string& playerBName);
+
+	private:
+		/** Suffix of declared profile files */
+		static constexpr auto PROFILE_SUFFIX = ".profile";
+
+		/** Headers of the declared profile file attributes */
+		static constexpr auto PROFILE_HEADER_THREADS = "THREADS=";
+		static constexpr auto PROFILE_HEADER_MEMORY = "MEMORY_MB=";
+
+		/** Beginning of comments in the profile file - to be ignored by the parser */
+		static constexpr auto PROFILE_HEADER_COMMENT = "%%";
+
+		/** Fraction of the host's available physical memory that running games may use */
+		static constexpr double MEMORY_BUDGET_FRACTION = 0.8;
+
+		/** Interval between samples of the process threads and memory during a calibration game */
+		static constexpr int CALIBRATION_SAMPLE_MILLIS = 5;
+
+		/** Resources demanded by a single game */
+		struct GameDemand
+		{
+			int threads;
+			size_t memoryMB;
+		};
+
+		shared_ptr<BattleshipGameBoardFactory> _boardLoader;
+		shared_ptr<AlgoLoader> _algoLoader;
+
+		/** Resource profile for each algorithm */
+		unordered_map<string, AlgoResourceProfile> _profiles;
+
+		/** Capacity of the host */
+		int _threadsCapacity;
+		size_t _memoryCapacityMB;
+
+		/** Resources used by games that are running right now */
+		int _threadsInUse;
+		size_t _memoryInUseMB;
+		int _runningGames;
+
+		/** Protects the resources in use, waiting workers are woken up when resources are released */
+		mutex _resourcesLock;
+		condition_variable _resourcesCV;
+
+		/** Returns the resources needed for a game between the two players */
+		GameDemand demandOf(const string& playerAName, const string& playerBName) const;
+
+		/** Loads declared profile of the algorithm, returns false if the algorithm didn't declare one */
+		bool loadDeclaredProfile(const string& algoName, AlgoResourceProfile& profile) const;
+
+		/** Measures the algorithm's profile by running a game of the algorithm against itself */
+		AlgoResourceProfile measureProfile(const string& algoName, const string& boardName) const;
+
+		/** Returns the number of threads currently running in this process */
+		static int processThreadCount();
+
+		/** Returns the private memory committed by this process, in bytes */
+		static size_t processPrivateBytes();
+	};
+}
@@ -0,0 +1,182 @@
+#include "ResourceManifest.h"
+#include "IOUtil.h"
+#include "Logger.h"
+#include <windows.h>
+#include <algorithm>
+#include <fstream>
+
+using std::ifstream;
+using std::ofstream;
+
+namespace battleship
+{
+	static constexpr char HEADER_MAGIC[4] = { 'S', 'B', 'M', '1' };
+
+	// Extensions of the resource files: boards, board archives and player dlls
+	static const char* const RESOURCE_EXTENSIONS[] = { "sboard", "sboardb", "dll" };
+
+	ResourceManifest::ResourceManifest(const string& path) : _path(path), _isLoaded(false)
+	{
+		_isLoaded = load();
+		if (!_isLoaded)
+			_entries.clear();
+	}
+
+	bool ResourceManifest::isLoaded() const
+	{
+		return _isLoaded;
+	}
+
+	bool ResourceManifest::listFiles(const string& extension, vector<string>& files) const
+	{
+		if (!_isLoaded)
+			return false;
+
+		vector<string> listedFiles;
+		for (const auto& entry : _entries)
+		{
+			if (!IOUtil::endsWith(entry.name, "." + extension))
+				continue;
+
+			// A single attribute query per listed file, instead of enumerating the whole path
+			uint64_t size = 0;
+			uint64_t lastWriteTime = 0;
+			if (!fileStamp(_path + "\\" + entry.name, size, lastWriteTime) ||
+				(size != entry.size) || (lastWriteTime != entry.lastWriteTime))
+			{
+				LOG_LIMITED(Severity::WARNING_LEVEL, "Resource manifest of " + _path + " is out of date (" +
+							entry.name + " changed), regenerate it with BoardConverter manifest");
+				return false;
+			}
+
+			listedFiles.push_back(entry.name);
+		}
+
+		files = std::move(listedFiles);
+		return true;
+	}
+
+	const ManifestEntry* ResourceManifest::find(const string& name) const
+	{
+		auto entry = std::lower_bound(_entries.begin(), _entries.end(), name,
+									  [](const ManifestEntry& entry, const string& name) { return entry.name < name; });
+
+		return ((entry != _entries.end()) && (entry->name == name)) ? &*entry : nullptr;
+	}
+
+	bool ResourceManifest::fileStamp(const string& file, uint64_t& size, uint64_t& lastWriteTime)
+	{
+		WIN32_FILE_ATTRIBUTE_DATA attributes;
+		if (!GetFileAttributesExA(file.c_str(), GetFileExInfoStandard, &attributes) ||
+			(attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+		{
+			return false;
+		}
+
+		size = (static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+		lastWriteTime = (static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) |
+						attributes.ftLastWriteTime.dwLowDateTime;
+		return true;
+	}
+
+	bool ResourceManifest::write(const string& path, size_t& entriesCount)
+	{
+		vector<ManifestEntry> entries;
+		for (const char* extension : RESOURCE_EXTENSIONS)
+		{
+			for (const auto& fileName : IOUtil::listFilesInPath(path, extension))
+			{
+				ManifestEntry entry{ fileName, 0, 0, 0 };
+				string file = path + "\\" + fileName;
+				if (!fileStamp(file, entry.size, entry.lastWriteTime))
+					return false;
+
+				ifstream fs(file, ifstream::binary);
+				vector<char> content(static_cast<size_t>(entry.size));
+				if (!fs.is_open() || !fs.read(content.data(), content.size()))
+					return false;
+
+				entry.contentHash = IOUtil::hashBytes(content.data(), content.size());
+				entries.push_back(std::move(entry));
+			}
+		}
+
+		std::sort(entries.begin(), entries.end(),
+				  [](const ManifestEntry& first, const ManifestEntry& second) { return first.name < second.name; });
+
+		vector<char> buffer;
+		buffer.insert(buffer.end(), HEADER_MAGIC, HEADER_MAGIC + sizeof(HEADER_MAGIC));
+		IOUtil::putValue(buffer, VERSION);
+		IOUtil::putValue(buffer, static_cast<uint32_t>(entries.size()));
+		IOUtil::putValue(buffer, static_cast<uint32_t>(0));
+
+		for (const auto& entry : entries)
+		{
+			IOUtil::putString(buffer, entry.name);
+			IOUtil::putValue(buffer, entry.size);
+			IOUtil::putValue(buffer, entry.lastWriteTime);
+			IOUtil::putValue(buffer, entry.contentHash);
+		}
+
+		ofstream fs(path + "\\" + MANIFEST_FILE, ofstream::binary | ofstream::trunc);
+		if (!fs.is_open())
+			return false;
+
+		fs.write(buffer.data(), buffer.size());
+		if (!fs.good())
+			return false;
+
+		entriesCount = entries.size();
+		return true;
+	}
+
+	bool ResourceManifest::load()
+	{
+		ifstream fs(_path + "\\" + MANIFEST_FILE, ifstream::binary | ifstream::ate);
+		if (!fs.is_open())
+			return false;
+
+		// The whole manifest is read at once and parsed in memory
+		std::streamoff fileSize = fs.tellg();
+		if (fileSize < static_cast<std::streamoff>(HEADER_SIZE))
+			return false;
+
+		vector<char> buffer(static_cast<size_t>(fileSize));
+		fs.seekg(0);
+		if (!fs.read(buffer.data(), fileSize))
+			return false;
+
+		const char* cursor = buffer.data();
+		const char* end = buffer.data() + buffer.size();
+
+		char magic[4];
+		uint32_t version = 0;
+		uint32_t entriesCount = 0;
+		uint32_t reserved = 0;
+		IOUtil::getValue(cursor, end, magic);
+		IOUtil::getValue(cursor, end, version);
+		IOUtil::getValue(cursor, end, entriesCount);
+		IOUtil::getValue(cursor, end, reserved);
+
+		if ((std::memcmp(magic, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0) || (version != VERSION))
+			return false;
+
+		for (uint32_t entryIndex = 0; entryIndex < entriesCount; ++entryIndex)
+		{
+			ManifestEntry entry;
+			if (!IOUtil::getString(cursor, end, entry.name) || !IOUtil::getValue(cursor, end, entry.size) ||
+				!IOUtil::getValue(cursor, end, entry.lastWriteTime) || !IOUtil::getValue(cursor, end, entry.contentHash))
+			{
+				return false;
+			}
+
+			// Entries are looked up by name, so they must stay in name order
+			if (!_entries.empty() && !(_entries.back().name < entry.name))
+				return false;
+
+			_entries.push_back(std::move(entry));
+		}
+
+		return cursor == end;
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+namespace battleship
+{
+	/** A resource file of the working path, as listed in the manifest */
+	struct ManifestEntry
+	{
+		string name;			// File name (e.g. "board1.sboard")
+		uint64_t size;
+		uint64_t lastWriteTime;	// FILETIME of the last write, as a single number
+		uint64_t contentHash;	// Hash of the file's content (IOUtil::hashBytes)
+	};
+
+	/** Optional list of the resource files of a working path (boards, board archives and player dlls), kept in
+	 *  the path (resources.manifest) and generated with BoardConverter manifest <path>.
+	 *  The loaders take their files from the manifest instead of enumerating the path, which is slow on network
+	 *  mounted paths that hold many other files. A listed file is trusted while its size and write time are the
+	 *  same as listed, files added to the path are only found once the manifest is generated again.
+	 *
+	 *  Layout (little endian):
+	 *  Header   - "SBM1", version, entries count, reserved (16 bytes)
+	 *  Entries  - name length (4 bytes) and characters, size, last write time, content hash (8 bytes each),
+	 *             in name order
+	 */
+	class ResourceManifest
+	{
+	public:
+		static constexpr uint32_t VERSION = 1;
+		static constexpr size_t HEADER_SIZE = 16;
+
+		/** Manifest file name */
+		static constexpr auto MANIFEST_FILE = "resources.manifest";
+
+		/** Loads the manifest of the path. A missing or corrupt manifest is loaded empty (isLoaded is false). */
+		explicit ResourceManifest(const string& path);
+		virtual ~ResourceManifest() = default;
+
+		/** Returns true if the path has a manifest, stale or not */
+		bool isLoaded() const;
+
+		/** Lists the files of the manifest with the given extension (without a dot, e.g. "sboard"), sorted like
+		 *  IOUtil::listFilesInPath. Returns false if there's no manifest, or any of these files was removed or
+		 *  changed since the manifest was generated. The caller should enumerate the path then.
+		 */
+		bool listFiles(const string& extension, vector<string>& files) const;
+
+		/** Returns the entry of the file, or NULL if the file isn't listed */
+		const ManifestEntry* find(const string& name) const;
+
+		/** Lists and hashes the resource files of the path, and writes them to its manifest (replacing it).
+		 *  Returns false if a file couldn't be read or the manifest couldn't be written.
+		 */
+		static bool write(const string& path, size_t& entriesCount);
+
+		/** Reads the size and last write time of a file, returns false if it doesn't exist */
+		static bool fileStamp(const string& file, uint64_t& size, uint64_t& lastWriteTime);
+
+	private:
+		string _path;
+		vector<ManifestEntry> _entries; // In name order
+		bool _isLoaded;
+
+		/** Loads the entries of the manifest file, returns false if it's missing, corrupt or of another version */
+		bool load();
+	};
+}
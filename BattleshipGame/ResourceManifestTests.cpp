@@ -0,0 +1,179 @@
+#include "Tests.h"
+#include "IOUtil.h"
+#include "ResourceManifest.h"
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <random>
+
+namespace battleship
+{
+	namespace
+	{
+		constexpr auto RESOURCES_DIRECTORY = ".";
+		constexpr auto MANIFEST_PATH = ".\\resources.manifest"; // As the manifest joins its directory and file name
+
+		/** Resource files of the suite, the directory may hold other resource files (e.g. of other suites) */
+		const vector<string> RESOURCE_FILES = { "Tests_manifest_a.sboard", "Tests_manifest_b.sboard",
+												"Tests_manifest_c.sboardb", "Tests_manifest_p.dll" };
+		constexpr auto OTHER_FILE = "Tests_manifest_other.txt";
+
+		string resourcePath(const string& fileName)
+		{
+			return string(RESOURCES_DIRECTORY) + "\\" + fileName;
+		}
+
+		/** Returns true if the files listed by the manifest include the given files, in the same order */
+		bool isListed(const ResourceManifest& manifest, const string& extension, const vector<string>& expectedFiles)
+		{
+			vector<string> files;
+			if (!manifest.listFiles(extension, files))
+				return false;
+
+			vector<string> suiteFiles;
+			std::copy_if(files.begin(), files.end(), std::back_inserter(suiteFiles), [&expectedFiles](const string& file)
+			{
+				return std::find(expectedFiles.begin(), expectedFiles.end(), file) != expectedFiles.end();
+			});
+
+			return suiteFiles == expectedFiles;
+		}
+	}
+
+	void resourceManifestTests(unsigned int seed)
+	{
+		std::mt19937 random(seed);
+		std::remove(MANIFEST_PATH);
+
+		vector<vector<char>> contents;
+		for (const auto& fileName : RESOURCE_FILES)
+		{
+			vector<char> content(std::uniform_int_distribution<size_t>(0, 300)(random));
+			for (auto& byte : content)
+				byte = static_cast<char>(random());
+
+			TestRunner::writeBytes(resourcePath(fileName), content);
+			contents.push_back(std::move(content));
+		}
+
+		TestRunner::writeBytes(resourcePath(OTHER_FILE), { 'x' });
+
+		// Without a manifest the loaders enumerate the path
+		{
+			ResourceManifest manifest(RESOURCES_DIRECTORY);
+			vector<string> files;
+			TEST_CHECK(!manifest.isLoaded() && !manifest.listFiles("sboard", files));
+		}
+
+		// Round trip: the resource files are listed with their sizes and content hashes, other files aren't
+		size_t entriesCount = 0;
+		if (!TEST_CHECK(ResourceManifest::write(RESOURCES_DIRECTORY, entriesCount) && (entriesCount >= RESOURCE_FILES.size())))
+			return;
+
+		{
+			ResourceManifest manifest(RESOURCES_DIRECTORY);
+			TEST_CHECK(manifest.isLoaded());
+
+			for (size_t index = 0; index < RESOURCE_FILES.size(); ++index)
+			{
+				const ManifestEntry* entry = manifest.find(RESOURCE_FILES[index]);
+				const vector<char>& content = contents[index];
+				TestRunner::check((entry != nullptr) && (entry->size == content.size()) &&
+								  (entry->contentHash == IOUtil::hashBytes(content.data(), content.size())),
+								  "Resource " + RESOURCE_FILES[index] + " isn't listed as written");
+			}
+
+			TEST_CHECK(manifest.find(OTHER_FILE) == nullptr);
+			TEST_CHECK(isListed(manifest, "sboard", { RESOURCE_FILES[0], RESOURCE_FILES[1] }));
+			TEST_CHECK(isListed(manifest, "sboardb", { RESOURCE_FILES[2] }));
+			TEST_CHECK(isListed(manifest, "dll", { RESOURCE_FILES[3] }));
+		}
+
+		vector<char> bytes = TestRunner::readBytes(MANIFEST_PATH);
+
+		// A changed or removed file makes the files of its extension stale, other extensions are still listed
+		{
+			vector<char> content = contents[1];
+			content.push_back('x');
+			TestRunner::writeBytes(resourcePath(RESOURCE_FILES[1]), content);
+
+			ResourceManifest manifest(RESOURCES_DIRECTORY);
+			vector<string> files;
+			TEST_CHECK(!manifest.listFiles("sboard", files));
+			TEST_CHECK(isListed(manifest, "dll", { RESOURCE_FILES[3] }));
+
+			std::remove(resourcePath(RESOURCE_FILES[3]).c_str());
+			TEST_CHECK(!manifest.listFiles("dll", files));
+			TEST_CHECK(isListed(manifest, "sboardb", { RESOURCE_FILES[2] }));
+		}
+
+		// A truncated manifest isn't loaded
+		for (size_t size = 0; size < bytes.size(); ++size)
+		{
+			TestRunner::writeBytes(MANIFEST_PATH, vector<char>(bytes.begin(), bytes.begin() + size));
+			TestRunner::check(!ResourceManifest(RESOURCES_DIRECTORY).isLoaded(),
+							  "Truncated manifest of " + std::to_string(size) + " bytes is loaded");
+		}
+
+		// Damage is either rejected or leaves entries that are still found by their names
+		for (int damage = 0; damage < 1000; ++damage)
+		{
+			vector<char> damaged = bytes;
+			int changesCount = std::uniform_int_distribution<int>(1, 3)(random);
+			for (int change = 0; change < changesCount; ++change)
+			{
+				size_t offset = std::uniform_int_distribution<size_t>(0, damaged.size() - 1)(random);
+				damaged[offset] = static_cast<char>(std::uniform_int_distribution<int>(0, 255)(random));
+			}
+
+			TestRunner::writeBytes(MANIFEST_PATH, damaged);
+			ResourceManifest manifest(RESOURCES_DIRECTORY);
+			bool isFound = true;
+			for (const auto& fileName : RESOURCE_FILES)
+			{
+				const ManifestEntry* entry = manifest.find(fileName);
+				isFound = isFound && ((entry == nullptr) || (entry->name == fileName));
+			}
+
+			TEST_CHECK(isFound);
+		}
+
+		// Entries out of name order, a count or a name length past the end of the file, and a manifest of another
+		// version aren't loaded
+		{
+			vector<char> manifest(bytes.begin(), bytes.begin() + ResourceManifest::HEADER_SIZE);
+			manifest[8] = 2;
+			manifest[9] = manifest[10] = manifest[11] = 0;
+			for (const auto& name : { "b.sboard", "a.sboard" })
+			{
+				IOUtil::putString(manifest, name);
+				for (int value = 0; value < 3; ++value)
+					IOUtil::putValue(manifest, static_cast<uint64_t>(value));
+			}
+
+			TestRunner::writeBytes(MANIFEST_PATH, manifest);
+			TEST_CHECK(!ResourceManifest(RESOURCES_DIRECTORY).isLoaded());
+
+			vector<char> damaged = bytes;
+			std::fill(damaged.begin() + 8, damaged.begin() + 12, static_cast<char>(0xFF)); // Entries count
+			TestRunner::writeBytes(MANIFEST_PATH, damaged);
+			TEST_CHECK(!ResourceManifest(RESOURCES_DIRECTORY).isLoaded());
+
+			damaged = bytes;
+			std::fill(damaged.begin() + ResourceManifest::HEADER_SIZE, damaged.begin() + ResourceManifest::HEADER_SIZE + 4,
+					  static_cast<char>(0xFF)); // First name's length
+			TestRunner::writeBytes(MANIFEST_PATH, damaged);
+			TEST_CHECK(!ResourceManifest(RESOURCES_DIRECTORY).isLoaded());
+
+			damaged = bytes;
+			damaged[4]++;
+			TestRunner::writeBytes(MANIFEST_PATH, damaged);
+			TEST_CHECK(!ResourceManifest(RESOURCES_DIRECTORY).isLoaded());
+		}
+
+		std::remove(MANIFEST_PATH);
+		for (const auto& fileName : RESOURCE_FILES)
+			std::remove(resourcePath(fileName).c_str());
+		std::remove(resourcePath(OTHER_FILE).c_str());
+	}
+}
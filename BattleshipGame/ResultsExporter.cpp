@@ -0,0 +1,244 @@
+#include "ResultsExporter.h"
+#include "Logger.h"
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+
+using std::lock_guard;
+using std::unique_lock;
+using std::stringstream;
+using std::setprecision;
+using std::fixed;
+using std::to_string;
+
+namespace battleship
+{
+	ResultsExporter::ResultsExporter(const ExportSettings& settings, const string& directory) :
+		_format(settings.format),
+		_isClosing(false)
+	{
+		if (_format == ExportFormat::NONE)
+			return;
+
+		string extension = (_format == ExportFormat::CSV) ? ".csv" : ".jsonl";
+		string basePath = directory + "\\" + settings.fileName;
+		_gamesFile.open(basePath + "_games" + extension, std::ofstream::out | std::ofstream::trunc);
+		_roundsFile.open(basePath + "_rounds" + extension, std::ofstream::out | std::ofstream::trunc);
+
+		if (!_gamesFile.is_open() || !_roundsFile.is_open())
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+									  "Results export files could not be created at " + basePath + ", export is disabled",
+									  true); // true = Print to log & console
+			_format = ExportFormat::NONE;
+			return;
+		}
+
+		if (_format == ExportFormat::CSV)
+		{
+			_gamesBuffer = "player_a,player_b,board,winner,player_a_points,player_b_points,moves,duration_seconds\n";
+			_roundsBuffer = "round,place,player,wins,losses,ties,points_for,points_against,rating\n";
+		}
+
+		_writerThread = thread(&ResultsExporter::runWriterThread, this);
+	}
+
+	ResultsExporter::~ResultsExporter()
+	{
+		close();
+	}
+
+	bool ResultsExporter::parseFormat(const string& text, ExportFormat& format)
+	{
+		if (text == "none")
+			format = ExportFormat::NONE;
+		else if (text == "csv")
+			format = ExportFormat::CSV;
+		else if (text == "jsonl")
+			format = ExportFormat::JSON_LINES;
+		else
+			return false;
+
+		return true;
+	}
+
+	string ResultsExporter::formatToString(ExportFormat format)
+	{
+		switch (format)
+		{
+			case ExportFormat::CSV: return "csv";
+			case ExportFormat::JSON_LINES: return "jsonl";
+			case ExportFormat::NONE:
+			default: return "none";
+		}
+	}
+
+	bool ResultsExporter::isOpen() const
+	{
+		return _format != ExportFormat::NONE;
+	}
+
+	void ResultsExporter::exportGame(const string& playerA, const string& playerB, const string& board,
+									 const GameResults& results, double durationSeconds)
+	{
+		if (!isOpen())
+			return;
+
+		const string& winner = (results.winner == PlayerEnum::A) ? playerA :
+							   ((results.winner == PlayerEnum::B) ? playerB : string());
+		stringstream ss;
+		ss << fixed << setprecision(3);
+
+		if (_format == ExportFormat::CSV)
+		{
+			ss << csvField(playerA) << "," << csvField(playerB) << "," << csvField(board) << ","
+			   << csvField(winner) << "," << results.playerAPoints << "," << results.playerBPoints << ","
+			   << results.movesCount << "," << durationSeconds << "\n";
+		}
+		else
+		{
+			ss << "{\"player_a\":" << jsonString(playerA) << ",\"player_b\":" << jsonString(playerB)
+			   << ",\"board\":" << jsonString(board)
+			   << ",\"winner\":" << (winner.empty() ? string("null") : jsonString(winner))
+			   << ",\"player_a_points\":" << results.playerAPoints << ",\"player_b_points\":" << results.playerBPoints
+			   << ",\"moves\":" << results.movesCount << ",\"duration_seconds\":" << durationSeconds << "}\n";
+		}
+
+		appendRecord(_gamesBuffer, ss.str());
+	}
+
+	void ResultsExporter::exportRoundRow(int round, int place, const string& player,
+										 int wins, int loses, int ties, int pointsFor, int pointsAgainst, float rating)
+	{
+		if (!isOpen())
+			return;
+
+		stringstream ss;
+		ss << fixed << setprecision(2);
+
+		if (_format == ExportFormat::CSV)
+		{
+			ss << round << "," << place << "," << csvField(player) << "," << wins << "," << loses << "," << ties << ","
+			   << pointsFor << "," << pointsAgainst << "," << rating << "\n";
+		}
+		else
+		{
+			ss << "{\"round\":" << round << ",\"place\":" << place << ",\"player\":" << jsonString(player)
+			   << ",\"wins\":" << wins << ",\"losses\":" << loses << ",\"ties\":" << ties
+			   << ",\"points_for\":" << pointsFor << ",\"points_against\":" << pointsAgainst
+			   << ",\"rating\":" << rating << "}\n";
+		}
+
+		appendRecord(_roundsBuffer, ss.str());
+	}
+
+	void ResultsExporter::appendRecord(string& buffer, const string& record)
+	{
+		bool isFlushDue;
+		{
+			lock_guard<mutex> lock(_bufferLock);
+			if (_isClosing)
+				return;
+
+			buffer += record;
+			isFlushDue = (_gamesBuffer.size() + _roundsBuffer.size()) >= FLUSH_THRESHOLD_BYTES;
+		}
+
+		if (isFlushDue)
+			_bufferCV.notify_one();
+	}
+
+	void ResultsExporter::runWriterThread()
+	{
+		string games;
+		string rounds;
+		bool isDone = false;
+
+		while (!isDone)
+		{
+			{
+				// Take the buffered records, the files are written without holding the lock
+				unique_lock<mutex> lock(_bufferLock);
+				_bufferCV.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MILLIS), [this] {
+					return _isClosing || ((_gamesBuffer.size() + _roundsBuffer.size()) >= FLUSH_THRESHOLD_BYTES);
+				});
+
+				games.swap(_gamesBuffer);
+				rounds.swap(_roundsBuffer);
+				isDone = _isClosing;
+			}
+
+			_gamesFile << games;
+			_roundsFile << rounds;
+			_gamesFile.flush();
+			_roundsFile.flush();
+			games.clear();
+			rounds.clear();
+		}
+	}
+
+	void ResultsExporter::close()
+	{
+		{
+			lock_guard<mutex> lock(_bufferLock);
+			_isClosing = true;
+		}
+
+		_bufferCV.notify_one();
+
+		// The writer thread writes all remaining records before it exits
+		if (_writerThread.joinable())
+			_writerThread.join();
+
+		if (_gamesFile.is_open())
+			_gamesFile.close();
+		if (_roundsFile.is_open())
+			_roundsFile.close();
+	}
+
+	string ResultsExporter::csvField(const string& value)
+	{
+		if (value.find_first_of(",\"\r\n") == string::npos)
+			return value;
+
+		string quoted = "\"";
+		for (char c : value)
+		{
+			if (c == '"')
+				quoted += "\"\""; // Quotes are escaped by doubling them
+			else
+				quoted += c;
+		}
+
+		return quoted + "\"";
+	}
+
+	string ResultsExporter::jsonString(const string& value)
+	{
+		string escaped = "\"";
+		for (char c : value)
+		{
+			switch (c)
+			{
+				case '"': escaped += "\\\""; break;
+				case '\\': escaped += "\\\\"; break; // Windows paths are full of these
+				case '\n': escaped += "\\n"; break;
+				case '\r': escaped += "\\r"; break;
+				case '\t': escaped += "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20)
+					{
+						stringstream ss;
+						ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+						escaped += ss.str();
+					}
+					else
+					{
+						escaped += c;
+					}
+			}
+		}
+
+		return escaped + "\"";
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <fstream>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <string>
+#include "GameManager.h"
+
+using std::string;
+using std::ofstream;
+using std::mutex;
+using std::condition_variable;
+using std::thread;
+
+namespace battleship
+{
+	enum class ExportFormat
+	{
+		NONE,		// Results are only reported to the console and log
+		CSV,		// Comma separated values, with a header line
+		JSON_LINES	// A JSON object per line
+	};
+
+	/** Parameters of the results export, as loaded from the configuration file */
+	struct ExportSettings
+	{
+		ExportFormat format;
+		string fileName; // Base name of the export files, "_games" / "_rounds" and the extension are appended
+	};
+
+	/** Streams machine readable records of finished games and rounds to files.
+	 *  Records are formatted by the caller's thread into an in-memory buffer, and a background thread
+	 *  writes the buffer to the files, so slow disks never hold up the competition.
+	 *  Games are written to <fileName>_games.<ext> and rounds (a record per player) to <fileName>_rounds.<ext>.
+	 */
+	class ResultsExporter
+	{
+	public:
+		/** Creates the export files in the given directory and starts the writer thread */
+		ResultsExporter(const ExportSettings& settings, const string& directory);
+
+		/** Flushes all records written so far and stops the writer thread */
+		virtual ~ResultsExporter();
+
+		ResultsExporter(ResultsExporter const&) = delete;
+		void operator=(ResultsExporter const&) = delete;
+
+		static bool parseFormat(const string& text, ExportFormat& format);
+		static string formatToString(ExportFormat format);
+
+		/** Returns true if the export files were created and records are written to them */
+		bool isOpen() const;
+
+		/** Adds a record of a finished game. Thread safe, never waits for the disk. */
+		void exportGame(const string& playerA, const string& playerB, const string& board,
+						const GameResults& results, double durationSeconds);
+
+		/** Adds a record of a player's statistics at the end of a round. Thread safe, never waits for the disk. */
+		void exportRoundRow(int round, int place, const string& player,
+							int wins, int loses, int ties, int pointsFor, int pointsAgainst, float rating);
+
+		/** Writes all records added so far and closes the files. Further records are ignored. */
+		void close();
+
+	private:
+		/** The writer thread wakes up at least this often to write the buffered records */
+		static constexpr int FLUSH_INTERVAL_MILLIS = 500;
+
+		/** Buffered records beyond this size wake up the writer thread right away */
+		static constexpr size_t FLUSH_THRESHOLD_BYTES = 64 * 1024;
+
+		ExportFormat _format;
+		ofstream _gamesFile;
+		ofstream _roundsFile;
+
+		// Records waiting to be written, protected by _bufferLock
+		string _gamesBuffer;
+		string _roundsBuffer;
+		bool _isClosing;
+		mutex _bufferLock;
+		condition_variable _bufferCV;
+
+		thread _writerThread;
+
+		/** Writes the buffered records to the files until the exporter is closed */
+		void runWriterThread();
+
+		/** Appends the records to the buffer and wakes up the writer thread if enough are buffered */
+		void appendRecord(string& buffer, const string& record);
+
+		/** Quotes a CSV field if needed */
+		static string csvField(const string& value);
+
+		/** Quotes and escapes a JSON string */
+		static string jsonString(const string& value);
+	};
+}
@@ -0,0 +1,126 @@
+#include "ResultsStore.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::setw;
+using std::left;
+using std::fixed;
+using std::setprecision;
+using battleship::ResultsStoreReader;
+using battleship::HeadToHead;
+using battleship::BoardAggregate;
+
+/** Query tool for the results store (.bsr) written by the competition (RESULTS_STORE in config.ini).
+ *  Usage: ResultsQuery <store file> [summary|h2h|boards]
+ */
+
+static constexpr int SUCCESS_CODE = 0;
+static constexpr int ERROR_CODE = -1;
+
+static size_t nameWidth(const std::vector<string>& names)
+{
+	size_t width = 12;
+	for (const auto& name : names)
+		width = (name.length() + 2 > width) ? name.length() + 2 : width;
+
+	return width;
+}
+
+static void printSummary(const ResultsStoreReader& store)
+{
+	cout << "Games: " << store.gamesCount() << endl;
+	cout << "Players: " << store.players().size() << endl;
+	cout << "Boards: " << store.boards().size() << endl;
+}
+
+static void printHeadToHead(const ResultsStoreReader& store)
+{
+	const auto& players = store.players();
+	auto matrix = store.headToHead();
+	size_t width = nameWidth(players);
+
+	// Each cell is "wins-losses-ties" of the row player against the column player
+	cout << left << setw(width) << "";
+	for (size_t column = 0; column < players.size(); ++column)
+		cout << setw(16) << ("#" + std::to_string(column + 1));
+	cout << endl;
+
+	for (size_t row = 0; row < players.size(); ++row)
+	{
+		cout << setw(width) << ("#" + std::to_string(row + 1) + " " + players[row]);
+		for (size_t column = 0; column < players.size(); ++column)
+		{
+			const HeadToHead& results = matrix[row * players.size() + column];
+			const HeadToHead& opposite = matrix[column * players.size() + row];
+			string cell = (row == column) ? "-" : (std::to_string(results.wins) + "-" + std::to_string(opposite.wins) +
+												   "-" + std::to_string(results.ties));
+			cout << setw(16) << cell;
+		}
+		cout << endl;
+	}
+}
+
+static void printBoards(const ResultsStoreReader& store)
+{
+	const auto& boards = store.boards();
+	auto aggregates = store.boardAggregates();
+	size_t width = nameWidth(boards);
+
+	cout << left << setw(width) << "Board" << setw(10) << "Games" << setw(10) << "A wins %" << setw(10) << "B wins %"
+		 << setw(10) << "Ties %" << setw(12) << "Avg moves" << "Avg seconds" << endl << endl;
+
+	for (size_t board = 0; board < boards.size(); ++board)
+	{
+		const BoardAggregate& aggregate = aggregates[board];
+		double games = (aggregate.games > 0) ? static_cast<double>(aggregate.games) : 1;
+		double timedGames = (aggregate.timedGames > 0) ? static_cast<double>(aggregate.timedGames) : 1;
+
+		cout << setw(width) << boards[board] << setw(10) << aggregate.games << fixed << setprecision(2)
+			 << setw(10) << (100 * aggregate.playerAWins / games)
+			 << setw(10) << (100 * aggregate.playerBWins / games)
+			 << setw(10) << (100 * aggregate.ties / games)
+			 << setw(12) << (aggregate.totalMoves / games)
+			 << setprecision(4) << (aggregate.totalDurationMicros / timedGames / 1000000) << endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if ((argc < 2) || (argc > 3))
+	{
+		cerr << "Error: Try: ResultsQuery <store file> [summary|h2h|boards]" << endl;
+		return ERROR_CODE;
+	}
+
+	ResultsStoreReader store(argv[1]);
+	if (!store.isOpen())
+	{
+		cerr << "Error: " << argv[1] << " is missing or isn't a valid results store" << endl;
+		return ERROR_CODE;
+	}
+
+	string query = (argc == 3) ? argv[2] : "summary";
+	if (query == "summary")
+	{
+		printSummary(store);
+	}
+	else if (query == "h2h")
+	{
+		printHeadToHead(store);
+	}
+	else if (query == "boards")
+	{
+		printBoards(store);
+	}
+	else
+	{
+		cerr << "Error: Unknown query " << query << ". Try: summary, h2h or boards" << endl;
+		return ERROR_CODE;
+	}
+
+	return SUCCESS_CODE;
+}
@@ -0,0 +1,482 @@
+#include "ResultsStore.h"
+#include "IOUtil.h"
+#include "Logger.h"
+#include <cstring>
+
+namespace battleship
+{
+	static constexpr char HEADER_MAGIC[4] = { 'B', 'S', 'R', '1' };
+	static constexpr char TRAILER_MAGIC[4] = { 'B', 'S', 'R', 'F' };
+
+	// Number of 4 bytes columns in a block (the 1 byte winner column follows them)
+	static constexpr size_t WIDE_COLUMNS = 7;
+
+	// Size of a block's entry in the footer: offset, rows count and reserved
+	static constexpr size_t FOOTER_BLOCK_SIZE = 16;
+
+	// Suffix of a store that couldn't be read, moved aside so a new store is started without losing its games
+	static constexpr auto BAD_STORE_SUFFIX = ".bad";
+
+	template <typename T>
+	static void putColumn(vector<char>& buffer, const vector<T>& column)
+	{
+		const char* bytes = reinterpret_cast<const char*>(column.data());
+		buffer.insert(buffer.end(), bytes, bytes + column.size() * sizeof(T));
+	}
+
+	/** Parses the footer between cursor and end into the names and blocks lists */
+	static bool parseFooter(const char* cursor, const char* end,
+							vector<string>& players, vector<string>& boards, vector<StoreBlock>& blocks)
+	{
+		for (vector<string>* names : { &players, &boards })
+		{
+			uint32_t count = 0;
+			// Every name takes at least its length, so a corrupt count can't allocate more than the footer holds
+			if (!IOUtil::getValue(cursor, end, count) || (count > static_cast<size_t>(end - cursor) / sizeof(uint32_t)))
+				return false;
+
+			names->resize(count);
+			for (auto& name : *names)
+			{
+				if (!IOUtil::getString(cursor, end, name))
+					return false;
+			}
+		}
+
+		uint32_t blocksCount = 0;
+		if (!IOUtil::getValue(cursor, end, blocksCount) || (blocksCount > static_cast<size_t>(end - cursor) / FOOTER_BLOCK_SIZE))
+			return false;
+
+		blocks.resize(blocksCount);
+		for (auto& block : blocks)
+		{
+			uint32_t reserved = 0;
+			if (!IOUtil::getValue(cursor, end, block.offset) || !IOUtil::getValue(cursor, end, block.rowsCount) ||
+				!IOUtil::getValue(cursor, end, reserved))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Returns true if the header has the store's magic and the supported version */
+	static bool isValidHeader(const char* header)
+	{
+		uint32_t version = 0;
+		std::memcpy(&version, header + sizeof(HEADER_MAGIC), sizeof(uint32_t));
+		return !std::memcmp(header, HEADER_MAGIC, sizeof(HEADER_MAGIC)) && (version == ResultsStoreFormat::VERSION);
+	}
+
+	size_t ResultsStoreFormat::blockSize(uint32_t rowsCount)
+	{
+		size_t winnerBytes = (static_cast<size_t>(rowsCount) + 7) & ~static_cast<size_t>(7);
+		return winnerColumnOffset(rowsCount) + winnerBytes;
+	}
+
+	size_t ResultsStoreFormat::winnerColumnOffset(uint32_t rowsCount)
+	{
+		return BLOCK_HEADER_SIZE + WIDE_COLUMNS * sizeof(uint32_t) * rowsCount;
+	}
+
+	ResultsStoreWriter::ResultsStoreWriter(const string& path) :
+		_endOffset(ResultsStoreFormat::HEADER_SIZE)
+	{
+		// Existing stores are appended to, empty or missing files are created from scratch
+		_file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+		if (_file.is_open())
+		{
+			_file.seekg(0, std::ios::end);
+			bool isEmpty = (_file.tellg() <= 0);
+
+			if (isEmpty)
+			{
+				_file.close();
+			}
+			else if (!loadFooter())
+			{
+				// Games of earlier tournaments are never overwritten, the unreadable store is kept aside instead
+				_file.close();
+				_players.clear();
+				_boards.clear();
+				_blocks.clear();
+
+				string badPath = path + BAD_STORE_SUFFIX;
+				if (!MoveFileExA(path.c_str(), badPath.c_str(), MOVEFILE_REPLACE_EXISTING))
+				{
+					Logger::getInstance().log(Severity::ERROR_LEVEL, "Error: Results store " + path +
+											  " is not a valid store and couldn't be moved aside");
+					return;
+				}
+
+				Logger::getInstance().log(Severity::WARNING_LEVEL, "Results store " + path + " is not a valid store, " +
+										  "it was moved to " + badPath + " and a new store was started", true);
+			}
+		}
+
+		_file.clear(); // Reads may have hit the end of the file
+
+		if (!_file.is_open())
+		{
+			_file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!_file.is_open())
+				return;
+
+			vector<char> header;
+			header.insert(header.end(), HEADER_MAGIC, HEADER_MAGIC + sizeof(HEADER_MAGIC));
+			IOUtil::putValue(header, ResultsStoreFormat::VERSION);
+			IOUtil::putValue(header, static_cast<uint64_t>(0));
+			_file.write(header.data(), header.size());
+			_endOffset = ResultsStoreFormat::HEADER_SIZE;
+
+			// A new store is valid (and empty) from the start
+			writeFooter();
+		}
+
+		for (size_t id = 0; id < _players.size(); ++id)
+			_playerIds[_players[id]] = static_cast<uint32_t>(id);
+		for (size_t id = 0; id < _boards.size(); ++id)
+			_boardIds[_boards[id]] = static_cast<uint32_t>(id);
+	}
+
+	ResultsStoreWriter::~ResultsStoreWriter()
+	{
+		close();
+	}
+
+	bool ResultsStoreWriter::loadFooter()
+	{
+		_file.seekg(0, std::ios::end);
+		uint64_t size = static_cast<uint64_t>(_file.tellg());
+		if (size < ResultsStoreFormat::HEADER_SIZE + ResultsStoreFormat::TRAILER_SIZE)
+			return false;
+
+		vector<char> header(ResultsStoreFormat::HEADER_SIZE);
+		_file.seekg(0);
+		_file.read(header.data(), header.size());
+		if (!_file || !isValidHeader(header.data()))
+			return false;
+
+		vector<char> trailer(ResultsStoreFormat::TRAILER_SIZE);
+		_file.seekg(size - ResultsStoreFormat::TRAILER_SIZE);
+		_file.read(trailer.data(), trailer.size());
+		if (!_file || std::memcmp(trailer.data() + sizeof(uint64_t), TRAILER_MAGIC, sizeof(TRAILER_MAGIC)))
+			return false;
+
+		uint64_t footerOffset = 0;
+		std::memcpy(&footerOffset, trailer.data(), sizeof(uint64_t));
+		if ((footerOffset < ResultsStoreFormat::HEADER_SIZE) || (footerOffset > size - ResultsStoreFormat::TRAILER_SIZE))
+			return false;
+
+		vector<char> footer(static_cast<size_t>(size - ResultsStoreFormat::TRAILER_SIZE - footerOffset));
+		_file.seekg(footerOffset);
+		_file.read(footer.data(), footer.size());
+		if (!_file)
+			return false;
+
+		// New blocks go after the trailer, so the current footer stays valid until the next one is written
+		_endOffset = size;
+		return parseFooter(footer.data(), footer.data() + footer.size(), _players, _boards, _blocks);
+	}
+
+	bool ResultsStoreWriter::isOpen() const
+	{
+		return _file.is_open();
+	}
+
+	uint32_t ResultsStoreWriter::intern(const string& name, vector<string>& names,
+										unordered_map<string, uint32_t>& ids)
+	{
+		auto entry = ids.find(name);
+		if (entry != ids.end())
+			return entry->second;
+
+		uint32_t id = static_cast<uint32_t>(names.size());
+		names.push_back(name);
+		ids[name] = id;
+		return id;
+	}
+
+	void ResultsStoreWriter::append(const StoredGame& game)
+	{
+		if (!isOpen())
+			return;
+
+		_playerA.push_back(intern(game.playerA, _players, _playerIds));
+		_playerB.push_back(intern(game.playerB, _players, _playerIds));
+		_board.push_back(intern(game.board, _boards, _boardIds));
+		_playerAPoints.push_back(game.playerAPoints);
+		_playerBPoints.push_back(game.playerBPoints);
+		_moves.push_back(game.movesCount);
+		double durationMicros = game.durationSeconds * 1000000;
+		_durationMicros.push_back((durationMicros < UINT32_MAX) ? static_cast<uint32_t>(durationMicros) : UINT32_MAX);
+		_winner.push_back(static_cast<uint8_t>(game.winner));
+
+		if (_playerA.size() >= ResultsStoreFormat::BLOCK_ROWS)
+			writeBlock();
+	}
+
+	void ResultsStoreWriter::writeBlock()
+	{
+		uint32_t rowsCount = static_cast<uint32_t>(_playerA.size());
+		if (rowsCount == 0)
+			return;
+
+		vector<char> block;
+		block.reserve(ResultsStoreFormat::blockSize(rowsCount));
+		IOUtil::putValue(block, rowsCount);
+		IOUtil::putValue(block, static_cast<uint32_t>(0));
+		putColumn(block, _playerA);
+		putColumn(block, _playerB);
+		putColumn(block, _board);
+		putColumn(block, _playerAPoints);
+		putColumn(block, _playerBPoints);
+		putColumn(block, _moves);
+		putColumn(block, _durationMicros);
+		putColumn(block, _winner);
+		block.resize(ResultsStoreFormat::blockSize(rowsCount), 0); // Pad the winner column
+
+		// Blocks are written past the last trailer, followed by a new footer, so a valid trailer is always on disk.
+		// Footers have any length, so the block skips to the next aligned offset
+		_endOffset += (ResultsStoreFormat::BLOCK_ALIGNMENT - _endOffset % ResultsStoreFormat::BLOCK_ALIGNMENT) %
+					  ResultsStoreFormat::BLOCK_ALIGNMENT;
+		_file.seekp(_endOffset);
+		_file.write(block.data(), block.size());
+		_blocks.push_back(StoreBlock{ _endOffset, rowsCount });
+		_endOffset += block.size();
+
+		for (auto* column : { &_playerA, &_playerB, &_board, &_durationMicros })
+			column->clear();
+		for (auto* column : { &_playerAPoints, &_playerBPoints, &_moves })
+			column->clear();
+		_winner.clear();
+
+		writeFooter();
+	}
+
+	void ResultsStoreWriter::writeFooter()
+	{
+		vector<char> footer;
+		IOUtil::putValue(footer, static_cast<uint32_t>(_players.size()));
+		for (const auto& player : _players)
+			IOUtil::putString(footer, player);
+
+		IOUtil::putValue(footer, static_cast<uint32_t>(_boards.size()));
+		for (const auto& board : _boards)
+			IOUtil::putString(footer, board);
+
+		IOUtil::putValue(footer, static_cast<uint32_t>(_blocks.size()));
+		for (const auto& block : _blocks)
+		{
+			IOUtil::putValue(footer, block.offset);
+			IOUtil::putValue(footer, block.rowsCount);
+			IOUtil::putValue(footer, static_cast<uint32_t>(0));
+		}
+
+		IOUtil::putValue(footer, _endOffset);
+		footer.insert(footer.end(), TRAILER_MAGIC, TRAILER_MAGIC + sizeof(TRAILER_MAGIC));
+		IOUtil::putValue(footer, static_cast<uint32_t>(0));
+
+		// The footer is appended and flushed, the footer it replaces is left behind unused
+		_file.seekp(_endOffset);
+		_file.write(footer.data(), footer.size());
+		_file.flush();
+		_endOffset += footer.size();
+	}
+
+	void ResultsStoreWriter::close()
+	{
+		if (!isOpen())
+			return;
+
+		writeBlock();
+		_file.close();
+	}
+
+	ResultsStoreReader::ResultsStoreReader(const string& path) :
+		_fileHandle(INVALID_HANDLE_VALUE),
+		_mappingHandle(nullptr),
+		_data(nullptr),
+		_size(0),
+		_gamesCount(0)
+	{
+		_fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+								  FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (_fileHandle == INVALID_HANDLE_VALUE)
+			return;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(_fileHandle, &size) || (size.QuadPart == 0))
+			return;
+
+		_size = static_cast<uint64_t>(size.QuadPart);
+		_mappingHandle = CreateFileMappingA(_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (_mappingHandle == nullptr)
+			return;
+
+		_data = static_cast<const uint8_t*>(MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+		if ((_data != nullptr) && !parse())
+		{
+			UnmapViewOfFile(_data);
+			_data = nullptr;
+		}
+	}
+
+	ResultsStoreReader::~ResultsStoreReader()
+	{
+		if (_data != nullptr)
+			UnmapViewOfFile(_data);
+		if (_mappingHandle != nullptr)
+			CloseHandle(_mappingHandle);
+		if (_fileHandle != INVALID_HANDLE_VALUE)
+			CloseHandle(_fileHandle);
+	}
+
+	bool ResultsStoreReader::parse()
+	{
+		if (_size < ResultsStoreFormat::HEADER_SIZE + ResultsStoreFormat::TRAILER_SIZE)
+			return false;
+
+		const char* data = reinterpret_cast<const char*>(_data);
+		const char* trailer = data + _size - ResultsStoreFormat::TRAILER_SIZE;
+		if (!isValidHeader(data) || std::memcmp(trailer + sizeof(uint64_t), TRAILER_MAGIC, sizeof(TRAILER_MAGIC)))
+			return false;
+
+		uint64_t footerOffset = 0;
+		std::memcpy(&footerOffset, trailer, sizeof(uint64_t));
+		if ((footerOffset < ResultsStoreFormat::HEADER_SIZE) || (footerOffset > _size - ResultsStoreFormat::TRAILER_SIZE))
+			return false;
+
+		if (!parseFooter(data + footerOffset, trailer, _players, _boards, _blocks))
+			return false;
+
+		for (const auto& block : _blocks)
+		{
+			if ((block.offset < ResultsStoreFormat::HEADER_SIZE) || (block.offset > footerOffset) ||
+				(block.offset % ResultsStoreFormat::BLOCK_ALIGNMENT != 0) ||
+				(block.rowsCount > footerOffset - block.offset) ||
+				(ResultsStoreFormat::blockSize(block.rowsCount) > footerOffset - block.offset))
+			{
+				return false;
+			}
+
+			// Queries index their results by these ids without checks, so a single id out of range rejects the file
+			const uint32_t* playerA = column<uint32_t>(block, 0);
+			const uint32_t* playerB = column<uint32_t>(block, 1);
+			const uint32_t* board = column<uint32_t>(block, 2);
+			for (uint32_t row = 0; row < block.rowsCount; ++row)
+			{
+				if ((playerA[row] >= _players.size()) || (playerB[row] >= _players.size()) || (board[row] >= _boards.size()))
+					return false;
+			}
+
+			_gamesCount += block.rowsCount;
+		}
+
+		return true;
+	}
+
+	bool ResultsStoreReader::isOpen() const
+	{
+		return _data != nullptr;
+	}
+
+	const vector<string>& ResultsStoreReader::players() const
+	{
+		return _players;
+	}
+
+	const vector<string>& ResultsStoreReader::boards() const
+	{
+		return _boards;
+	}
+
+	uint64_t ResultsStoreReader::gamesCount() const
+	{
+		return _gamesCount;
+	}
+
+	const uint8_t* ResultsStoreReader::winnerColumn(const StoreBlock& block) const
+	{
+		return _data + block.offset + ResultsStoreFormat::winnerColumnOffset(block.rowsCount);
+	}
+
+	vector<HeadToHead> ResultsStoreReader::headToHead() const
+	{
+		size_t playersCount = _players.size();
+		vector<HeadToHead> matrix(playersCount * playersCount, HeadToHead{ 0, 0 });
+
+		for (const auto& block : _blocks)
+		{
+			const uint32_t* playerA = column<uint32_t>(block, 0);
+			const uint32_t* playerB = column<uint32_t>(block, 1);
+			const uint8_t* winner = winnerColumn(block);
+
+			for (uint32_t row = 0; row < block.rowsCount; ++row)
+			{
+				uint32_t a = playerA[row];
+				uint32_t b = playerB[row];
+				uint8_t code = winner[row];
+
+				// Branch free: only the matching cells are incremented
+				matrix[a * playersCount + b].wins += (code == static_cast<uint8_t>(StoredWinner::PLAYER_A));
+				matrix[b * playersCount + a].wins += (code == static_cast<uint8_t>(StoredWinner::PLAYER_B));
+				uint32_t isTie = (code == static_cast<uint8_t>(StoredWinner::NONE));
+				matrix[a * playersCount + b].ties += isTie;
+				matrix[b * playersCount + a].ties += isTie;
+			}
+		}
+
+		return matrix;
+	}
+
+	vector<BoardAggregate> ResultsStoreReader::boardAggregates() const
+	{
+		vector<BoardAggregate> aggregates(_boards.size(), BoardAggregate{ 0, 0, 0, 0, 0, 0, 0 });
+
+		for (const auto& block : _blocks)
+		{
+			const uint32_t* board = column<uint32_t>(block, 2);
+			const int32_t* moves = column<int32_t>(block, 5);
+			const uint32_t* durationMicros = column<uint32_t>(block, 6);
+			const uint8_t* winner = winnerColumn(block);
+
+			// Games of a tournament come in long runs on the same board, so runs are summed with tight
+			// loops over the contiguous columns (vectorized by the compiler) before they are scattered
+			uint32_t runStart = 0;
+			while (runStart < block.rowsCount)
+			{
+				uint32_t runBoard = board[runStart];
+				uint32_t runEnd = runStart + 1;
+				while ((runEnd < block.rowsCount) && (board[runEnd] == runBoard))
+					runEnd++;
+
+				uint64_t totalMoves = 0, totalDuration = 0;
+				uint32_t winsA = 0, winsB = 0, timed = 0;
+				for (uint32_t row = runStart; row < runEnd; ++row)
+				{
+					totalMoves += static_cast<uint32_t>(moves[row]);
+					totalDuration += durationMicros[row];
+					timed += (durationMicros[row] != 0);
+					winsA += (winner[row] == static_cast<uint8_t>(StoredWinner::PLAYER_A));
+					winsB += (winner[row] == static_cast<uint8_t>(StoredWinner::PLAYER_B));
+				}
+
+				BoardAggregate& aggregate = aggregates[runBoard];
+				uint32_t games = runEnd - runStart;
+				aggregate.games += games;
+				aggregate.playerAWins += winsA;
+				aggregate.playerBWins += winsB;
+				aggregate.ties += games - winsA - winsB;
+				aggregate.totalMoves += totalMoves;
+				aggregate.timedGames += timed;
+				aggregate.totalDurationMicros += totalDuration;
+
+				runStart = runEnd;
+			}
+		}
+
+		return aggregates;
+	}
+}
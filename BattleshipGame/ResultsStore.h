@@ -0,0 +1,204 @@
+#pragma once
+
+#include <windows.h>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::fstream;
+
+namespace battleship
+{
+	/** Winner codes of the stored games */
+	enum class StoredWinner : uint8_t
+	{
+		PLAYER_A = 0,
+		PLAYER_B = 1,
+		NONE = 2
+	};
+
+	/** A single game outcome, as written to the results store */
+	struct StoredGame
+	{
+		string playerA;
+		string playerB;
+		string board;
+		int32_t playerAPoints;
+		int32_t playerBPoints;
+		StoredWinner winner;
+		int32_t movesCount;
+		double durationSeconds; // 0 for a game credited from an equivalent game instead of run
+	};
+
+	/** Columnar, append only file of game outcomes (.bsr), kept across tournaments.
+	 *
+	 *  Layout (little endian):
+	 *  Header   - "BSR1", version, reserved (16 bytes)
+	 *  Blocks   - at offsets aligned to 8 bytes (so columns are read in place), rows count, reserved, then each
+	 *             column for all rows of the block:
+	 *             player A id, player B id, board id, player A points, player B points, moves,
+	 *             duration in microseconds (4 bytes each), winner (1 byte, padded to 8 bytes)
+	 *  Footer   - player names, board names (ids are indices into these), then the offset and rows count
+	 *             of each block
+	 *  Trailer  - footer offset, "BSRF", reserved (16 bytes)
+	 *
+	 *  Each block is appended after the last trailer and followed by a new footer and trailer, so the file always
+	 *  ends with a valid trailer (the footers they replace are left unused). A file that can't be read is never
+	 *  overwritten - the writer moves it aside (".bad") and starts a new store.
+	 */
+	class ResultsStoreFormat
+	{
+	public:
+		virtual ~ResultsStoreFormat() = delete; // Format constants only
+
+		static constexpr uint32_t VERSION = 1;
+		static constexpr size_t HEADER_SIZE = 16;
+		static constexpr size_t TRAILER_SIZE = 16;
+		static constexpr size_t BLOCK_HEADER_SIZE = 8;
+		static constexpr size_t BLOCK_ALIGNMENT = 8;
+		static constexpr uint32_t BLOCK_ROWS = 4096;
+
+		/** Size in bytes of a block with the given number of rows */
+		static size_t blockSize(uint32_t rowsCount);
+
+		/** Offset of the winner column in a block with the given number of rows */
+		static size_t winnerColumnOffset(uint32_t rowsCount);
+	};
+
+	/** Position of a block in the store */
+	struct StoreBlock
+	{
+		uint64_t offset;
+		uint32_t rowsCount;
+	};
+
+	/** Appends game outcomes to a results store, one block at a time.
+	 *  Not thread safe - the scoreboard appends from the main thread only.
+	 */
+	class ResultsStoreWriter
+	{
+	public:
+		/** Opens the store for appending, creating it if it doesn't exist (check isOpen).
+		 *  An invalid store is moved aside to path.bad, the writer isn't opened if it can't be moved.
+		 */
+		explicit ResultsStoreWriter(const string& path);
+
+		/** Writes the last block and the footer */
+		virtual ~ResultsStoreWriter();
+
+		ResultsStoreWriter(ResultsStoreWriter const&) = delete;
+		void operator=(ResultsStoreWriter const&) = delete;
+
+		bool isOpen() const;
+
+		void append(const StoredGame& game);
+
+		/** Writes the pending rows and the footer, and closes the file. Further games are ignored. */
+		void close();
+
+	private:
+		fstream _file;
+		uint64_t _endOffset; // End of the last trailer, new blocks and footers are written from here
+
+		// Interned names, ids are indices into these lists
+		vector<string> _players;
+		vector<string> _boards;
+		unordered_map<string, uint32_t> _playerIds;
+		unordered_map<string, uint32_t> _boardIds;
+
+		vector<StoreBlock> _blocks;
+
+		// Columns of the block being filled
+		vector<uint32_t> _playerA;
+		vector<uint32_t> _playerB;
+		vector<uint32_t> _board;
+		vector<int32_t> _playerAPoints;
+		vector<int32_t> _playerBPoints;
+		vector<int32_t> _moves;
+		vector<uint32_t> _durationMicros;
+		vector<uint8_t> _winner;
+
+		/** Loads the names and blocks of an existing store, returns false if it isn't a valid store */
+		bool loadFooter();
+
+		/** Writes the pending rows as a block, followed by a new footer */
+		void writeBlock();
+		void writeFooter();
+
+		static uint32_t intern(const string& name, vector<string>& names, unordered_map<string, uint32_t>& ids);
+	};
+
+	/** Head to head results of two players over all stored games */
+	struct HeadToHead
+	{
+		uint32_t wins;		// Games won by the row player against the column player
+		uint32_t ties;
+	};
+
+	/** Aggregated outcomes of all games played on a board */
+	struct BoardAggregate
+	{
+		uint64_t games;
+		uint64_t playerAWins;
+		uint64_t playerBWins;
+		uint64_t ties;
+		uint64_t totalMoves;
+		uint64_t timedGames; // Games with a recorded duration, credited games have none
+		uint64_t totalDurationMicros;
+	};
+
+	/** Read only view of a results store, memory mapped so queries scan the columns in place */
+	class ResultsStoreReader
+	{
+	public:
+		/** Maps the store (check isOpen) */
+		explicit ResultsStoreReader(const string& path);
+		virtual ~ResultsStoreReader();
+
+		ResultsStoreReader(ResultsStoreReader const&) = delete;
+		void operator=(ResultsStoreReader const&) = delete;
+
+		bool isOpen() const;
+
+		const vector<string>& players() const;
+		const vector<string>& boards() const;
+		uint64_t gamesCount() const;
+
+		/** Returns the players x players matrix (row major) of head to head results */
+		vector<HeadToHead> headToHead() const;
+
+		/** Returns the aggregated outcomes of each board (indexed by board id) */
+		vector<BoardAggregate> boardAggregates() const;
+
+	private:
+		HANDLE _fileHandle;
+		HANDLE _mappingHandle;
+		const uint8_t* _data;
+		uint64_t _size;
+
+		vector<string> _players;
+		vector<string> _boards;
+		vector<StoreBlock> _blocks;
+		uint64_t _gamesCount;
+
+		/** Parses the trailer and the footer and checks the ids of all games,
+		 *  returns false if the file isn't a valid store
+		 */
+		bool parse();
+
+		/** Returns the column of a block that starts columnIndex columns of 4 bytes into it */
+		template <typename T>
+		const T* column(const StoreBlock& block, size_t columnIndex) const
+		{
+			return reinterpret_cast<const T*>(_data + block.offset + ResultsStoreFormat::BLOCK_HEADER_SIZE +
+											  columnIndex * block.rowsCount * sizeof(uint32_t));
+		}
+
+		const uint8_t* winnerColumn(const StoreBlock& block) const;
+	};
+}
@@ -0,0 +1,215 @@
+#include "Tests.h"
+#include "ResultsStore.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace battleship
+{
+	namespace
+	{
+		/** Returns random games of a few players on a few boards, a tenth of them credited (no duration) */
+		vector<StoredGame> randomGames(std::mt19937& random, size_t gamesCount)
+		{
+			static const vector<string> PLAYERS = { "HuntTargetAlgo.dll", "NaiveAlgo.dll", "SmartAlgo.dll", "RandomAlgo.dll" };
+			static const vector<string> BOARDS = { "good_board_0.sboard", "good_board_1.sboard", "big.sboardb" };
+			auto uniform = [&random](int min, int max) { return std::uniform_int_distribution<int>(min, max)(random); };
+
+			vector<StoredGame> games;
+			for (size_t game = 0; game < gamesCount; ++game)
+			{
+				int playerA = uniform(0, 3);
+				int playerB = (playerA + uniform(1, 3)) % 4;
+				bool isCredited = (uniform(0, 9) == 0);
+
+				// Quarters of a second are stored exactly in microseconds
+				games.push_back(StoredGame{ PLAYERS[playerA], PLAYERS[playerB], BOARDS[uniform(0, 2)], uniform(0, 30),
+											uniform(0, 30), static_cast<StoredWinner>(uniform(0, 2)), uniform(1, 500),
+											isCredited ? 0 : uniform(1, 40) * 0.25 });
+			}
+
+			return games;
+		}
+
+		void writeGames(const string& path, const vector<StoredGame>& games, size_t first, size_t last)
+		{
+			ResultsStoreWriter writer(path);
+			TEST_CHECK(writer.isOpen());
+
+			for (size_t game = first; game < last; ++game)
+				writer.append(games[game]);
+		}
+
+		size_t indexOf(const vector<string>& names, const string& name)
+		{
+			return std::find(names.begin(), names.end(), name) - names.begin();
+		}
+
+		/** Checks that the store holds exactly the given games */
+		void checkStore(const string& path, const vector<StoredGame>& games)
+		{
+			ResultsStoreReader store(path);
+			if (!TEST_CHECK(store.isOpen()))
+				return;
+
+			TEST_CHECK(store.gamesCount() == games.size());
+
+			const vector<string>& players = store.players();
+			const vector<string>& boards = store.boards();
+			vector<HeadToHead> expectedHeadToHead(players.size() * players.size(), HeadToHead{ 0, 0 });
+			vector<BoardAggregate> expectedAggregates(boards.size(), BoardAggregate{ 0, 0, 0, 0, 0, 0, 0 });
+
+			for (const auto& game : games)
+			{
+				size_t a = indexOf(players, game.playerA);
+				size_t b = indexOf(players, game.playerB);
+				size_t board = indexOf(boards, game.board);
+				if (!TEST_CHECK((a < players.size()) && (b < players.size()) && (board < boards.size())))
+					return;
+
+				BoardAggregate& aggregate = expectedAggregates[board];
+				aggregate.games++;
+				aggregate.totalMoves += game.movesCount;
+				aggregate.timedGames += (game.durationSeconds > 0) ? 1 : 0;
+				aggregate.totalDurationMicros += static_cast<uint64_t>(game.durationSeconds * 1000000);
+
+				switch (game.winner)
+				{
+					case StoredWinner::PLAYER_A:
+						aggregate.playerAWins++;
+						expectedHeadToHead[a * players.size() + b].wins++;
+						break;
+					case StoredWinner::PLAYER_B:
+						aggregate.playerBWins++;
+						expectedHeadToHead[b * players.size() + a].wins++;
+						break;
+					case StoredWinner::NONE:
+						aggregate.ties++;
+						expectedHeadToHead[a * players.size() + b].ties++;
+						expectedHeadToHead[b * players.size() + a].ties++;
+						break;
+				}
+			}
+
+			vector<HeadToHead> headToHead = store.headToHead();
+			bool isHeadToHeadEqual = (headToHead.size() == expectedHeadToHead.size());
+			for (size_t cell = 0; isHeadToHeadEqual && (cell < headToHead.size()); ++cell)
+			{
+				isHeadToHeadEqual = (headToHead[cell].wins == expectedHeadToHead[cell].wins) &&
+									(headToHead[cell].ties == expectedHeadToHead[cell].ties);
+			}
+
+			TEST_CHECK(isHeadToHeadEqual);
+
+			vector<BoardAggregate> aggregates = store.boardAggregates();
+			bool isAggregatesEqual = (aggregates.size() == expectedAggregates.size());
+			for (size_t board = 0; isAggregatesEqual && (board < aggregates.size()); ++board)
+			{
+				const BoardAggregate& actual = aggregates[board];
+				const BoardAggregate& expected = expectedAggregates[board];
+				isAggregatesEqual = (actual.games == expected.games) && (actual.playerAWins == expected.playerAWins) &&
+									(actual.playerBWins == expected.playerBWins) && (actual.ties == expected.ties) &&
+									(actual.totalMoves == expected.totalMoves) && (actual.timedGames == expected.timedGames) &&
+									(actual.totalDurationMicros == expected.totalDurationMicros);
+			}
+
+			TEST_CHECK(isAggregatesEqual);
+		}
+
+		/** Opens a damaged store and runs the queries on it if it's accepted, returns the games count it reports */
+		uint64_t readDamagedStore(const string& path)
+		{
+			ResultsStoreReader store(path);
+			if (!store.isOpen())
+				return 0;
+
+			uint64_t gamesCount = 0;
+			for (const auto& aggregate : store.boardAggregates())
+				gamesCount += aggregate.games;
+
+			store.headToHead();
+			TEST_CHECK(gamesCount == store.gamesCount());
+			return gamesCount;
+		}
+	}
+
+	void resultsStoreTests(unsigned int seed)
+	{
+		std::mt19937 random(seed);
+		string path = TestRunner::scratchPath("results.bsr");
+		string crashPath = TestRunner::scratchPath("crash.bsr");
+		string damagedPath = TestRunner::scratchPath("damaged.bsr");
+		string emptyPath = TestRunner::scratchPath("empty.bsr");
+		TestRunner::scratchPath("results.bsr.bad");
+
+		// Round trip over three tournaments, each appending to the store of the previous ones
+		size_t blockRows = ResultsStoreFormat::BLOCK_ROWS;
+		vector<StoredGame> games = randomGames(random, 2 * blockRows + 100);
+		writeGames(path, games, 0, 10);
+		writeGames(path, games, 10, blockRows + 50);
+		writeGames(path, games, blockRows + 50, games.size());
+		checkStore(path, games);
+
+		// Every full block is readable while the writer is still running (as if the tournament crashed)
+		{
+			ResultsStoreWriter writer(crashPath);
+			for (size_t game = 0; game < blockRows + 10; ++game)
+				writer.append(games[game]);
+
+			TestRunner::writeBytes(damagedPath, TestRunner::readBytes(crashPath));
+			checkStore(damagedPath, vector<StoredGame>(games.begin(), games.begin() + blockRows));
+		}
+
+		// A truncated store is rejected, or read as the store it was when an earlier footer was written
+		vector<char> bytes = TestRunner::readBytes(path);
+		for (size_t size = 0; size < bytes.size(); size += 1 + (size * 7) % 1021)
+		{
+			TestRunner::writeBytes(damagedPath, vector<char>(bytes.begin(), bytes.begin() + size));
+			uint64_t gamesCount = readDamagedStore(damagedPath);
+			TestRunner::check((gamesCount == 0) || (gamesCount == 10) || (gamesCount == blockRows + 10) ||
+							  (gamesCount == blockRows + 50) || (gamesCount == 2 * blockRows + 50),
+							  "Truncated store of " + std::to_string(size) + " bytes read with " +
+							  std::to_string(gamesCount) + " games");
+		}
+
+		// Random damage never makes the reader read out of the file
+		for (int damage = 0; damage < 300; ++damage)
+		{
+			vector<char> damaged = bytes;
+			int changesCount = std::uniform_int_distribution<int>(1, 4)(random);
+			for (int change = 0; change < changesCount; ++change)
+			{
+				size_t offset = std::uniform_int_distribution<size_t>(0, damaged.size() - 1)(random);
+				damaged[offset] = static_cast<char>(std::uniform_int_distribution<int>(0, 255)(random));
+			}
+
+			TestRunner::writeBytes(damagedPath, damaged);
+			readDamagedStore(damagedPath);
+		}
+
+		// An id past the names in the footer rejects the whole store
+		{
+			// The first block is written after the header and the footer of the store's first writer
+			writeGames(emptyPath, games, 0, 0);
+			size_t firstBlockOffset = TestRunner::readBytes(emptyPath).size();
+			firstBlockOffset += (ResultsStoreFormat::BLOCK_ALIGNMENT - firstBlockOffset % ResultsStoreFormat::BLOCK_ALIGNMENT) %
+								ResultsStoreFormat::BLOCK_ALIGNMENT;
+
+			vector<char> damaged = bytes;
+			uint32_t badId = 1000;
+			std::memcpy(damaged.data() + firstBlockOffset + ResultsStoreFormat::BLOCK_HEADER_SIZE, &badId, sizeof(badId));
+			TestRunner::writeBytes(damagedPath, damaged);
+			TEST_CHECK(!ResultsStoreReader(damagedPath).isOpen());
+		}
+
+		// A writer never overwrites an invalid store, it's moved aside and a new store is started
+		{
+			vector<char> damaged(bytes.begin(), bytes.end() - 1);
+			TestRunner::writeBytes(path, damaged);
+			writeGames(path, games, 0, 10);
+
+			TEST_CHECK(TestRunner::readBytes(path + ".bad") == damaged);
+			checkStore(path, vector<StoredGame>(games.begin(), games.begin() + 10));
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#include "RoundRobinFormat.h"
+#include <queue>
+
+using std::queue;
+
+namespace battleship
+{
+	RoundRobinFormat::RoundRobinFormat(const vector<string>& players, const vector<string>& boards) :
+		TournamentFormat(players, boards, 0) // Round robin is always played on all boards
+	{
+	}
+
+	size_t RoundRobinFormat::maxRoundsPerPlayer() const
+	{
+		// Total games for each player: play twice against each player other player on each board
+		return (_players.size() - 1) * 2 * _boards.size();
+	}
+
+	bool RoundRobinFormat::nextStage(const Standings& standings, TournamentStage& stage)
+	{
+		// All games are played in a single stage
+		if ((_stagesPlayed > 0) || (_players.size() < 2))
+			return false;
+
+		// Iterate all boards and players and create SingleGameTask for each valid combination
+		queue<unique_ptr<SingleGameTask>> inversedGamesSet;
+		size_t numOfAlgos = _players.size() - 1;
+		for (const auto& board : _boards)
+		{
+			// Each round is a diagonal in the game matrix (without the main diagonal),
+			// and we run over it from both sides in order to get a balanced tournament
+			for (size_t round = 1; round <= numOfAlgos; ++round)
+			{
+				for (size_t algo1 = 0, algo2 = round; ((algo1 <= (numOfAlgos - algo2)) && (algo2 <= numOfAlgos)); ++algo1, ++algo2)
+				{
+					stage.games.push_back(std::make_unique<SingleGameTask>(_players[algo1], _players[algo2], board));
+					inversedGamesSet.push(std::make_unique<SingleGameTask>(_players[algo2], _players[algo1], board));
+					if (algo1 != (numOfAlgos - algo2))	// On the secondary diagonal 'algo1' and 'numOfAlgos-algo2' indices meet
+														// and we don't want to add them twice
+					{
+						stage.games.push_back(std::make_unique<SingleGameTask>(_players[numOfAlgos-algo2], _players[numOfAlgos-algo1], board));
+						inversedGamesSet.push(std::make_unique<SingleGameTask>(_players[numOfAlgos-algo1], _players[numOfAlgos-algo2], board));
+					}
+				}
+			}
+		}
+
+		// Move inversed games after the main ones
+		while (!inversedGamesSet.empty())
+		{
+			stage.games.push_back(std::move(inversedGamesSet.front()));
+			inversedGamesSet.pop();
+		}
+
+		_stagesPlayed++;
+		return true;
+	}
+}
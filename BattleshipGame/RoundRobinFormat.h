@@ -0,0 +1,20 @@
+#pragma once
+
+#include "TournamentFormat.h"
+
+namespace battleship
+{
+	/** Full double round robin: every player plays twice against every other player on every board
+	 *  (once as player A and once as player B), all in a single stage.
+	 *  Costs O(players^2 * boards) games, so fits small pools of players.
+	 */
+	class RoundRobinFormat : public TournamentFormat
+	{
+	public:
+		RoundRobinFormat(const vector<string>& players, const vector<string>& boards);
+		virtual ~RoundRobinFormat() = default;
+
+		size_t maxRoundsPerPlayer() const override;
+		bool nextStage(const Standings& standings, TournamentStage& stage) override;
+	};
+}
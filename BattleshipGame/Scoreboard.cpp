@@ -1,12 +1,13 @@
 #include "Scoreboard.h"
 #include "Logger.h"
-#include "ConsoleUtils.h"
+#include "EventLog.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <string>
 #include <sstream>
 #include <chrono>
+#include <thread>
 
 using std::lock_guard;
 using std::unique_lock;
@@ -22,22 +23,36 @@ using std::left;
 
 namespace battleship
 {
-	RoundResults::RoundResults(int aRoundNum) : roundNum(aRoundNum)
+	RoundResults::RoundResults(int aRoundNum, size_t playersCount) :
+		roundNum(aRoundNum),
+		rows(playersCount),
+		isReported(playersCount, false),
+		reportedCount(0)
 	{
 	}
 
-	Scoreboard::Scoreboard(vector<string> players, size_t totalRounds) :
+	Scoreboard::Scoreboard(vector<string> players, size_t totalRounds, int renderFps) :
 		_totalRounds(totalRounds),
 		_playersPerRound(players.size()),
-		_resultsCursorPosition(std::make_pair(0, 0))
+		_isGamesFinished(false),
+		_exporter(nullptr),
+		_resultsStore(nullptr),
+		_ratings(players),
+		_lastFinishedRound(0),
+		_renderer(renderFps)
 	{
 		// Save max player name for score results table formatting
 		_maxPlayerNameLength = MIN_PLAYER_NAME_SIZE;
 
 		for (const string& player : players)
 		{
+			// Intern the player name, everything else refers to the player by id
+			_playerIds[player] = _playerNames.size();
+			_playerNames.push_back(player);
+
 			// Store initialized player score information
-			_score.emplace(std::make_pair(player, PlayerStatistics(player)));
+			_score.push_back(PlayerStatistics(player));
+			_expectedRounds.push_back(0);
 
 			// Query for the longest name
 			if (_maxPlayerNameLength < player.length())
@@ -47,10 +62,15 @@ namespace battleship
 		_maxPlayerNameLength += 2; // Apply some spacing between tabs in printed scoreboard
 	}
 
-	int Scoreboard::getPlayerCurrentRound(const string& player) const
+	size_t Scoreboard::playerId(const string& playerName) const
+	{
+		return _playerIds.at(playerName);
+	}
+
+	int Scoreboard::getPlayerCurrentRound(size_t playerId) const
 	{
 		// Fetch current score for player
-		const PlayerStatistics& playerStatistics = _score.at(player);
+		const PlayerStatistics& playerStatistics = _score[playerId];
 
 		// Calculate round number for this player, start from round #1
 		int playerRound = playerStatistics.getRoundsPlayed() + 1;
@@ -58,11 +78,30 @@ namespace battleship
 		return playerRound;
 	}
 
-	void Scoreboard::updatePlayerGameResults(PlayerEnum player, const string& playerName,
-											 const GameResults& results)
+	void Scoreboard::updatePlayerGameResults(PlayerEnum player, size_t playerId, const GameResults& results)
 	{
 		// Calculate round number for this player, start from round #1
-		int playerRound = getPlayerCurrentRound(playerName);
+		int playerRound = getPlayerCurrentRound(playerId);
+
+		// Update player score with the newest record
+		PlayerStatistics& playerStatistics = _score[playerId];
+		int pointsTo = (player == PlayerEnum::A) ? results.playerAPoints : results.playerBPoints;
+		int pointsAgainst = (player == PlayerEnum::A) ? results.playerBPoints : results.playerAPoints;
+		bool isWinner = (results.winner == player);
+		bool isLoser = (results.winner != player) && (results.winner != PlayerEnum::NONE);
+		playerStatistics = playerStatistics.updateStatistics(pointsTo, pointsAgainst, isWinner, isLoser);
+
+		updatePlayerRound(playerId, playerRound);
+	}
+
+	void Scoreboard::updatePlayerRound(size_t playerId, int playerRound)
+	{
+		const PlayerStatistics& playerStatistics = _score[playerId];
+
+		// A player that sat out rounds (skipped games) may catch up on rounds that were already reported,
+		// those results only count towards the score table
+		if (playerRound <= _lastFinishedRound)
+			return;
 
 		// Find RoundResults object for this round number
 		auto roundEntry = _trackedMatches.find(playerRound);
@@ -71,73 +110,219 @@ namespace battleship
 		// If this is the first game in this round, create RoundResults
 		if (roundEntry == _trackedMatches.end())
 		{
-			roundResults = std::make_shared<RoundResults>(playerRound);
+			roundResults = std::make_shared<RoundResults>(playerRound, _playerNames.size());
 			_trackedMatches.emplace(std::make_pair(playerRound, roundResults));
-			Logger::getInstance().log(Severity::DEBUG_LEVEL, "Round " + to_string(playerRound) + " started (1 game done).");
+			LOG_DEBUG("Round " + to_string(playerRound) + " started (1 game done).");
 		}
 		else
 		{
 			roundResults = roundEntry->second;
 		}
 
-		// Fetch current score for player
-		PlayerStatistics& playerStatistics = _score.at(playerName);
-
 		// Update RoundResults with the new player's statistics
-		int pointsTo = (player == PlayerEnum::A) ? results.playerAPoints : results.playerBPoints;
-		int pointsAgainst = (player == PlayerEnum::A) ? results.playerBPoints : results.playerAPoints;
-		bool isWinner = (results.winner == player);
-		bool isLoser = (results.winner != player) && (results.winner != PlayerEnum::NONE);
-		auto newRoundStatistics = playerStatistics.updateStatistics(pointsTo, pointsAgainst, isWinner, isLoser);
-		roundResults->playerStatistics.emplace(PlayerStatistics(newRoundStatistics)); // Save a copy in round results
+		RoundRow& row = roundResults->rows[playerId];
+		row.pointsFor = playerStatistics.pointsFor;
+		row.pointsAgainst = playerStatistics.pointsAgainst;
+		row.wins = playerStatistics.wins;
+		row.loses = playerStatistics.loses;
+		row.ties = playerStatistics.ties;
+		if (!roundResults->isReported[playerId])
+		{
+			roundResults->isReported[playerId] = true;
+			roundResults->reportedCount++;
+		}
 
-		// Update player score with the newest record
-		auto scoreIt = _score.find(playerName);
-		if (scoreIt != _score.end())
+		// If this is the last update for this round (or for the rounds before it), push the RoundResults to the
+		// approporiate list so the reporter thread can wake up and print it
+		checkPendingRounds();
+	}
+
+	bool Scoreboard::checkRoundFinished(shared_ptr<RoundResults> roundResults)
+	{
+		int roundNum = roundResults->roundNum;
+
+		// Players without games scheduled up to this round won't submit results for it
+		size_t absentPlayers = 0;
+		for (size_t player = 0; player < _expectedRounds.size(); ++player)
 		{
-			scoreIt->second = std::move(newRoundStatistics);
+			if ((_expectedRounds[player] < roundNum) && !roundResults->isReported[player])
+				absentPlayers++;
 		}
-		else
+
+		if (roundResults->reportedCount + absentPlayers < _playersPerRound)
+			return false;
+
+		// List absent players with their latest statistics, so each round shows the full table
+		for (size_t player = 0; player < _expectedRounds.size(); ++player)
 		{
-			Logger::getInstance().log(Severity::ERROR_LEVEL, "Illegal state in scoretable - player data is missing.");
+			if (roundResults->isReported[player])
+				continue;
+
+			const PlayerStatistics& latest = _score[player];
+			roundResults->rows[player] = RoundRow{ latest.pointsFor, latest.pointsAgainst,
+												   latest.wins, latest.loses, latest.ties };
+			roundResults->isReported[player] = true;
+			roundResults->reportedCount++;
 		}
 
-		// If this is the last update for this round, push the RoundResults to the approporiate
-		// list so the reporter thread can wake up and print it
-		if (roundResults->playerStatistics.size() == _playersPerRound)
+		// The round leaves the tracked rounds, it's released once printed
+		_lastFinishedRound = roundNum;
+		_trackedMatches.erase(roundNum);
+
+		unique_lock<mutex> lock(_roundResultsLock);
+		Logger::getInstance().log(Severity::INFO_LEVEL, "Round " + to_string(roundNum) + " finished.");
+		_roundsResults.push_back(roundResults); // Guaranteed to happen before lock is released
+		_roundResultsCV.notify_one();
+		return true;
+	}
+
+	void Scoreboard::registerWorkers(size_t workersCount)
+	{
+		_workerRings.clear();
+		for (size_t worker = 0; worker < workersCount; ++worker)
+			_workerRings.push_back(std::make_unique<SpscRing<GameRecord>>(WORKER_RING_CAPACITY));
+	}
+
+	void Scoreboard::publishGameResults(size_t workerIndex, unique_ptr<SingleGameTask> game,
+										const GameResults& results, double durationSeconds)
+	{
+		GameRecord record{ std::move(game), results, durationSeconds, false };
+		publish(workerIndex, record);
+	}
+
+	void Scoreboard::publishSkippedGame(size_t workerIndex, unique_ptr<SingleGameTask> game)
+	{
+		GameRecord record{ std::move(game), GameResults{ PlayerEnum::NONE, 0, 0, 0 }, 0, true };
+		publish(workerIndex, record);
+	}
+
+	void Scoreboard::publish(size_t workerIndex, GameRecord& record)
+	{
+		// Results are never dropped - a full ring means the main thread is behind, so give it the CPU
+		while (!_workerRings.at(workerIndex)->tryPush(record))
+			std::this_thread::yield();
+	}
+
+	void Scoreboard::drainPublishedResults()
+	{
+		GameRecord record;
+		for (auto& ring : _workerRings)
 		{
-			unique_lock<mutex> lock(_roundResultsLock);
-			Logger::getInstance().log(Severity::INFO_LEVEL, "Round " + to_string(playerRound) + " finished.");
-			_roundsResults.push_back(roundResults); // Guaranteed to happen before lock is released
-			_roundResultsCV.notify_one();
+			while (ring->tryPop(record))
+			{
+				const SingleGameTask& game = *record.game;
+				if (record.isSkipped)
+				{
+					cancelExpectedGame(game.playerAName());
+					cancelExpectedGame(game.playerBName());
+				}
+				else
+				{
+					updateWithGameResults(record.results, game.playerAName(), game.playerBName(), game.boardName());
+
+					if (_exporter != nullptr)
+					{
+						_exporter->exportGame(game.playerAName(), game.playerBName(), game.boardName(),
+											  record.results, record.durationSeconds);
+					}
+
+					if (_resultsStore != nullptr)
+					{
+						StoredWinner winner = (record.results.winner == PlayerEnum::A) ? StoredWinner::PLAYER_A :
+											  ((record.results.winner == PlayerEnum::B) ? StoredWinner::PLAYER_B :
+																						  StoredWinner::NONE);
+						_resultsStore->append(StoredGame{ game.playerAName(), game.playerBName(), game.boardName(),
+														  record.results.playerAPoints, record.results.playerBPoints,
+														  winner, record.results.movesCount, record.durationSeconds });
+					}
+				}
+
+				record.game.reset();
+			}
+		}
+	}
+
+	map<string, PlayerStatistics> Scoreboard::standings() const
+	{
+		map<string, PlayerStatistics> standings;
+		for (const auto& playerStatistics : _score)
+			standings.emplace(std::make_pair(playerStatistics.playerName, playerStatistics));
+
+		return standings;
+	}
+
+	void Scoreboard::recordBye(const string& playerName, size_t games)
+	{
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Player " + playerName + " has a bye (credited with " + to_string(games) + " games)");
+
+		size_t id = playerId(playerName);
+		_expectedRounds[id] += static_cast<int>(games);
+
+		// Each credited game takes a round of the player, without counting as a played game
+		for (size_t game = 0; game < games; ++game)
+		{
+			int playerRound = getPlayerCurrentRound(id);
+			_score[id] = _score[id].creditBye();
+			updatePlayerRound(id, playerRound);
 		}
 	}
 
+	void Scoreboard::expectGames(const string& playerName, size_t games)
+	{
+		_expectedRounds[playerId(playerName)] += static_cast<int>(games);
+	}
+
+	void Scoreboard::cancelExpectedGame(const string& playerName)
+	{
+		_expectedRounds[playerId(playerName)]--;
+
+		// Rounds that only waited for this game are finished now
+		checkPendingRounds();
+	}
+
+	void Scoreboard::checkPendingRounds()
+	{
+		// Report rounds in order, a round can't be reported before the rounds preceding it
+		auto nextRound = _trackedMatches.find(_lastFinishedRound + 1);
+		while ((nextRound != _trackedMatches.end()) && checkRoundFinished(nextRound->second))
+			nextRound = _trackedMatches.find(_lastFinishedRound + 1);
+	}
+
+	void Scoreboard::setExporter(ResultsExporter* exporter)
+	{
+		_exporter = exporter;
+	}
+
+	void Scoreboard::setResultsStore(ResultsStoreWriter* resultsStore)
+	{
+		_resultsStore = resultsStore;
+	}
+
+	RatingEngine& Scoreboard::ratings()
+	{
+		return _ratings;
+	}
+
 	void Scoreboard::updateWithGameResults(const GameResults& results,
 										   const string& playerAName,
 										   const string& playerBName,
 										   const string& boardName)
 	{
-		// Update the score table here.
-		// Game result updates should be atomic so we lock here to protect the score table's integrity
-		lock_guard<mutex> lock(_scoreLock);
-
-		string gameResultStr = (results.winner == PlayerEnum::A) ?  "Player A wins" :
-							   ((results.winner == PlayerEnum::B) ? "Player B wins" :
-																	 "Tie");
+		// Only the main thread updates the score table (while draining the published results), so no lock is needed
+		size_t playerAId = playerId(playerAName);
+		size_t playerBId = playerId(playerBName);
 
-		int playerARound = getPlayerCurrentRound(playerAName);
-		int playerBRound = getPlayerCurrentRound(playerBName);
-		string msg = "Game finished between Player A: " + playerAName +
-					 " (Round #" + std::to_string(playerARound) + ", " + std::to_string(results.playerAPoints) +
-					 " pts) and Player B: " + playerBName +
-					 " (Round #" + std::to_string(playerBRound) + ", " + std::to_string(results.playerBPoints) +
-					 " pts) on board: " + boardName + ". Game result: " + gameResultStr;
+		// Called for every game - the event's arguments are only gathered if it is going to be logged
+		LOG_EVENT(LogEvent::GAME_FINISHED,
+				  EventLog::getInstance().playerId(playerAName), getPlayerCurrentRound(playerAId), results.playerAPoints,
+				  EventLog::getInstance().playerId(playerBName), getPlayerCurrentRound(playerBId), results.playerBPoints,
+				  EventLog::getInstance().boardId(boardName), static_cast<int>(results.winner));
 
-		Logger::getInstance().log(Severity::INFO_LEVEL, msg);
+		updatePlayerGameResults(PlayerEnum::A, playerAId, results);
+		updatePlayerGameResults(PlayerEnum::B, playerBId, results);
 
-		updatePlayerGameResults(PlayerEnum::A, playerAName, results);
-		updatePlayerGameResults(PlayerEnum::B, playerBName, results);
+		_ratings.recordGame(playerAName, playerBName, results.winner);
 	}
 
 	vector<shared_ptr<RoundResults>>& Scoreboard::getRoundResults()
@@ -161,10 +346,20 @@ namespace battleship
 		   << setw(8) << "Pts For"
 		   << setw(12) << "Pts Against" << endl << endl;
 
-		int place = 1;
+		// Sort the round's rows by player's rating
+		vector<PlayerStatistics> ranking;
+		ranking.reserve(roundResults->rows.size());
+		for (size_t player = 0; player < roundResults->rows.size(); ++player)
+		{
+			const RoundRow& row = roundResults->rows[player];
+			ranking.push_back(PlayerStatistics(_playerNames[player], row.pointsFor, row.pointsAgainst,
+											   row.wins, row.loses, row.ties));
+		}
+
+		std::sort(ranking.begin(), ranking.end(), PlayerStatisticsRatingSort());
 
-		// RoundsResults are already sorted by player's rating
-		for (const auto& playerStats : roundResults->playerStatistics)
+		int place = 1;
+		for (const auto& playerStats : ranking)
 		{
 			string placeStr = to_string(place) + ".";
 			ss << setw(8) << placeStr
@@ -174,22 +369,20 @@ namespace battleship
 			   << setw(8) << setprecision(2) << fixed << playerStats.rating
 			   << setw(8) << playerStats.pointsFor
 			   << setw(12) << playerStats.pointsAgainst << endl;
-			place++;
-		}
 
-		// For the first round - we save the position of the scoreboard in the console, so we keep repainting
-		// over the same coordinate again and again
-		if (roundResults->roundNum == 1)
-		{
-			ConsoleUtils::registerCloseupHandler(); // Make sure if the program crashes, we show the cursor again
-			ConsoleUtils::setConsoleCursor(false);  // Hide console's cursor
-			COORD currPosition(ConsoleUtils::getConsoleCursorPosition());
-			_resultsCursorPosition.first = currPosition.Y;
-			_resultsCursorPosition.second = currPosition.X;
+			if (_exporter != nullptr)
+			{
+				_exporter->exportRoundRow(roundResults->roundNum, place, playerStats.playerName,
+										  playerStats.wins, playerStats.loses, playerStats.ties,
+										  playerStats.pointsFor, playerStats.pointsAgainst, playerStats.rating);
+			}
+
+			place++;
 		}
-		ConsoleUtils::gotoxy(_resultsCursorPosition.first, _resultsCursorPosition.second);
 
-		Logger::getInstance().log(Severity::INFO_LEVEL, ss.str(), true); // true = Print to log & console
+		// Every round goes to the log, the console only shows the latest round at a limited frame rate
+		Logger::getInstance().log(Severity::INFO_LEVEL, ss.str());
+		_renderer.submit(ss.str());
 	}
 
 	void Scoreboard::processRoundResultsQueue(bool isLockResultsQueue)
@@ -203,6 +396,9 @@ namespace battleship
 				_roundsResults.erase(_roundsResults.begin());
 				printRoundResults(nextResults);
 			}
+
+			// A table held back by the frame rate limit is drawn once its time comes
+			_renderer.update();
 		};
 
 		if (isLockResultsQueue)
@@ -216,23 +412,33 @@ namespace battleship
 		}
 	}
 
-	void Scoreboard::waitOnRoundResults()
+	void Scoreboard::finishRendering()
 	{
-		// Wait here until new data appears in round results queue
-		unique_lock<mutex> lock(_roundResultsLock);
-		Logger::getInstance().log(Severity::INFO_LEVEL, "Main thread going to sleep until new results arrive.");
-		const std::chrono::milliseconds timeout(CV_TIMEOUT_MILLIS);
-		_roundResultsCV.wait_for(lock, timeout, [this] { return !(_roundsResults.empty()); });
+		_renderer.flush();
+	}
 
-		if (!_roundsResults.empty())
+	void Scoreboard::waitOnRoundResults()
+	{
+		// Wait here until it's time to drain the published results, or the last game is over
 		{
-			Logger::getInstance().log(Severity::INFO_LEVEL, "Main thread woke up to handle new round results.");
+			unique_lock<mutex> lock(_roundResultsLock);
+			const std::chrono::milliseconds interval(DRAIN_INTERVAL_MILLIS);
+			_roundResultsCV.wait_for(lock, interval, [this] { return _isGamesFinished; });
+			_isGamesFinished = false; // Handled by the caller once we return
 		}
-		else
+
+		// Finished rounds are pushed to the round results queue by the drain (on this thread)
+		drainPublishedResults();
+		processRoundResultsQueue(true);
+	}
+
+	void Scoreboard::notifyGamesFinished()
+	{
 		{
-			Logger::getInstance().log(Severity::INFO_LEVEL, "Main thread woke up due to timeout.");
+			lock_guard<mutex> lock(_roundResultsLock);
+			_isGamesFinished = true;
 		}
 
-		processRoundResultsQueue(false); // No need to lock the results queue again
+		_roundResultsCV.notify_all();
 	}
 }
\ No newline at end of file
@@ -4,12 +4,20 @@
 #include <vector>
 #include <map>
 #include <unordered_map>
+#include <cstdint>
 #include <mutex>
 #include <functional>
 #include "GameManager.h"
 #include "PlayerStatistics.h"
+#include "RatingEngine.h"
+#include "SingleGameTask.h"
+#include "SpscRing.h"
+#include "ResultsExporter.h"
+#include "ScoreboardRenderer.h"
+#include "ResultsStore.h"
 
 using std::shared_ptr;
+using std::unique_ptr;
 using std::pair;
 using std::vector;
 using std::unordered_map;
@@ -36,54 +44,134 @@ namespace battleship
 		}
 	};
 
+	/** Statistics of a single player at the end of a round, as a fixed width row (the name is kept once, by id) */
+	struct RoundRow
+	{
+		int32_t pointsFor;
+		int32_t pointsAgainst;
+		int32_t wins;
+		int32_t loses;
+		int32_t ties;
+	};
+
 	struct RoundResults
 	{
 		int roundNum;
-		set<PlayerStatistics, PlayerStatisticsRatingSort> playerStatistics;
+		vector<RoundRow> rows;		// Indexed by player id
+		vector<bool> isReported;	// Which players have a row for this round
+		size_t reportedCount;
 
-		RoundResults(int aRoundNum);
+		RoundResults(int aRoundNum, size_t playersCount);
+	};
+
+	/** A finished (or skipped) game, published by a worker thread to the scoreboard */
+	struct GameRecord
+	{
+		unique_ptr<SingleGameTask> game;
+		GameResults results;
+		double durationSeconds;
+		bool isSkipped;
 	};
 
 	/**
 	 *	Scoreboard for managing number of matches each player is enlisted in,
 	 *  and the total number of points each player have accumulated so far.
 	 *  This class does not validate, and assumes all player "strings" are valid players.
+	 *  Worker threads publish game results to their own lock-free ring, and the main thread drains the rings
+	 *  and applies the results, so the score table and round snapshots are only touched by the main thread.
 	 */
 	class Scoreboard
 	{
 	public:
-		Scoreboard(vector<string> players, size_t totalRounds);
+		/** renderFps limits the round results tables drawn to the console per second (0 for no limit) */
+		Scoreboard(vector<string> players, size_t totalRounds, int renderFps);
 		virtual ~Scoreboard() = default;
 
-		/** Update the score table with the game results.
-		 *  This method is thread safe.
+		/** Creates a result ring for each worker thread. Must be called before the workers start. */
+		void registerWorkers(size_t workersCount);
+
+		/** Publishes the results of a finished game to the worker's ring, durationSeconds is 0 for a credited game.
+		 *  Lock-free, each worker thread must publish to its own workerIndex only.
 		 */
-		void updateWithGameResults(const GameResults& results,
-								   const string& playerAName, const string& playerBName,
-								   const string& boardName);
+		void publishGameResults(size_t workerIndex, unique_ptr<SingleGameTask> game, const GameResults& results,
+								double durationSeconds);
+
+		/** Publishes a game that was scheduled but won't be played to the worker's ring.
+		 *  Lock-free, each worker thread must publish to its own workerIndex only.
+		 */
+		void publishSkippedGame(size_t workerIndex, unique_ptr<SingleGameTask> game);
+
+		/** Applies all results published so far by the workers to the score table.
+		 *  Called by the main thread only.
+		 */
+		void drainPublishedResults();
 
 		/** A "queue" of round results for rounds that are finished being played.
 		 *  Outside consumers are expected to pop entries from this data structure after processing them.
 		 */
 		vector<shared_ptr<RoundResults>>& getRoundResults();
 
-		/** Waits on round results queue until new data is ready,
-		 *  when it arrives - trigger the print results table function (as a callback)
+		/** Waits until published results are due to be drained or all scheduled games are finished,
+		 *  then drains them and triggers the print results table function for finished rounds (as a callback)
 		 */
 		void waitOnRoundResults();
 
+		/** Wakes up the main thread waiting on round results, as all games scheduled so far are finished.
+		 *  This method is thread safe.
+		 */
+		void notifyGamesFinished();
+
+		/** Returns a copy of the current statistics of all players.
+		 *  Called by the main thread only (after draining the published results).
+		 */
+		map<string, PlayerStatistics> standings() const;
+
+		/** Credits the player with the given number of games for sitting out a stage of the tournament, so the
+		 *  player stays in step with the others for round reporting. Byes add no points, wins or losses, so they
+		 *  don't affect the rating the formats rank players by.
+		 *  Called by the main thread only.
+		 */
+		void recordBye(const string& playerName, size_t games);
+
+		/** Adds games scheduled for the player. A round waits only for players that have games scheduled up
+		 *  to it, the others (out of the tournament, or skipping games) are listed with their latest statistics.
+		 *  Called by the main thread only.
+		 */
+		void expectGames(const string& playerName, size_t games);
+
+		/** Sets the exporter that receives a record of every game and round (nullptr for no export).
+		 *  Records are added by the main thread.
+		 */
+		void setExporter(ResultsExporter* exporter);
+
+		/** Sets the columnar store that every game outcome is appended to (nullptr for none).
+		 *  Games are appended by the main thread.
+		 */
+		void setResultsStore(ResultsStoreWriter* resultsStore);
+
+		/** Returns the streaming ratings of the players, updated with every game result */
+		RatingEngine& ratings();
+
 		/** Pop and print all round results ready in the _roundResults queue.
 		 *  Boolean parameter defines if we should protect the resultsThread from multi-threaded access.
 		 */
 		void processRoundResultsQueue(bool isLockResultsQueue);
 
+		/** Draws the latest round results table if it was held back by the frame rate limit,
+		 *  and restores the console. Called by the main thread once the competition is over.
+		 */
+		void finishRendering();
+
 	private:
 
 		/** Minimal space allocated for player name in the table (visual parameter) */
 		static constexpr int MIN_PLAYER_NAME_SIZE = 12;
 
-		/** Time to wait for conditional variable before timeout */
-		static constexpr int CV_TIMEOUT_MILLIS = 3000;
+		/** Time the main thread waits between drains of the published results */
+		static constexpr int DRAIN_INTERVAL_MILLIS = 50;
+
+		/** Capacity of each worker's result ring (a worker waits for the main thread if its ring is full) */
+		static constexpr size_t WORKER_RING_CAPACITY = 1024;
 
 		// Total rounds the competition should contain
 		size_t _totalRounds;
@@ -91,8 +179,8 @@ namespace battleship
 		// Number of player entries that must be present for a round to count as finished
 		size_t _playersPerRound;
 
-		// A mutex lock to protect the score table during updates from multiple worker thread updates
-		mutex _scoreLock;
+		// Results published by each worker thread, drained by the main thread
+		vector<unique_ptr<SpscRing<GameRecord>>> _workerRings;
 
 		// A mutex lock to protect the roundResults table during access time
 		mutex _roundResultsLock;
@@ -100,12 +188,37 @@ namespace battleship
 		// A predicate to notify listeners on the _roundResults queue that new data is ready
 		condition_variable _roundResultsCV;
 
-		// Current points & statistics for each player, contains the most up to date info about each player
-		map<string, PlayerStatistics> _score;
+		// Set when all scheduled games are finished, until the main thread wakes up (protected by _roundResultsLock)
+		bool _isGamesFinished;
+
+		// Interned player names - players are referred to by their index in this list (player id)
+		vector<string> _playerNames;
+		unordered_map<string, size_t> _playerIds;
+
+		// Number of games scheduled so far for each player (including byes), indexed by player id
+		vector<int> _expectedRounds;
+
+		// Receives machine readable records of games and rounds (may be nullptr)
+		ResultsExporter* _exporter;
+
+		// Keeps every game outcome across tournaments (may be nullptr)
+		ResultsStoreWriter* _resultsStore;
+
+		// Glicko ratings and head to head results of the players
+		RatingEngine _ratings;
+
+		// Rounds are finished in order, all rounds up to this one were already pushed to _roundsResults
+		int _lastFinishedRound;
+
+		// Current points & statistics for each player (indexed by player id),
+		// contains the most up to date info about each player
+		vector<PlayerStatistics> _score;
 
 		// Tracked matches data - 
 		// key is round number
-		// value is RoundResults (that accumulates data from finished games for each player for that round)
+		// value is RoundResults (that accumulates data from finished games for each player for that round).
+		// Only rounds in flight are kept here, a round leaves once it's finished and is released once printed,
+		// so memory is bounded by players x rounds in flight rather than by the length of the competition
 		unordered_map<int, shared_ptr<RoundResults>> _trackedMatches;
 
 		// Contains results of finished rounds of games.
@@ -117,18 +230,43 @@ namespace battleship
 		// Holds the longest player name encountered
 		size_t _maxPlayerNameLength;
 
-		// Holds the cursor position for the printing of the results
-		pair<int, int> _resultsCursorPosition;
+		// Draws the round results tables to the console, at a limited frame rate
+		ScoreboardRenderer _renderer;
+
+		/** Update the score table with the game results */
+		void updateWithGameResults(const GameResults& results,
+								   const string& playerAName, const string& playerBName,
+								   const string& boardName);
+
+		/** Cancels a game scheduled for the player that won't be played after all */
+		void cancelExpectedGame(const string& playerName);
+
+		/** Returns the interned id of the player */
+		size_t playerId(const string& playerName) const;
+
+		/** Moves the record into the worker's ring, waiting for the main thread to make room if it's full */
+		void publish(size_t workerIndex, GameRecord& record);
 
 		/** Update the score table with the results for a single player from a single match
 		 */
-		void updatePlayerGameResults(PlayerEnum player, const string& playerName, const GameResults& results);
+		void updatePlayerGameResults(PlayerEnum player, size_t playerId, const GameResults& results);
+
+		/** Reports the player's latest statistics for the given round of the player */
+		void updatePlayerRound(size_t playerId, int playerRound);
 
-		/** Prints the round results in a formatted table to the console
+		/** Logs the round results in a formatted table and submits it to the console renderer
 		 */
 		void printRoundResults(shared_ptr<RoundResults> roundResults);
 
+		/** Pushes the round to the round results queue if all players still in it have finished it.
+		 *  Returns true if the round is finished.
+		 */
+		bool checkRoundFinished(shared_ptr<RoundResults> roundResults);
+
+		/** Finishes the rounds following the last finished round, in order, as long as they are complete */
+		void checkPendingRounds();
+
 		/** Get the next round for the player (to submit score to) */
-		int getPlayerCurrentRound(const string& player) const;
+		int getPlayerCurrentRound(size_t playerId) const;
 	};
 }
@@ -0,0 +1,149 @@
+#include "ScoreboardRenderer.h"
+#include "ConsoleUtils.h"
+#include <iostream>
+#include <algorithm>
+
+using std::cout;
+
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004 // Missing from SDKs older than Windows 10
+#endif
+
+namespace battleship
+{
+	ScoreboardRenderer::ScoreboardRenderer(int framesPerSecond) :
+		_mode(enableVirtualTerminal() ? RenderMode::ANSI : detectMode()),
+		_frameInterval(std::chrono::steady_clock::duration::zero()),
+		_isPending(false),
+		_framesCount(0),
+		_lastFrameLines(0),
+		_originPosition(std::make_pair(0, 0))
+	{
+		if (framesPerSecond > 0)
+		{
+			_frameInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+								std::chrono::duration<double>(1.0 / framesPerSecond));
+		}
+	}
+
+	string ScoreboardRenderer::modeToString(RenderMode mode)
+	{
+		switch (mode)
+		{
+			case RenderMode::CONSOLE: return "console";
+			case RenderMode::ANSI: return "ansi";
+			case RenderMode::PLAIN:
+			default: return "plain";
+		}
+	}
+
+	RenderMode ScoreboardRenderer::detectMode()
+	{
+		// Console mode can only be queried if the output is an actual console (not redirected)
+		HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+		DWORD consoleMode = 0;
+		if ((output == INVALID_HANDLE_VALUE) || !GetConsoleMode(output, &consoleMode))
+			return RenderMode::PLAIN;
+
+		return ((consoleMode & ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0) ? RenderMode::ANSI : RenderMode::CONSOLE;
+	}
+
+	bool ScoreboardRenderer::enableVirtualTerminal()
+	{
+		HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+		DWORD consoleMode = 0;
+		if ((output == INVALID_HANDLE_VALUE) || !GetConsoleMode(output, &consoleMode))
+			return false;
+
+		// Terminals that support virtual terminal sequences accept this flag, legacy consoles refuse it
+		return (SetConsoleMode(output, consoleMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != FALSE);
+	}
+
+	void ScoreboardRenderer::submit(const string& frame)
+	{
+		_pendingFrame = frame;
+		_isPending = true;
+		update();
+	}
+
+	void ScoreboardRenderer::update()
+	{
+		if (!_isPending)
+			return;
+
+		auto now = std::chrono::steady_clock::now();
+		if ((_framesCount > 0) && (now - _lastFrameTime < _frameInterval))
+			return; // Held back, a later update (or the final flush) renders the latest frame
+
+		render(_pendingFrame);
+		_lastFrameTime = now;
+		_isPending = false;
+	}
+
+	void ScoreboardRenderer::flush()
+	{
+		if (_isPending)
+		{
+			render(_pendingFrame);
+			_isPending = false;
+		}
+
+		if (_mode == RenderMode::ANSI)
+			cout << "\x1b[?25h" << std::flush; // Show cursor
+		else if (_mode == RenderMode::CONSOLE)
+			ConsoleUtils::setConsoleCursor(true);
+
+		// Other output follows the last frame, so anything rendered later is appended without limits
+		_mode = RenderMode::PLAIN;
+		_frameInterval = std::chrono::steady_clock::duration::zero();
+	}
+
+	void ScoreboardRenderer::render(const string& frame)
+	{
+		switch (_mode)
+		{
+			case RenderMode::CONSOLE:
+			{
+				// For the first frame - we save the position of the scoreboard in the console, so we keep repainting
+				// over the same coordinate again and again
+				if (_framesCount == 0)
+				{
+					ConsoleUtils::registerCloseupHandler(); // Make sure if the program crashes, we show the cursor again
+					ConsoleUtils::setConsoleCursor(false);  // Hide console's cursor
+					COORD currPosition(ConsoleUtils::getConsoleCursorPosition());
+					_originPosition.first = currPosition.Y;
+					_originPosition.second = currPosition.X;
+				}
+
+				ConsoleUtils::gotoxy(_originPosition.first, _originPosition.second);
+				cout << frame << std::flush;
+				break;
+			}
+			case RenderMode::ANSI:
+			{
+				if (_framesCount == 0)
+				{
+					ConsoleUtils::registerCloseupHandler(); // Make sure if the program crashes, we show the cursor again
+					cout << "\x1b[?25l"; // Hide cursor
+				}
+				else if (_lastFrameLines > 0)
+				{
+					// Move up to the first line of the previous frame and clear everything below it
+					cout << "\x1b[" << _lastFrameLines << "F\x1b[J";
+				}
+
+				cout << frame << std::flush;
+				_lastFrameLines = static_cast<size_t>(std::count(frame.begin(), frame.end(), '\n'));
+				break;
+			}
+			case RenderMode::PLAIN:
+			default:
+			{
+				cout << frame << std::flush; // Append only, pipes and log collectors get whole tables
+				break;
+			}
+		}
+
+		_framesCount++;
+	}
+}
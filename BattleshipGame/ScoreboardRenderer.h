@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <utility>
+
+using std::string;
+using std::pair;
+
+namespace battleship
+{
+	enum class RenderMode
+	{
+		CONSOLE,	// Legacy Windows console, the table is repainted in place with console cursor positioning
+		ANSI,		// Terminal with virtual terminal sequences, the table is repainted in place with ANSI escapes
+		PLAIN		// Output is redirected to a pipe or a file, tables are appended one after the other
+	};
+
+	/** Renders the round results tables to the console.
+	 *  Frames are coalesced: a frame submitted less than a frame interval after the previous one rendered
+	 *  is held back, and replaced by any later frame, so at most RENDER_FPS tables are drawn per second and
+	 *  the latest one is always drawn eventually.
+	 *  Used by the main thread only.
+	 */
+	class ScoreboardRenderer
+	{
+	public:
+		/** framesPerSecond of 0 renders every frame */
+		explicit ScoreboardRenderer(int framesPerSecond);
+		virtual ~ScoreboardRenderer() = default;
+
+		static string modeToString(RenderMode mode);
+
+		/** Returns the render mode matching the standard output (console, terminal or redirected) as it is,
+		 *  without changing the console's mode. A console whose virtual terminal processing isn't enabled yet
+		 *  is reported as CONSOLE.
+		 */
+		static RenderMode detectMode();
+
+		/** Enables virtual terminal sequences on the standard output's console.
+		 *  Returns true if they are enabled, false for a legacy console or a redirected output.
+		 */
+		static bool enableVirtualTerminal();
+
+		/** Submits the latest frame, it is rendered right away if the frame interval allows */
+		void submit(const string& frame);
+
+		/** Renders the held back frame if the frame interval has passed since the previous one */
+		void update();
+
+		/** Renders the held back frame (if any) and restores the console's cursor.
+		 *  Frames submitted afterwards are appended to the output.
+		 */
+		void flush();
+
+	private:
+		RenderMode _mode;
+
+		// Minimal time between rendered frames
+		std::chrono::steady_clock::duration _frameInterval;
+		std::chrono::steady_clock::time_point _lastFrameTime;
+
+		// Latest frame submitted and not rendered yet
+		string _pendingFrame;
+		bool _isPending;
+
+		// Number of frames rendered so far
+		size_t _framesCount;
+
+		// Number of lines of the last rendered frame (ANSI mode repaints over them)
+		size_t _lastFrameLines;
+
+		// Console cursor position of the first frame (console mode repaints from it)
+		pair<int, int> _originPosition;
+
+		/** Draws the frame according to the render mode */
+		void render(const string& frame);
+	};
+}
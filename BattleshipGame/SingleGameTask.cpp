@@ -1,6 +1,7 @@
 #include "SingleGameTask.h"
 #include "BoardDataImpl.h"
 #include "Logger.h"
+#include "EventLog.h"
 #include <algorithm>
 
 using std::min;
@@ -14,13 +15,11 @@ namespace battleship
 		_playerBName(playerBName),
 		_boardName(boardName)
 	{
-		string msg = "Created game between Player A: " + _playerAName +
-					 " and Player B: " + _playerBName +
-					 " on board: " + _boardName + ".";
-		Logger::getInstance().log(Severity::DEBUG_LEVEL, msg);
+		LOG_DEBUG_EVENT(LogEvent::GAME_CREATED, EventLog::getInstance().playerId(_playerAName),
+						EventLog::getInstance().playerId(_playerBName), EventLog::getInstance().boardId(_boardName));
 	}
 
-	void SingleGameTask::run(WorkerThreadResourcePool& resourcePool, Scoreboard* scoreBoard) const
+	GameResults SingleGameTask::run(WorkerThreadResourcePool& resourcePool) const
 	{
 		// Load resources
 		auto playerA = resourcePool.requestAlgo(_playerAName);
@@ -32,17 +31,14 @@ namespace battleship
 			string msg = "Error: Can't start a game between Player A: " + _playerAName +
 						 " and Player B: " + _playerBName +
 					     " on board: " + _boardName + " due to invalid resources";
-			Logger::getInstance().log(Severity::ERROR_LEVEL, msg);
+			LOG_LIMITED(Severity::ERROR_LEVEL, msg);
 
 			// Declare a tie so we won't be missing games for a round
-			GameResults gameResults{ PlayerEnum::NONE, 0, 0 };
-			scoreBoard->updateWithGameResults(gameResults, _playerAName, _playerBName, _boardName);
-			return;
+			return GameResults{ PlayerEnum::NONE, 0, 0, 0 };
 		}
 
-		Logger::getInstance().log(Severity::DEBUG_LEVEL,
-								  "Game started between Player A: " + _playerAName +
-								  " and Player B: " + _playerBName + " on board: " + _boardName + ".");
+		LOG_DEBUG_EVENT(LogEvent::GAME_STARTED, EventLog::getInstance().playerId(_playerAName),
+						EventLog::getInstance().playerId(_playerBName), EventLog::getInstance().boardId(_boardName));
 
 		// Player views will be kept alive for the duration of the game (this scope)
 		auto playerAView = std::make_unique<BoardDataImpl>(PlayerEnum::A, board);
@@ -60,7 +56,7 @@ namespace battleship
 		resourcePool.cacheResourcesForPlayer(_playerAName, std::move(playerAView));
 		resourcePool.cacheResourcesForPlayer(_playerBName, std::move(playerBView));
 
-		scoreBoard->updateWithGameResults(*gameResults, _playerAName, _playerBName, _boardName);
+		return *gameResults;
 	}
 
 	const string& SingleGameTask::playerAName() const
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <memory>
-#include "Scoreboard.h"
+#include "GameManager.h"
 #include "WorkerThreadResourcePool.h"
 
 using std::shared_ptr;
@@ -19,9 +19,10 @@ namespace battleship
 
 		/** Run single game betwen playerA and playerB on stored board.
 		 *  This method will allocate the resources needed to run the game if not already cached for
-		 *  this worker thread, and then run the game and update the scoreboard with the results
+		 *  this worker thread, and then run the game and return its results
+		 *  (the caller publishes them to the scoreboard).
 		 */
-		void run(WorkerThreadResourcePool& resourcePool, Scoreboard* scoreBoard) const;
+		GameResults run(WorkerThreadResourcePool& resourcePool) const;
 
 		const string& playerAName() const;
 		const string& playerBName() const;
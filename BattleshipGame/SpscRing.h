@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+using std::atomic;
+using std::vector;
+
+namespace battleship
+{
+	/** Bounded lock-free queue for a single producer thread and a single consumer thread.
+	 *  Items are moved in and out of preallocated slots, so pushing and popping never allocate or lock.
+	 *  T must be default constructible and move assignable.
+	 */
+	template <typename T>
+	class SpscRing
+	{
+	public:
+		/** Creates a ring with room for at least capacity items (rounded up to a power of 2) */
+		explicit SpscRing(size_t capacity) :
+			_head(0),
+			_tail(0)
+		{
+			size_t size = 1;
+			while (size < capacity)
+				size *= 2;
+
+			_slots.resize(size);
+			_mask = size - 1;
+		}
+
+		/** Moves item into the ring. Returns false (and leaves item intact) if the ring is full.
+		 *  Must be called by the producer thread only.
+		 */
+		bool tryPush(T& item)
+		{
+			size_t tail = _tail.load(std::memory_order_relaxed);
+			if (tail - _head.load(std::memory_order_acquire) == _slots.size())
+				return false;
+
+			_slots[tail & _mask] = std::move(item);
+			_tail.store(tail + 1, std::memory_order_release); // Publishes the slot to the consumer
+			return true;
+		}
+
+		/** Moves the oldest item out of the ring into item. Returns false if the ring is empty.
+		 *  Must be called by the consumer thread only.
+		 */
+		bool tryPop(T& item)
+		{
+			size_t head = _head.load(std::memory_order_relaxed);
+			if (head == _tail.load(std::memory_order_acquire))
+				return false;
+
+			item = std::move(_slots[head & _mask]);
+			_head.store(head + 1, std::memory_order_release); // Hands the slot back to the producer
+			return true;
+		}
+
+	private:
+		vector<T> _slots;
+		size_t _mask;
+
+		// Producer and consumer indices live on separate cache lines, so they don't invalidate each other
+		alignas(64) atomic<size_t> _head;
+		alignas(64) atomic<size_t> _tail;
+	};
+}
@@ -0,0 +1,93 @@
+#include "Tests.h"
+#include "SpscRing.h"
+#include <memory>
+#include <thread>
+
+using std::unique_ptr;
+
+namespace battleship
+{
+	void spscRingTests(unsigned int seed)
+	{
+		static constexpr size_t THREADED_ITEMS_COUNT = 1000000;
+
+		// The capacity is rounded up to a power of 2, a push to a full ring fails and leaves the item intact
+		{
+			SpscRing<unique_ptr<int>> ring(5);
+			for (int value = 0; value < 8; ++value)
+			{
+				unique_ptr<int> item(new int(value));
+				TEST_CHECK(ring.tryPush(item));
+			}
+
+			unique_ptr<int> extraItem(new int(8));
+			TEST_CHECK(!ring.tryPush(extraItem));
+			TEST_CHECK((extraItem != nullptr) && (*extraItem == 8));
+
+			unique_ptr<int> item;
+			for (int value = 0; value < 8; ++value)
+				TEST_CHECK(ring.tryPop(item) && (*item == value));
+
+			TEST_CHECK(!ring.tryPop(item));
+		}
+
+		// Items keep their order as the indices wrap around the slots many times
+		{
+			SpscRing<size_t> ring(4);
+			size_t pushed = 0;
+			size_t popped = 0;
+			bool isOrdered = true;
+
+			for (size_t round = 0; round < 1000; ++round)
+			{
+				size_t batch = (round * 7 + seed) % 5;
+				for (size_t count = 0; count < batch; ++count)
+				{
+					size_t item = pushed;
+					pushed += ring.tryPush(item) ? 1 : 0;
+				}
+
+				size_t item;
+				while (ring.tryPop(item))
+					isOrdered = isOrdered && (item == popped++);
+			}
+
+			TEST_CHECK(isOrdered);
+			TEST_CHECK(pushed == popped);
+		}
+
+		// A producer thread and a consumer thread, through a ring small enough to be full or empty most of the time
+		{
+			SpscRing<unique_ptr<size_t>> ring(16);
+
+			std::thread producer([&ring]()
+			{
+				for (size_t value = 0; value < THREADED_ITEMS_COUNT; ++value)
+				{
+					unique_ptr<size_t> item(new size_t(value));
+					while (!ring.tryPush(item))
+						std::this_thread::yield();
+				}
+			});
+
+			size_t expected = 0;
+			bool isOrdered = true;
+			unique_ptr<size_t> item;
+			while (expected < THREADED_ITEMS_COUNT)
+			{
+				if (!ring.tryPop(item))
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				isOrdered = isOrdered && (item != nullptr) && (*item == expected);
+				expected++;
+			}
+
+			producer.join();
+			TEST_CHECK(isOrdered);
+			TEST_CHECK(!ring.tryPop(item));
+		}
+	}
+}
@@ -0,0 +1,97 @@
+#include "SwissFormat.h"
+#include "Logger.h"
+
+using std::to_string;
+
+namespace battleship
+{
+	SwissFormat::SwissFormat(const vector<string>& players, const vector<string>& boards, int matchBoards, int rounds) :
+		TournamentFormat(players, boards, matchBoards)
+	{
+		_rounds = (rounds > 0) ? static_cast<size_t>(rounds) : log2Ceil(players.size());
+		if (_rounds < 1)
+			_rounds = 1;
+	}
+
+	size_t SwissFormat::maxRoundsPerPlayer() const
+	{
+		return _rounds * gamesPerMatch();
+	}
+
+	bool SwissFormat::isPlayed(const string& playerA, const string& playerB) const
+	{
+		auto key = (playerA < playerB) ? std::make_pair(playerA, playerB) : std::make_pair(playerB, playerA);
+		return (_playedPairs.find(key) != _playedPairs.end());
+	}
+
+	bool SwissFormat::nextStage(const Standings& standings, TournamentStage& stage)
+	{
+		if ((_stagesPlayed >= _rounds) || (_players.size() < 2))
+			return false;
+
+		vector<string> ranked = rankPlayers(_players, standings);
+
+		// With an odd number of players, the lowest ranked player without a bye sits this round out
+		if (ranked.size() % 2 != 0)
+		{
+			auto byeIt = ranked.end() - 1;
+			for (auto it = ranked.rbegin(); it != ranked.rend(); ++it)
+			{
+				if (_byePlayers.find(*it) == _byePlayers.end())
+				{
+					byeIt = (it + 1).base();
+					break;
+				}
+			}
+
+			_byePlayers.insert(*byeIt);
+			stage.byes.push_back(std::make_pair(*byeIt, gamesPerMatch()));
+			ranked.erase(byeIt);
+		}
+
+		// Pair each player with the closest ranked player it hasn't met yet.
+		// If it met all remaining players already, a rematch with the closest one is allowed.
+		vector<Match> matches;
+		vector<bool> isPaired(ranked.size(), false);
+		for (size_t i = 0; i < ranked.size(); ++i)
+		{
+			if (isPaired[i])
+				continue;
+
+			size_t opponent = ranked.size();
+			for (size_t j = i + 1; j < ranked.size(); ++j)
+			{
+				if (isPaired[j])
+					continue;
+
+				if (opponent == ranked.size())
+					opponent = j; // Fallback for a rematch
+
+				if (!isPlayed(ranked[i], ranked[j]))
+				{
+					opponent = j;
+					break;
+				}
+			}
+
+			if (opponent == ranked.size())
+				break; // Can't happen with an even number of players
+
+			isPaired[i] = true;
+			isPaired[opponent] = true;
+			matches.push_back(Match{ ranked[i], ranked[opponent] });
+
+			auto key = (ranked[i] < ranked[opponent]) ? std::make_pair(ranked[i], ranked[opponent]) :
+														std::make_pair(ranked[opponent], ranked[i]);
+			_playedPairs.insert(key);
+		}
+
+		appendMatchGames(matches, stage);
+		_stagesPlayed++;
+
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Swiss round " + to_string(_stagesPlayed) + "/" + to_string(_rounds) + ": " +
+								  to_string(matches.size()) + " matches, " + to_string(stage.byes.size()) + " byes");
+		return true;
+	}
+}
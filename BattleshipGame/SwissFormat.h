@@ -0,0 +1,37 @@
+#pragma once
+
+#include <set>
+#include "TournamentFormat.h"
+
+using std::set;
+
+namespace battleship
+{
+	/** Swiss system: a fixed number of rounds, in each round players are paired with players of a similar
+	 *  current rating that they haven't met yet. With an odd number of players the lowest ranked player
+	 *  that didn't have a bye yet sits the round out. Costs O(players * rounds * boards) games.
+	 */
+	class SwissFormat : public TournamentFormat
+	{
+	public:
+		/** rounds may be 0 for the number of rounds needed to single out a winner (log2 of players) */
+		SwissFormat(const vector<string>& players, const vector<string>& boards, int matchBoards, int rounds);
+		virtual ~SwissFormat() = default;
+
+		size_t maxRoundsPerPlayer() const override;
+		bool nextStage(const Standings& standings, TournamentStage& stage) override;
+
+	private:
+		// Number of swiss rounds to play
+		size_t _rounds;
+
+		// Pairs of players that already met (ordered pair of names, lower name first)
+		set<pair<string, string>> _playedPairs;
+
+		// Players that already had a bye
+		set<string> _byePlayers;
+
+		/** Returns true if the two players already met */
+		bool isPlayed(const string& playerA, const string& playerB) const;
+	};
+}
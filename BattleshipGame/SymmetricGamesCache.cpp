@@ -0,0 +1,74 @@
+#include "SymmetricGamesCache.h"
+
+using std::lock_guard;
+
+namespace battleship
+{
+	SymmetricGamesCache::SymmetricGamesCache(shared_ptr<BattleshipGameBoardFactory> boardLoader,
+											 shared_ptr<AlgoLoader> algoLoader) :
+		_savedGames(0)
+	{
+		for (const auto& algoName : algoLoader->loadedGameAlgos())
+		{
+			if (algoLoader->isSymmetryInvariant(algoName))
+				_invariantPlayers.insert(algoName);
+		}
+
+		// Boards are grouped only if some games may be credited, grouping canonicalizes every board
+		if (!_invariantPlayers.empty())
+			_representatives = boardLoader->groupSymmetricBoards();
+	}
+
+	bool SymmetricGamesCache::gameKey(const SingleGameTask& game, string& key) const
+	{
+		auto representative = _representatives.find(game.boardName());
+		if ((representative == _representatives.end()) ||
+			(_invariantPlayers.find(game.playerAName()) == _invariantPlayers.end()) ||
+			(_invariantPlayers.find(game.playerBName()) == _invariantPlayers.end()))
+		{
+			return false;
+		}
+
+		// Names can't contain line breaks, so the key is unambiguous
+		key = representative->second + "\n" + game.playerAName() + "\n" + game.playerBName();
+		return true;
+	}
+
+	bool SymmetricGamesCache::findResults(const SingleGameTask& game, GameResults& results)
+	{
+		string key;
+		if (!gameKey(game, key))
+			return false;
+
+		lock_guard<mutex> lock(_resultsLock);
+
+		// An equivalent game that's still running isn't waited for, this game is played as well
+		auto cachedResults = _results.find(key);
+		if (cachedResults == _results.end())
+			return false;
+
+		results = cachedResults->second;
+		_savedGames++;
+		return true;
+	}
+
+	void SymmetricGamesCache::storeResults(const SingleGameTask& game, const GameResults& results)
+	{
+		string key;
+		if (!gameKey(game, key))
+			return;
+
+		lock_guard<mutex> lock(_resultsLock);
+		_results.emplace(key, results);
+	}
+
+	size_t SymmetricGamesCache::savedGames() const
+	{
+		return _savedGames;
+	}
+
+	bool SymmetricGamesCache::isEffective() const
+	{
+		return !_invariantPlayers.empty() && !_representatives.empty();
+	}
+}
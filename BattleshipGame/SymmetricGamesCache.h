@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "AlgoLoader.h"
+#include "BattleshipGameBoardFactory.h"
+#include "SingleGameTask.h"
+
+using std::atomic;
+using std::mutex;
+using std::shared_ptr;
+using std::string;
+using std::unordered_map;
+using std::unordered_set;
+
+namespace battleship
+{
+	/** Results of games between symmetry invariant players on groups of boards that are mirrors or rotations of
+	 *  each other. Such a game is played on one board of the group, and its result is credited to the same
+	 *  game (same players, same sides) on every other board of the group.
+	 *  Shared by all worker threads, so it's thread safe.
+	 */
+	class SymmetricGamesCache
+	{
+	public:
+		SymmetricGamesCache(shared_ptr<BattleshipGameBoardFactory> boardLoader, shared_ptr<AlgoLoader> algoLoader);
+		virtual ~SymmetricGamesCache() = default;
+
+		SymmetricGamesCache(SymmetricGamesCache const&) = delete;
+		SymmetricGamesCache& operator=(SymmetricGamesCache const&) = delete;
+
+		/** Fills results with the results of an equivalent game that was already played, and counts the game as
+		 *  saved. Returns false if the game has to be played.
+		 */
+		bool findResults(const SingleGameTask& game, GameResults& results);
+
+		/** Keeps the results of a played game for the equivalent games (unless an equivalent game that finished
+		 *  earlier already did)
+		 */
+		void storeResults(const SingleGameTask& game, const GameResults& results);
+
+		/** Returns the number of games whose results were credited instead of played */
+		size_t savedGames() const;
+
+		/** Returns true if any games may be credited: some boards are symmetric and some players are invariant */
+		bool isEffective() const;
+
+	private:
+		/** Representative of each board grouped with symmetric boards */
+		unordered_map<string, string> _representatives;
+
+		/** Players that declared they're symmetry invariant */
+		unordered_set<string> _invariantPlayers;
+
+		/** Results of the games played so far, by gameKey */
+		unordered_map<string, GameResults> _results;
+		mutex _resultsLock;
+
+		atomic<size_t> _savedGames;
+
+		/** Fills key with the identifier shared by all equivalent games.
+		 *  Returns false if results of the game can't be shared.
+		 */
+		bool gameKey(const SingleGameTask& game, string& key) const;
+	};
+}
@@ -0,0 +1,140 @@
+#include "Tests.h"
+#include "IOUtil.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::pair;
+using std::vector;
+using battleship::IOUtil;
+using battleship::TestRunner;
+
+/** Checks of the file formats, the board validator and the concurrency primitives of the game.
+ *  Usage: Tests [seed] [suite]...
+ *  seed  - Seed of the random inputs of the tests (default 0)
+ *  suite - Names of the suites to run (default all)
+ *  Prints the failed checks and a summary, the exit code is 0 only if all checks passed.
+ */
+
+static constexpr int SUCCESS_CODE = 0;
+static constexpr int ERROR_CODE = -1;
+
+using TestSuite = void (*)(unsigned int seed);
+
+static const vector<pair<string, TestSuite>> TEST_SUITES = {
+	{ "validator", battleship::boardValidatorTests },
+	{ "ring", battleship::spscRingTests },
+	{ "store", battleship::resultsStoreTests },
+	{ "logger", battleship::loggerTests },
+	{ "eventlog", battleship::eventLogTests },
+	{ "parser", battleship::boardFileParserTests },
+	{ "archive", battleship::boardArchiveTests },
+	{ "cache", battleship::boardValidationCacheTests },
+	{ "manifest", battleship::resourceManifestTests }
+};
+
+namespace battleship
+{
+	size_t TestRunner::_checksCount = 0;
+	size_t TestRunner::_failedCount = 0;
+
+	bool TestRunner::check(bool isPassed, const char* expression, const char* file, int line)
+	{
+		return check(isPassed, string(file) + "(" + std::to_string(line) + "): Check failed: " + expression);
+	}
+
+	bool TestRunner::check(bool isPassed, const string& message)
+	{
+		_checksCount++;
+		if (!isPassed)
+		{
+			_failedCount++;
+			cerr << message << endl;
+		}
+
+		return isPassed;
+	}
+
+	size_t TestRunner::failedCount()
+	{
+		return _failedCount;
+	}
+
+	size_t TestRunner::checksCount()
+	{
+		return _checksCount;
+	}
+
+	string TestRunner::scratchPath(const string& fileName)
+	{
+		string path = "Tests_" + fileName;
+		std::remove(path.c_str());
+		return path;
+	}
+
+	vector<char> TestRunner::readBytes(const string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		return vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	void TestRunner::writeBytes(const string& path, const vector<char>& bytes)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(bytes.data(), bytes.size());
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int seed = 0;
+	int firstSuiteArg = 1;
+
+	if ((argc > 1) && IOUtil::isInteger(argv[1]))
+	{
+		seed = static_cast<unsigned int>(std::stoul(argv[1]));
+		firstSuiteArg = 2;
+	}
+
+	vector<pair<string, TestSuite>> suites;
+	for (int argIndex = firstSuiteArg; argIndex < argc; ++argIndex)
+	{
+		bool isFound = false;
+		for (const auto& suite : TEST_SUITES)
+		{
+			if (suite.first == argv[argIndex])
+			{
+				suites.push_back(suite);
+				isFound = true;
+			}
+		}
+
+		if (!isFound)
+		{
+			cerr << "Error: Unknown test suite " << argv[argIndex] << endl;
+			return ERROR_CODE;
+		}
+	}
+
+	if (suites.empty())
+		suites = TEST_SUITES;
+
+	for (const auto& suite : suites)
+	{
+		size_t failedBefore = TestRunner::failedCount();
+		size_t checksBefore = TestRunner::checksCount();
+		suite.second(seed);
+
+		cout << suite.first << ": " << (TestRunner::checksCount() - checksBefore) << " checks, "
+			 << (TestRunner::failedCount() - failedBefore) << " failed" << endl;
+	}
+
+	return (TestRunner::failedCount() == 0) ? SUCCESS_CODE : ERROR_CODE;
+}
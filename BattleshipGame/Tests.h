@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+namespace battleship
+{
+	/** Counts the checks of the Tests tool and reports the failed ones */
+	class TestRunner
+	{
+	public:
+		virtual ~TestRunner() = delete; // Static functions only
+
+		/** Records a check, prints the check's expression and location if it failed */
+		static bool check(bool isPassed, const char* expression, const char* file, int line);
+
+		/** Records a check, prints the message if it failed */
+		static bool check(bool isPassed, const string& message);
+
+		/** Returns the number of checks that failed so far */
+		static size_t failedCount();
+
+		/** Returns the number of checks made so far */
+		static size_t checksCount();
+
+		/** Returns the path of a scratch file for a test (in the working directory), removing a file left there
+		 *  by a previous run
+		 */
+		static string scratchPath(const string& fileName);
+
+		/** Returns the content of a file, empty if it can't be read */
+		static vector<char> readBytes(const string& path);
+
+		/** Replaces the content of a file */
+		static void writeBytes(const string& path, const vector<char>& bytes);
+
+	private:
+		static size_t _checksCount;
+		static size_t _failedCount;
+	};
+
+	/* -- Test suites, each one is defined in the *Tests.cpp file of its subject and seeded for its random inputs -- */
+
+	/** Compares the flood fill board validator with the mask validator it replaced */
+	void boardValidatorTests(unsigned int seed);
+
+	/** Checks the order and the bounds of the single producer single consumer ring, on one thread and on two */
+	void spscRingTests(unsigned int seed);
+
+	/** Round trips games through the results store (.bsr) and reads damaged stores */
+	void resultsStoreTests(unsigned int seed);
+
+	/** Logs from many threads through the asynchronous logger, with both overflow policies */
+	void loggerTests(unsigned int seed);
+
+	/** Round trips events through the binary event log (.blog) and reads damaged logs */
+	void eventLogTests(unsigned int seed);
+
+	/** Compares the memory mapped board file parser with the line based parser it replaced */
+	void boardFileParserTests(unsigned int seed);
+
+	/** Round trips generated boards through board archives (.sboardb) and builds damaged archived boards */
+	void boardArchiveTests(unsigned int seed);
+
+	/** Round trips validation outcomes through the board validation cache (boards.sbcache) and loads damaged caches */
+	void boardValidationCacheTests(unsigned int seed);
+
+	/** Round trips the resource files of a path through its manifest (resources.manifest) and loads damaged manifests */
+	void resourceManifestTests(unsigned int seed);
+}
+
+#define TEST_CHECK(condition) battleship::TestRunner::check((condition), #condition, __FILE__, __LINE__)
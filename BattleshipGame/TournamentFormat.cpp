@@ -0,0 +1,171 @@
+#include "TournamentFormat.h"
+#include "RoundRobinFormat.h"
+#include "SwissFormat.h"
+#include "EliminationFormat.h"
+#include "GroupsPlayoffsFormat.h"
+#include <algorithm>
+
+namespace battleship
+{
+	TournamentFormat::TournamentFormat(const vector<string>& players, const vector<string>& boards, int matchBoards) :
+		_players(players),
+		_boards(boards),
+		_stagesPlayed(0)
+	{
+		// Zero (or more boards than available) means matches are played on all boards
+		bool isAllBoards = (matchBoards <= 0) || (static_cast<size_t>(matchBoards) > boards.size());
+		_matchBoards = isAllBoards ? boards.size() : static_cast<size_t>(matchBoards);
+	}
+
+	unique_ptr<TournamentFormat> TournamentFormat::create(const TournamentSettings& settings,
+														  const vector<string>& players,
+														  const vector<string>& boards)
+	{
+		switch (settings.type)
+		{
+			case TournamentFormatType::SWISS:
+				return std::make_unique<SwissFormat>(players, boards, settings.matchBoards, settings.swissRounds);
+			case TournamentFormatType::SINGLE_ELIMINATION:
+				return std::make_unique<EliminationFormat>(players, boards, settings.matchBoards, 1);
+			case TournamentFormatType::DOUBLE_ELIMINATION:
+				return std::make_unique<EliminationFormat>(players, boards, settings.matchBoards, 2);
+			case TournamentFormatType::GROUPS_PLAYOFFS:
+				return std::make_unique<GroupsPlayoffsFormat>(players, boards, settings.matchBoards,
+															  settings.groupSize, settings.groupAdvance);
+			case TournamentFormatType::ROUND_ROBIN:
+			default:
+				return std::make_unique<RoundRobinFormat>(players, boards);
+		}
+	}
+
+	bool TournamentFormat::parseType(const string& text, TournamentFormatType& type)
+	{
+		if (text == "round_robin")
+			type = TournamentFormatType::ROUND_ROBIN;
+		else if (text == "swiss")
+			type = TournamentFormatType::SWISS;
+		else if (text == "single_elimination")
+			type = TournamentFormatType::SINGLE_ELIMINATION;
+		else if (text == "double_elimination")
+			type = TournamentFormatType::DOUBLE_ELIMINATION;
+		else if (text == "groups_playoffs")
+			type = TournamentFormatType::GROUPS_PLAYOFFS;
+		else
+			return false;
+
+		return true;
+	}
+
+	string TournamentFormat::typeToString(TournamentFormatType type)
+	{
+		switch (type)
+		{
+			case TournamentFormatType::SWISS: return "swiss";
+			case TournamentFormatType::SINGLE_ELIMINATION: return "single_elimination";
+			case TournamentFormatType::DOUBLE_ELIMINATION: return "double_elimination";
+			case TournamentFormatType::GROUPS_PLAYOFFS: return "groups_playoffs";
+			case TournamentFormatType::ROUND_ROBIN:
+			default: return "round_robin";
+		}
+	}
+
+	void TournamentFormat::recordGame(const SingleGameTask& game, const GameResults& results)
+	{
+		// Most formats are built from the scoreboard standings alone
+	}
+
+	string TournamentFormat::summary() const
+	{
+		return "";
+	}
+
+	size_t TournamentFormat::gamesPerMatch() const
+	{
+		return 2 * _matchBoards;
+	}
+
+	void TournamentFormat::appendMatchGames(const vector<Match>& matches, TournamentStage& stage) const
+	{
+		if (_boards.empty())
+			return;
+
+		// Each stage starts where the previous one stopped in the boards list
+		size_t firstBoard = (_stagesPlayed * _matchBoards) % _boards.size();
+
+		// First all matches start with player A on every board, then with player B,
+		// so both halves of a match don't pile up on the same workers at once
+		for (int startingPlayer = 0; startingPlayer < 2; ++startingPlayer)
+		{
+			for (size_t boardOffset = 0; boardOffset < _matchBoards; ++boardOffset)
+			{
+				const string& board = _boards[(firstBoard + boardOffset) % _boards.size()];
+
+				for (const auto& match : matches)
+				{
+					const string& first = (startingPlayer == 0) ? match.playerA : match.playerB;
+					const string& second = (startingPlayer == 0) ? match.playerB : match.playerA;
+					stage.games.push_back(std::make_unique<SingleGameTask>(first, second, board));
+				}
+			}
+		}
+	}
+
+	vector<string> TournamentFormat::rankPlayers(const vector<string>& players, const Standings& standings)
+	{
+		vector<string> ranked(players);
+
+		std::stable_sort(ranked.begin(), ranked.end(), [&standings](const string& a, const string& b)
+		{
+			auto statsA = standings.find(a);
+			auto statsB = standings.find(b);
+			if ((statsA == standings.end()) || (statsB == standings.end()))
+				return (statsA != standings.end()); // Players with statistics first
+
+			const PlayerStatistics& first = statsA->second;
+			const PlayerStatistics& second = statsB->second;
+			if (first.rating != second.rating)
+				return first.rating > second.rating;
+
+			int firstDiff = first.pointsFor - first.pointsAgainst;
+			int secondDiff = second.pointsFor - second.pointsAgainst;
+			if (firstDiff != secondDiff)
+				return firstDiff > secondDiff;
+
+			return a < b;
+		});
+
+		return ranked;
+	}
+
+	const string& TournamentFormat::matchWinner(const Match& match, const Standings& before, const Standings& after)
+	{
+		auto delta = [&before, &after](const string& player, int& wins, int& pointsDiff)
+		{
+			const PlayerStatistics& start = before.at(player);
+			const PlayerStatistics& end = after.at(player);
+			wins = end.wins - start.wins;
+			pointsDiff = (end.pointsFor - start.pointsFor) - (end.pointsAgainst - start.pointsAgainst);
+		};
+
+		int winsA, pointsDiffA, winsB, pointsDiffB;
+		delta(match.playerA, winsA, pointsDiffA);
+		delta(match.playerB, winsB, pointsDiffB);
+
+		if (winsA != winsB)
+			return (winsA > winsB) ? match.playerA : match.playerB;
+
+		if (pointsDiffA != pointsDiffB)
+			return (pointsDiffA > pointsDiffB) ? match.playerA : match.playerB;
+
+		return match.playerA;
+	}
+
+	size_t TournamentFormat::log2Ceil(size_t count)
+	{
+		size_t stages = 0;
+		for (size_t capacity = 1; capacity < count; capacity *= 2)
+			stages++;
+
+		return stages;
+	}
+}
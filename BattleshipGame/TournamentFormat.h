@@ -0,0 +1,141 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include "SingleGameTask.h"
+#include "PlayerStatistics.h"
+
+using std::string;
+using std::vector;
+using std::map;
+using std::pair;
+using std::unique_ptr;
+
+namespace battleship
+{
+	/** Formats of the tournament the competition manager can run */
+	enum class TournamentFormatType
+	{
+		ROUND_ROBIN,		// Every player plays every other player on every board (twice)
+		SWISS,				// Fixed number of rounds, each player meets a player with a similar rating
+		SINGLE_ELIMINATION,	// Knockout, a player is out after the first lost match
+		DOUBLE_ELIMINATION,	// Knockout, a player is out after the second lost match
+		GROUPS_PLAYOFFS		// Round robin in small groups, the top players of each group go on to a knockout
+	};
+
+	/** Parameters of the tournament format, as loaded from the configuration file */
+	struct TournamentSettings
+	{
+		TournamentFormatType type;
+		int swissRounds;	// Number of swiss rounds, 0 for enough rounds to single out a winner (log2 of players)
+		int matchBoards;	// Number of boards a match is played on (each player starts once on each), 0 for all
+		int groupSize;		// Number of players in each group of the group stage
+		int groupAdvance;	// Number of players from each group that advance to the playoffs
+	};
+
+	/** Current statistics of each player, by player name */
+	using Standings = map<string, PlayerStatistics>;
+
+	/** A match between two players, player A is the higher seed */
+	struct Match
+	{
+		string playerA;
+		string playerB;
+	};
+
+	/** A batch of games that may run in parallel. The next stage can only be built once all games of
+	 *  this stage are over, since it depends on their results.
+	 */
+	struct TournamentStage
+	{
+		// Games to run
+		vector<unique_ptr<SingleGameTask>> games;
+
+		// Players that sit this stage out, each with the number of games it is credited with as byes. Byes
+		// advance the player's rounds so all players stay in step for round reporting, without recording a
+		// game (no wins, losses or points)
+		vector<pair<string, size_t>> byes;
+
+		// Players that are out of the tournament and won't play anymore (no games are scheduled for them)
+		vector<string> retiredPlayers;
+	};
+
+	/** Base class for tournament formats. A format builds the tournament stage by stage from
+	 *  the standings of the players, and decides when the tournament is over.
+	 *  Each player plays the same number of games in each stage (or is credited with a bye),
+	 *  so the scoreboard can keep reporting results round by round.
+	 */
+	class TournamentFormat
+	{
+	public:
+		TournamentFormat(const vector<string>& players, const vector<string>& boards, int matchBoards);
+		virtual ~TournamentFormat() = default;
+
+		/** Creates the tournament format described by settings for the given players and boards */
+		static unique_ptr<TournamentFormat> create(const TournamentSettings& settings,
+												   const vector<string>& players,
+												   const vector<string>& boards);
+
+		/** Parses the textual value of a format (as given in the configuration file),
+		 *  returns false if the text doesn't match any format.
+		 */
+		static bool parseType(const string& text, TournamentFormatType& type);
+
+		/** Returns the textual value of the format */
+		static string typeToString(TournamentFormatType type);
+
+		/** Returns the maximal number of games a single player may play in the tournament */
+		virtual size_t maxRoundsPerPlayer() const = 0;
+
+		/** Builds the next stage according to the standings after the previous stage.
+		 *  Returns false if the tournament is over (retired players may still be filled in stage).
+		 */
+		virtual bool nextStage(const Standings& standings, TournamentStage& stage) = 0;
+
+		/** Notifies the format of the results of a finished game.
+		 *  Called by worker threads, so implementations must be thread safe.
+		 */
+		virtual void recordGame(const SingleGameTask& game, const GameResults& results);
+
+		/** Returns final placements of the tournament for the log, or empty string if the
+		 *  final standings of the scoreboard already tell the ranking
+		 */
+		virtual string summary() const;
+
+	protected:
+		// Players taking part in the tournament
+		vector<string> _players;
+
+		// Boards available to the tournament
+		vector<string> _boards;
+
+		// Number of boards each match is played on
+		size_t _matchBoards;
+
+		// Number of stages built so far
+		size_t _stagesPlayed;
+
+		/** Number of games in a single match: each player starts once on each board of the match */
+		size_t gamesPerMatch() const;
+
+		/** Appends the games of the matches to the stage.
+		 *  Boards rotate between stages so all boards are used during the tournament.
+		 */
+		void appendMatchGames(const vector<Match>& matches, TournamentStage& stage) const;
+
+		/** Returns the players sorted by their standings: rating, then points difference, then name */
+		static vector<string> rankPlayers(const vector<string>& players, const Standings& standings);
+
+		/** Returns the winner of a match from the standings before and after the stage it was played in.
+		 *  Only valid if both players played nothing but this match during the stage.
+		 *  Most won games wins, then points difference, a complete tie goes to the higher seed (player A).
+		 */
+		static const string& matchWinner(const Match& match, const Standings& before, const Standings& after);
+
+		/** Returns the smallest number of stages needed to single out one of count players by halving */
+		static size_t log2Ceil(size_t count);
+	};
+}
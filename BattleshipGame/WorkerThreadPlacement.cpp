@@ -0,0 +1,230 @@
+#include "WorkerThreadPlacement.h"
+#include "Logger.h"
+#include <algorithm>
+#include <utility>
+#include <sstream>
+
+using std::pair;
+using std::stringstream;
+using std::to_string;
+using std::endl;
+
+namespace battleship
+{
+	WorkerThreadPlacement::WorkerThreadPlacement(PlacementPolicy policy) :
+		_policy(policy),
+		_socketCount(0),
+		_numaNodeCount(0),
+		_logicalProcessorCount(0)
+	{
+		discoverTopology();
+
+		// Without topology information there is nothing to pin to
+		if (_cores.empty() && (_policy != PlacementPolicy::NONE))
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+									  "Failed to query processor topology, worker threads won't be pinned");
+			_policy = PlacementPolicy::NONE;
+		}
+	}
+
+	int WorkerThreadPlacement::countProcessors(KAFFINITY mask)
+	{
+		int count = 0;
+		while (mask != 0)
+		{
+			mask &= (mask - 1); // Clear lowest set bit
+			count++;
+		}
+		return count;
+	}
+
+	void WorkerThreadPlacement::discoverTopology()
+	{
+		// First call only queries the size of the buffer required
+		DWORD bufferSize = 0;
+		GetLogicalProcessorInformationEx(RelationAll, nullptr, &bufferSize);
+		if ((GetLastError() != ERROR_INSUFFICIENT_BUFFER) || (bufferSize == 0))
+			return;
+
+		vector<BYTE> buffer(bufferSize);
+		auto info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+		if (!GetLogicalProcessorInformationEx(RelationAll, info, &bufferSize))
+			return;
+
+		// Group masks of each package / NUMA node, paired with the index of their owner
+		vector<pair<int, GROUP_AFFINITY>> packageMasks;
+		vector<pair<int, GROUP_AFFINITY>> numaNodeMasks;
+
+		// Records are variable sized, each one holds its own size
+		for (DWORD offset = 0; offset < bufferSize;)
+		{
+			auto record = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+
+			switch (record->Relationship)
+			{
+			case RelationProcessorCore:
+			{
+				// A core never spans more than a single processor group
+				CoreDescriptor core{ record->Processor.GroupMask[0].Group, record->Processor.GroupMask[0].Mask, 0, 0 };
+				_cores.push_back(core);
+				_logicalProcessorCount += countProcessors(core.mask);
+				break;
+			}
+			case RelationProcessorPackage:
+			{
+				// Large packages may span several processor groups, each group gets its own mask
+				for (WORD i = 0; i < record->Processor.GroupCount; i++)
+					packageMasks.push_back(std::make_pair(_socketCount, record->Processor.GroupMask[i]));
+				_socketCount++;
+				break;
+			}
+			case RelationNumaNode:
+			{
+				int nodeNumber = static_cast<int>(record->NumaNode.NodeNumber);
+				numaNodeMasks.push_back(std::make_pair(nodeNumber, record->NumaNode.GroupMask));
+				_numaNodeCount++;
+				break;
+			}
+			default:
+				break;
+			}
+
+			offset += record->Size;
+		}
+
+		// Locate each core's socket and NUMA node by the group mask that contains it
+		auto findOwner = [](const vector<pair<int, GROUP_AFFINITY>>& masks, const CoreDescriptor& core)
+		{
+			for (const auto& ownerMask : masks)
+			{
+				if ((ownerMask.second.Group == core.group) && ((ownerMask.second.Mask & core.mask) != 0))
+					return ownerMask.first;
+			}
+			return 0;
+		};
+
+		for (auto& core : _cores)
+		{
+			core.socket = findOwner(packageMasks, core);
+			core.numaNode = findOwner(numaNodeMasks, core);
+		}
+
+		// Keep cores of the same socket next to each other, in the order the OS enumerates them
+		std::stable_sort(_cores.begin(), _cores.end(), [](const CoreDescriptor& a, const CoreDescriptor& b)
+		{
+			return a.socket < b.socket;
+		});
+	}
+
+	const WorkerThreadPlacement::CoreDescriptor* WorkerThreadPlacement::coreForWorker(int workerIndex) const
+	{
+		if ((_policy == PlacementPolicy::NONE) || _cores.empty() || (workerIndex < 0))
+			return nullptr;
+
+		size_t coreIndex = static_cast<size_t>(workerIndex) % _cores.size();
+
+		if ((_policy == PlacementPolicy::SPREAD) && (_socketCount > 1))
+		{
+			// Worker i goes to socket (i % sockets), and takes the next free core on that socket.
+			// Sockets may differ in size, so we count the cores of the chosen socket explicitly.
+			int socket = workerIndex % _socketCount;
+			int indexInSocket = workerIndex / _socketCount;
+
+			vector<size_t> socketCores;
+			for (size_t i = 0; i < _cores.size(); i++)
+			{
+				if (_cores[i].socket == socket)
+					socketCores.push_back(i);
+			}
+
+			if (!socketCores.empty())
+				coreIndex = socketCores[indexInSocket % socketCores.size()];
+		}
+
+		// Compact placement: cores are sorted by socket, so consecutive workers fill a socket first
+		return &_cores[coreIndex];
+	}
+
+	bool WorkerThreadPlacement::pinCurrentThread(int workerIndex) const
+	{
+		const CoreDescriptor* core = coreForWorker(workerIndex);
+		if (core == nullptr)
+			return false;
+
+		GROUP_AFFINITY affinity = {};
+		affinity.Group = core->group;
+		affinity.Mask = core->mask;
+
+		if (!SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr))
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+									  "Failed to pin worker thread #" + to_string(workerIndex + 1) +
+									  " to its core, worker continues unpinned");
+			return false;
+		}
+
+		LOG_DEBUG("Worker thread #" + to_string(workerIndex + 1) + " pinned to socket " +
+				  to_string(core->socket) + " (NUMA node " + to_string(core->numaNode) + ")");
+		return true;
+	}
+
+	string WorkerThreadPlacement::topologyReport(int workerCount) const
+	{
+		stringstream ss;
+
+		ss << "Host topology: " << _socketCount << " socket(s), " << _numaNodeCount << " NUMA node(s), "
+		   << _cores.size() << " core(s), " << _logicalProcessorCount << " logical processor(s)" << endl;
+
+		for (int socket = 0; socket < _socketCount; socket++)
+		{
+			int socketCores = static_cast<int>(std::count_if(_cores.begin(), _cores.end(),
+				[socket](const CoreDescriptor& core) { return core.socket == socket; }));
+			ss << "  Socket " << socket << ": " << socketCores << " core(s)" << endl;
+		}
+
+		ss << "Worker placement policy: " << policyToString(_policy);
+
+		for (int workerIndex = 0; workerIndex < workerCount; workerIndex++)
+		{
+			const CoreDescriptor* core = coreForWorker(workerIndex);
+			if (core == nullptr)
+				break;
+
+			ss << endl << "  Worker thread #" << (workerIndex + 1) << " -> socket " << core->socket
+			   << ", NUMA node " << core->numaNode << ", group " << core->group
+			   << ", affinity mask 0x" << std::hex << core->mask << std::dec;
+		}
+
+		return ss.str();
+	}
+
+	PlacementPolicy WorkerThreadPlacement::policy() const
+	{
+		return _policy;
+	}
+
+	bool WorkerThreadPlacement::parsePolicy(const string& text, PlacementPolicy& policy)
+	{
+		for (auto candidate : { PlacementPolicy::NONE, PlacementPolicy::COMPACT, PlacementPolicy::SPREAD })
+		{
+			if (text == policyToString(candidate))
+			{
+				policy = candidate;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	string WorkerThreadPlacement::policyToString(PlacementPolicy policy)
+	{
+		if (policy == PlacementPolicy::COMPACT)
+			return "compact";
+		else if (policy == PlacementPolicy::SPREAD)
+			return "spread";
+		else
+			return "none";
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <windows.h>
+#include <vector>
+#include <string>
+
+using std::vector;
+using std::string;
+
+namespace battleship
+{
+	/** Policy for placing the competition's worker threads on the host's cores */
+	enum class PlacementPolicy : int
+	{
+		NONE = 0,		// Workers are not pinned, the OS scheduler may migrate them freely
+		COMPACT = 1,	// Fill all cores of a socket before moving on to the next socket
+		SPREAD = 2		// Distribute workers round-robin between sockets
+	};
+
+	/** Discovers the host's processor topology (processor groups, sockets, NUMA nodes and cores)
+	 *  and pins worker threads to cores according to a placement policy.
+	 *  Placement only affects where a worker runs and never which games it runs,
+	 *  so tournament results are not affected by it.
+	 */
+	class WorkerThreadPlacement
+	{
+	public:
+		WorkerThreadPlacement(PlacementPolicy policy);
+		virtual ~WorkerThreadPlacement() = default;
+
+		/** Pins the calling thread to the core planned for the given worker (workerIndex starts from 0).
+		 *  Windows commits physical pages from the NUMA node of the thread that first touches them,
+		 *  so a worker that is pinned before it allocates its resources gets them node-locally.
+		 *  Returns false if the policy is NONE or pinning failed (the worker then keeps running unpinned).
+		 */
+		bool pinCurrentThread(int workerIndex) const;
+
+		/** Returns a printable description of the host topology and the planned placement for workerCount workers */
+		string topologyReport(int workerCount) const;
+
+		/** Returns the placement policy used */
+		PlacementPolicy policy() const;
+
+		/** Parses a placement policy from its textual representation ("none", "compact" or "spread").
+		 *  Returns false if the text doesn't represent a known policy.
+		 */
+		static bool parsePolicy(const string& text, PlacementPolicy& policy);
+
+		/** Returns the textual representation of the placement policy */
+		static string policyToString(PlacementPolicy policy);
+
+	private:
+		/** A single physical core and its location in the topology */
+		struct CoreDescriptor
+		{
+			WORD group;			// Processor group the core belongs to
+			KAFFINITY mask;		// Logical processors (SMT siblings) of the core within the group
+			int socket;			// Index of the physical package containing the core
+			int numaNode;		// NUMA node containing the core
+		};
+
+		PlacementPolicy _policy;
+
+		// All physical cores on the host, sorted by socket
+		vector<CoreDescriptor> _cores;
+
+		int _socketCount;
+		int _numaNodeCount;
+		int _logicalProcessorCount;
+
+		/** Queries the OS for cores, packages and NUMA nodes and fills the cores list */
+		void discoverTopology();
+
+		/** Returns the core planned for the given worker, or nullptr if workers are not pinned */
+		const CoreDescriptor* coreForWorker(int workerIndex) const;
+
+		/** Returns the number of logical processors set in the mask */
+		static int countProcessors(KAFFINITY mask);
+	};
+}